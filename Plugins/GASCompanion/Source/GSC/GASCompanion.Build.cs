@@ -21,6 +21,7 @@ public class GASCompanion : ModuleRules
 			"Slate",
 			"SlateCore",
 			"DeveloperSettings",
+			"SignificanceManager",
 		});
 
 		if (Target.bBuildEditor == true)
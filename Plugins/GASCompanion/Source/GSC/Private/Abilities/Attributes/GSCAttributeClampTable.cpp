@@ -0,0 +1,124 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/Attributes/GSCAttributeClampTable.h"
+
+#include "Core/Settings/GSCDeveloperSettings.h"
+#include "UObject/UObjectGlobals.h"
+
+FGSCAttributeClampTable& FGSCAttributeClampTable::Get()
+{
+	static FGSCAttributeClampTable Table;
+	return Table;
+}
+
+FGSCAttributeClampTable::FGSCAttributeClampTable()
+{
+	// Reinstancing (Blueprint recompile, hot reload) recreates attribute properties, and freed property addresses may be reused.
+	// Never removed, the table lives until exit.
+	FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>& ReplacedObjects)
+	{
+		InvalidateAttributeIDs();
+	});
+}
+
+void FGSCAttributeClampTable::InvalidateAttributeIDs()
+{
+	check(IsInGameThread());
+
+	AttributeIDs.Reset();
+	MinimumValues.Reset();
+	for (TPair<const UClass*, TUniquePtr<FGSCAttributeClassIDs>>& Pair : ClassAttributeIDs)
+	{
+		// Kept allocated for Attribute Sets still pointing to it, resolved again on next GetClassAttributeIDs()
+		Pair.Value->Class.Reset();
+		Pair.Value->Slots.Reset();
+	}
+
+	bMinimumValuesDirty = true;
+	Generation++;
+}
+
+const FGSCAttributeClassIDs& FGSCAttributeClampTable::GetClassAttributeIDs(const UClass* AttributeSetClass)
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FGSCAttributeClassIDs>& Entry = ClassAttributeIDs.FindOrAdd(AttributeSetClass);
+	if (Entry.IsValid() && Entry->Class.Get() == AttributeSetClass)
+	{
+		return *Entry;
+	}
+
+	if (!Entry.IsValid())
+	{
+		Entry = MakeUnique<FGSCAttributeClassIDs>();
+	}
+
+	Entry->Class = AttributeSetClass;
+	Entry->Slots.Reset();
+
+	// Same discovery rules as UGSCBlueprintFunctionLibrary::GetAllAttributes()
+	for (TFieldIterator<FProperty> It(AttributeSetClass); It; ++It)
+	{
+		if (CastField<FFloatProperty>(*It) || FGameplayAttribute::IsGameplayAttributeDataProperty(*It))
+		{
+			const int32 SlotIndex = FGSCAttributeClassIDs::GetSlotIndex(*It);
+			if (SlotIndex >= Entry->Slots.Num())
+			{
+				Entry->Slots.SetNum(SlotIndex + 1);
+			}
+
+			Entry->Slots[SlotIndex].Property = *It;
+			Entry->Slots[SlotIndex].ID = GetOrAddAttributeID(*It);
+		}
+	}
+
+	return *Entry;
+}
+
+int32 FGSCAttributeClampTable::GetOrAddAttributeID(const FGameplayAttribute& Attribute)
+{
+	return GetOrAddAttributeID(Attribute.GetUProperty());
+}
+
+int32 FGSCAttributeClampTable::GetOrAddAttributeID(const FProperty* Property)
+{
+	if (!Property)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ID = AttributeIDs.Find(Property))
+	{
+		return *ID;
+	}
+
+	const int32 NewID = AttributeIDs.Num();
+	AttributeIDs.Add(Property, NewID);
+
+	// New attributes have no configured minimum (otherwise they would have been given an ID on rebuild)
+	MinimumValues.Add(0.f);
+	return NewID;
+}
+
+void FGSCAttributeClampTable::RebuildMinimumValues()
+{
+	check(IsInGameThread());
+
+	bMinimumValuesDirty = false;
+
+	for (float& MinimumValue : MinimumValues)
+	{
+		MinimumValue = 0.f;
+	}
+
+	const UGSCDeveloperSettings* DeveloperSettings = GetDefault<UGSCDeveloperSettings>();
+	for (const FGSCAttributeSetMinimumValues& ClampMinimumValue : DeveloperSettings->MinimumValues)
+	{
+		const int32 AttributeID = GetOrAddAttributeID(ClampMinimumValue.Attribute);
+		if (MinimumValues.IsValidIndex(AttributeID))
+		{
+			MinimumValues[AttributeID] = ClampMinimumValue.MinimumValue;
+		}
+	}
+}
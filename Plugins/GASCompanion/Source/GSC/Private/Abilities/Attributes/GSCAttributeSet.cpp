@@ -15,38 +15,60 @@ void UGSCAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, f
     Super::PreAttributeChange(Attribute, NewValue);
 
 	// Handle Max Attributes
-	if (Attribute == GetMaxHealthAttribute())
+	const FGameplayAttribute CappedAttribute = GetAttributeCappedBy(Attribute);
+	if (CappedAttribute.IsValid())
 	{
-		AdjustAttributeForMaxChange(Health, MaxHealth, NewValue, GetHealthAttribute());
+		AdjustAttributeForMaxChange(*CappedAttribute.GetGameplayAttributeData(this), *Attribute.GetGameplayAttributeData(this), NewValue, CappedAttribute);
 		return;
 	}
 
-	if (Attribute == GetMaxStaminaAttribute())
+	// Handle Clamps of normal attributes
+	const FGameplayAttribute MaxAttribute = GetMaxAttributeFor(Attribute);
+	if (MaxAttribute.IsValid())
 	{
-		AdjustAttributeForMaxChange(Stamina, MaxStamina, NewValue, GetStaminaAttribute());
-		return;
+		const float Min = GetClampMinimumValueFor(Attribute);
+		NewValue = FMath::Clamp(NewValue, Min, MaxAttribute.GetNumericValue(this));
 	}
+}
 
-	if (Attribute == GetMaxManaAttribute())
+FGameplayAttribute UGSCAttributeSet::GetMaxAttributeFor(const FGameplayAttribute& Attribute) const
+{
+	if (Attribute == GetHealthAttribute())
 	{
-		AdjustAttributeForMaxChange(Mana, MaxMana, NewValue, GetManaAttribute());
-		return;
+		return GetMaxHealthAttribute();
 	}
 
-	// Handle Clamps of normal attributes
-	const float Min = GetClampMinimumValueFor(Attribute);
-	if (Attribute == GetHealthAttribute())
+	if (Attribute == GetStaminaAttribute())
 	{
-		NewValue = FMath::Clamp(NewValue, Min, GetMaxHealth());
+		return GetMaxStaminaAttribute();
 	}
-	else if (Attribute == GetStaminaAttribute())
+
+	if (Attribute == GetManaAttribute())
 	{
-		NewValue = FMath::Clamp(NewValue, Min, GetMaxStamina());
+		return GetMaxManaAttribute();
 	}
-	else if (Attribute == GetManaAttribute())
+
+	return FGameplayAttribute();
+}
+
+FGameplayAttribute UGSCAttributeSet::GetAttributeCappedBy(const FGameplayAttribute& MaxAttribute) const
+{
+	if (MaxAttribute == GetMaxHealthAttribute())
+	{
+		return GetHealthAttribute();
+	}
+
+	if (MaxAttribute == GetMaxStaminaAttribute())
 	{
-		NewValue = FMath::Clamp(NewValue, Min, GetMaxMana());
+		return GetStaminaAttribute();
 	}
+
+	if (MaxAttribute == GetMaxManaAttribute())
+	{
+		return GetManaAttribute();
+	}
+
+	return FGameplayAttribute();
 }
 
 void UGSCAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
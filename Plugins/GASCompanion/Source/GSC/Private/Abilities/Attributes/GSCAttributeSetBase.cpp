@@ -3,8 +3,8 @@
 
 #include "Abilities/Attributes/GSCAttributeSetBase.h"
 #include "GameplayEffectExtension.h"
+#include "Abilities/Attributes/GSCAttributeClampTable.h"
 #include "Actors/Characters/GSCCharacterBase.h"
-#include "Core/Settings/GSCDeveloperSettings.h"
 #include "Abilities/GSCBlueprintFunctionLibrary.h"
 #include "Components/GSCCoreComponent.h"
 #include "Player/GSCPlayerState.h"
@@ -13,12 +13,7 @@
 UGSCAttributeSetBase::UGSCAttributeSetBase()
 {
 	// Set default values for this Set Attributes here
-    const UGSCDeveloperSettings* DeveloperSettings = GetDefault<UGSCDeveloperSettings>();
-    for (FGSCAttributeSetMinimumValues ClampMinimumValue : DeveloperSettings->MinimumValues)
-    {
-        // For each configured value, store and cache them in a map
-        MinimumValues.Add(ClampMinimumValue.Attribute, ClampMinimumValue.MinimumValue);
-    }
+	// Minimum clamp values are shared by all instances in FGSCAttributeClampTable, and resolved on first use
 }
 
 void UGSCAttributeSetBase::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
@@ -76,13 +71,30 @@ void UGSCAttributeSetBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 
 float UGSCAttributeSetBase::GetClampMinimumValueFor(const FGameplayAttribute& Attribute)
 {
-    float* MinimumValue = MinimumValues.Find(Attribute);
-    if (!MinimumValue)
+    // Values set by subclasses in the deprecated map take precedence
+    if (MinimumValues.Num() > 0)
+    {
+        if (const float* MinimumValue = MinimumValues.Find(Attribute))
+        {
+            return *MinimumValue;
+        }
+    }
+
+    FGSCAttributeClampTable& ClampTable = FGSCAttributeClampTable::Get();
+    if (!ClassAttributeIDs || ClassAttributeIDsGeneration != ClampTable.GetGeneration())
+    {
+        ClassAttributeIDs = &ClampTable.GetClassAttributeIDs(GetClass());
+        ClassAttributeIDsGeneration = ClampTable.GetGeneration();
+    }
+
+    int32 AttributeID = ClassAttributeIDs->Find(Attribute.GetUProperty());
+    if (AttributeID == INDEX_NONE)
     {
-        return 0.f;
+        // Attribute from another set, fall back to the table lookup
+        AttributeID = ClampTable.GetOrAddAttributeID(Attribute);
     }
 
-    return *MinimumValue;
+    return ClampTable.GetMinimumValue(AttributeID);
 }
 
 void UGSCAttributeSetBase::GetCharactersFromContext(const FGameplayEffectModCallbackData& Data, AGSCCharacterBase*& SourceCharacter, AGSCCharacterBase*& TargetCharacter)
@@ -11,6 +11,56 @@
 #include "Core/Interfaces/GSCCompanionInterface.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Subsystems/GSCComponentCacheSubsystem.h"
+
+namespace GSCBlueprintFunctionLibrary_Impl
+{
+	// Uncached resolution of companion components, results are cached per actor by UGSCComponentCacheSubsystem
+
+	static UGSCComboManagerComponent* ResolveComboManagerComponent(const AActor* Actor)
+	{
+		const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
+		if (CompanionInterface)
+		{
+			return CompanionInterface->GetComboManagerComponent();
+		}
+
+		// Fall back to a component search to better support BP-only actors
+		return Actor->FindComponentByClass<UGSCComboManagerComponent>();
+	}
+
+	static UGSCCoreComponent* ResolveCompanionCoreComponent(const AActor* Actor)
+	{
+		if (Actor->GetClass()->ImplementsInterface(UGSCCompanionInterface::StaticClass()))
+		{
+			UGSCCoreComponent* CoreComponent = IGSCCompanionInterface::Execute_K2_GetCompanionCoreComponent(Actor);
+			if (CoreComponent)
+			{
+				return CoreComponent;
+			}
+
+			const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
+			if (CompanionInterface)
+			{
+				return CompanionInterface->GetCompanionCoreComponent();
+			}
+		}
+
+		// Fall back to a component search to better support BP-only actors
+		return Actor->FindComponentByClass<UGSCCoreComponent>();
+	}
+
+	static UGSCAbilityQueueComponent* ResolveAbilityQueueComponent(const AActor* Actor)
+	{
+		const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
+		if (CompanionInterface)
+		{
+			return CompanionInterface->GetAbilityQueueComponent();
+		}
+
+		return Actor->FindComponentByClass<UGSCAbilityQueueComponent>();
+	}
+}
 
 UGSCAbilitySystemComponent* UGSCBlueprintFunctionLibrary::GetAbilitySystemComponentFromActor(const AActor* Actor)
 {
@@ -24,16 +74,13 @@ UGSCComboManagerComponent* UGSCBlueprintFunctionLibrary::GetComboManagerComponen
 		return nullptr;
 	}
 
-	const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
-	if (CompanionInterface)
+	UGSCComponentCacheSubsystem* ComponentCache = UGSCComponentCacheSubsystem::Get(Actor);
+	if (ComponentCache)
 	{
-		return CompanionInterface->GetComboManagerComponent();
+		return ComponentCache->FindOrResolveComboManagerComponent(Actor, &GSCBlueprintFunctionLibrary_Impl::ResolveComboManagerComponent);
 	}
 
-	// GSC_LOG(Log, TEXT("GetComboManagerComponent called on %s that is not IGSCCompanionInterface. This slow!"), *Actor->GetName())
-
-	// Fall back to a component search to better support BP-only actors
-	return Actor->FindComponentByClass<UGSCComboManagerComponent>();
+	return GSCBlueprintFunctionLibrary_Impl::ResolveComboManagerComponent(Actor);
 }
 
 UGSCCoreComponent* UGSCBlueprintFunctionLibrary::GetCompanionCoreComponent(const AActor* Actor)
@@ -43,24 +90,13 @@ UGSCCoreComponent* UGSCBlueprintFunctionLibrary::GetCompanionCoreComponent(const
 		return nullptr;
 	}
 
-	// TODO: Do we keep this idea of BP implementable interface to avoid component search ?
-	if (Actor->GetClass()->ImplementsInterface(UGSCCompanionInterface::StaticClass()))
+	UGSCComponentCacheSubsystem* ComponentCache = UGSCComponentCacheSubsystem::Get(Actor);
+	if (ComponentCache)
 	{
-		UGSCCoreComponent* CoreComponent = IGSCCompanionInterface::Execute_K2_GetCompanionCoreComponent(Actor);
-		if (CoreComponent)
-		{
-			return CoreComponent;
-		}
-
-		const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
-		if (CompanionInterface)
-		{
-			return CompanionInterface->GetCompanionCoreComponent();
-		}
+		return ComponentCache->FindOrResolveCoreComponent(Actor, &GSCBlueprintFunctionLibrary_Impl::ResolveCompanionCoreComponent);
 	}
 
-	// Fall back to a component search to better support BP-only actors
-	return Actor->FindComponentByClass<UGSCCoreComponent>();
+	return GSCBlueprintFunctionLibrary_Impl::ResolveCompanionCoreComponent(Actor);
 }
 
 UGSCAbilityQueueComponent* UGSCBlueprintFunctionLibrary::GetAbilityQueueComponent(const AActor* Actor)
@@ -70,13 +106,13 @@ UGSCAbilityQueueComponent* UGSCBlueprintFunctionLibrary::GetAbilityQueueComponen
 		return nullptr;
 	}
 
-	const IGSCCompanionInterface* CompanionInterface = Cast<IGSCCompanionInterface>(Actor);
-	if (CompanionInterface)
+	UGSCComponentCacheSubsystem* ComponentCache = UGSCComponentCacheSubsystem::Get(Actor);
+	if (ComponentCache)
 	{
-		return CompanionInterface->GetAbilityQueueComponent();
+		return ComponentCache->FindOrResolveAbilityQueueComponent(Actor, &GSCBlueprintFunctionLibrary_Impl::ResolveAbilityQueueComponent);
 	}
 
-	return Actor->FindComponentByClass<UGSCAbilityQueueComponent>();
+	return GSCBlueprintFunctionLibrary_Impl::ResolveAbilityQueueComponent(Actor);
 }
 
 bool UGSCBlueprintFunctionLibrary::AddLooseGameplayTagsToActor(AActor* Actor, const FGameplayTagContainer GameplayTags)
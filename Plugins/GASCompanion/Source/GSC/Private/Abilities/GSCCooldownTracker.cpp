@@ -0,0 +1,259 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/GSCCooldownTracker.h"
+
+#include "AbilitySystemComponent.h"
+#include "GSCLog.h"
+#include "GSCStats.h"
+#include "TimerManager.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cooldown Tag Subscriptions"), STAT_GSC_CooldownTagSubscriptions, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tracked Cooldowns"), STAT_GSC_TrackedCooldowns, STATGROUP_GASCompanion);
+
+FGSCCooldownTracker::FGSCCooldownTracker(UAbilitySystemComponent* InAbilitySystemComponent)
+	: AbilitySystemComponent(InAbilitySystemComponent)
+{
+}
+
+FGSCCooldownTracker::~FGSCCooldownTracker()
+{
+	Shutdown();
+}
+
+void FGSCCooldownTracker::Initialize()
+{
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	if (ASC && !AbilityCommittedHandle.IsValid())
+	{
+		AbilityCommittedHandle = ASC->AbilityCommittedCallbacks.AddSP(this, &FGSCCooldownTracker::OnAbilityCommitted);
+	}
+}
+
+void FGSCCooldownTracker::Shutdown()
+{
+	DEC_DWORD_STAT_BY(STAT_GSC_CooldownTagSubscriptions, TagSubscriptions.Num());
+	DEC_DWORD_STAT_BY(STAT_GSC_TrackedCooldowns, CooldownHeap.Num());
+
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	if (ASC)
+	{
+		ASC->AbilityCommittedCallbacks.Remove(AbilityCommittedHandle);
+
+		for (const TPair<FGameplayTag, FDelegateHandle>& TagSubscription : TagSubscriptions)
+		{
+			ASC->RegisterGameplayTagEvent(TagSubscription.Key, EGameplayTagEventType::NewOrRemoved).Remove(TagSubscription.Value);
+		}
+
+		if (UWorld* World = ASC->GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(ExpirationTimerHandle);
+		}
+	}
+
+	AbilityCommittedHandle.Reset();
+	TagSubscriptions.Reset();
+	CooldownHeap.Reset();
+}
+
+void FGSCCooldownTracker::OnAbilityCommitted(UGameplayAbility* ActivatedAbility)
+{
+	if (!IsValid(ActivatedAbility))
+	{
+		GSC_LOG(Warning, TEXT("FGSCCooldownTracker::OnAbilityCommitted() Activated ability not valid"))
+		return;
+	}
+
+	// Figure out cooldown
+	if (!ActivatedAbility->GetCooldownGameplayEffect() || !ActivatedAbility->IsInstantiated())
+	{
+		return;
+	}
+
+	const FGameplayTagContainer* CooldownTags = ActivatedAbility->GetCooldownTags();
+	if (!CooldownTags || CooldownTags->Num() <= 0)
+	{
+		return;
+	}
+
+	const FGameplayAbilityActorInfo ActorInfo = ActivatedAbility->GetActorInfo();
+	const FGameplayAbilitySpecHandle AbilitySpecHandle = ActivatedAbility->GetCurrentAbilitySpecHandle();
+
+	float TimeRemaining = 0.f;
+	float Duration = 0.f;
+	ActivatedAbility->GetCooldownTimeRemainingAndDuration(AbilitySpecHandle, &ActorInfo, TimeRemaining, Duration);
+
+	TrackCooldown(AbilitySpecHandle, *CooldownTags, TimeRemaining, Duration);
+
+	OnCooldownStart.Broadcast(AbilitySpecHandle, ActivatedAbility, *CooldownTags, TimeRemaining, Duration);
+}
+
+void FGSCCooldownTracker::TrackCooldown(const FGameplayAbilitySpecHandle AbilitySpecHandle, const FGameplayTagContainer& CooldownTags, const float TimeRemaining, const float Duration)
+{
+	// A spec has only one cooldown at a time, re-committing while on cooldown replaces it
+	const int32 ExistingIndex = CooldownHeap.IndexOfByPredicate([AbilitySpecHandle](const FTrackedCooldown& TrackedCooldown)
+	{
+		return TrackedCooldown.AbilitySpecHandle == AbilitySpecHandle;
+	});
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		CooldownHeap.HeapRemoveAt(ExistingIndex, FExpireTimePredicate(), false);
+		DEC_DWORD_STAT(STAT_GSC_TrackedCooldowns);
+	}
+
+	FTrackedCooldown TrackedCooldown;
+	TrackedCooldown.ExpireTime = TimeRemaining > 0.f ? GetWorldTime() + TimeRemaining : MAX_dbl;
+	TrackedCooldown.AbilitySpecHandle = AbilitySpecHandle;
+	TrackedCooldown.CooldownTags = CooldownTags;
+	TrackedCooldown.PendingTags = CooldownTags;
+	TrackedCooldown.Duration = Duration;
+	CooldownHeap.HeapPush(MoveTemp(TrackedCooldown), FExpireTimePredicate());
+	INC_DWORD_STAT(STAT_GSC_TrackedCooldowns);
+
+	for (const FGameplayTag& CooldownTag : CooldownTags)
+	{
+		SubscribeToTag(CooldownTag);
+	}
+
+	ScheduleExpirationTimer();
+}
+
+void FGSCCooldownTracker::SubscribeToTag(const FGameplayTag& CooldownTag)
+{
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	if (!ASC || TagSubscriptions.Contains(CooldownTag))
+	{
+		return;
+	}
+
+	const FDelegateHandle Handle = ASC->RegisterGameplayTagEvent(CooldownTag, EGameplayTagEventType::NewOrRemoved).AddSP(this, &FGSCCooldownTracker::OnCooldownTagChanged);
+	TagSubscriptions.Add(CooldownTag, Handle);
+	INC_DWORD_STAT(STAT_GSC_CooldownTagSubscriptions);
+}
+
+void FGSCCooldownTracker::OnCooldownTagChanged(const FGameplayTag CooldownTag, const int32 NewCount)
+{
+	if (NewCount != 0)
+	{
+		return;
+	}
+
+	// Gather ended cooldowns first, listeners might commit abilities (and modify the heap) while we broadcast
+	TArray<FTrackedCooldown, TInlineAllocator<4>> EndedCooldowns;
+	bool bHeapModified = false;
+
+	for (int32 Index = CooldownHeap.Num() - 1; Index >= 0; --Index)
+	{
+		FTrackedCooldown& TrackedCooldown = CooldownHeap[Index];
+		if (TrackedCooldown.PendingTags.RemoveTag(CooldownTag))
+		{
+			EndedCooldowns.Add(TrackedCooldown);
+			if (TrackedCooldown.PendingTags.Num() == 0)
+			{
+				CooldownHeap.RemoveAtSwap(Index, 1, false);
+				DEC_DWORD_STAT(STAT_GSC_TrackedCooldowns);
+				bHeapModified = true;
+			}
+		}
+	}
+
+	if (bHeapModified)
+	{
+		CooldownHeap.Heapify(FExpireTimePredicate());
+		ScheduleExpirationTimer();
+	}
+
+	for (const FTrackedCooldown& EndedCooldown : EndedCooldowns)
+	{
+		// Ability might have been cleared when cooldown expires
+		UGameplayAbility* Ability = GetSpecAbility(EndedCooldown.AbilitySpecHandle);
+		if (IsValid(Ability))
+		{
+			OnCooldownEnd.Broadcast(EndedCooldown.AbilitySpecHandle, Ability, CooldownTag, EndedCooldown.Duration);
+		}
+	}
+}
+
+void FGSCCooldownTracker::OnExpirationTimer()
+{
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	if (!ASC)
+	{
+		return;
+	}
+
+	// Cooldowns past their expected expiration time but still there, tag removal is what ends them
+	TArray<FTrackedCooldown, TInlineAllocator<4>> ChangedCooldowns;
+	const double Now = GetWorldTime();
+
+	while (CooldownHeap.Num() > 0 && CooldownHeap.HeapTop().ExpireTime <= Now)
+	{
+		FTrackedCooldown TrackedCooldown;
+		CooldownHeap.HeapPop(TrackedCooldown, FExpireTimePredicate(), false);
+
+		float TimeRemaining = 0.f;
+		float Duration = TrackedCooldown.Duration;
+		UGameplayAbility* Ability = GetSpecAbility(TrackedCooldown.AbilitySpecHandle);
+		if (IsValid(Ability))
+		{
+			Ability->GetCooldownTimeRemainingAndDuration(TrackedCooldown.AbilitySpecHandle, ASC->AbilityActorInfo.Get(), TimeRemaining, Duration);
+		}
+
+		// Extended (or re-applied from elsewhere), otherwise most likely expiring this frame and waiting for the tag removal
+		const bool bExtended = TimeRemaining > KINDA_SMALL_NUMBER;
+		TrackedCooldown.ExpireTime = bExtended ? Now + TimeRemaining : MAX_dbl;
+		TrackedCooldown.Duration = Duration;
+
+		if (bExtended && IsValid(Ability))
+		{
+			ChangedCooldowns.Add(TrackedCooldown);
+		}
+
+		CooldownHeap.HeapPush(MoveTemp(TrackedCooldown), FExpireTimePredicate());
+	}
+
+	ScheduleExpirationTimer();
+
+	for (const FTrackedCooldown& ChangedCooldown : ChangedCooldowns)
+	{
+		const float TimeRemaining = static_cast<float>(ChangedCooldown.ExpireTime - Now);
+		OnCooldownChanged.Broadcast(ChangedCooldown.AbilitySpecHandle, GetSpecAbility(ChangedCooldown.AbilitySpecHandle), ChangedCooldown.CooldownTags, TimeRemaining, ChangedCooldown.Duration);
+	}
+}
+
+void FGSCCooldownTracker::ScheduleExpirationTimer()
+{
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	UWorld* World = ASC ? ASC->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if (CooldownHeap.Num() == 0 || CooldownHeap.HeapTop().ExpireTime == MAX_dbl)
+	{
+		TimerManager.ClearTimer(ExpirationTimerHandle);
+		return;
+	}
+
+	const float Delay = FMath::Max(static_cast<float>(CooldownHeap.HeapTop().ExpireTime - GetWorldTime()), KINDA_SMALL_NUMBER);
+	TimerManager.SetTimer(ExpirationTimerHandle, FTimerDelegate::CreateSP(this, &FGSCCooldownTracker::OnExpirationTimer), Delay, false);
+}
+
+UGameplayAbility* FGSCCooldownTracker::GetSpecAbility(const FGameplayAbilitySpecHandle AbilitySpecHandle) const
+{
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	const FGameplayAbilitySpec* AbilitySpec = ASC ? ASC->FindAbilitySpecFromHandle(AbilitySpecHandle) : nullptr;
+	return AbilitySpec ? AbilitySpec->Ability : nullptr;
+}
+
+double FGSCCooldownTracker::GetWorldTime() const
+{
+	const UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	const UWorld* World = ASC ? ASC->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.;
+}
@@ -2,11 +2,24 @@
 
 
 #include "Abilities/GSCGameplayAbility.h"
+#include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Abilities/GSCTargetType.h"
 #include "Components/GSCAbilityQueueComponent.h"
 #include "Abilities/GSCBlueprintFunctionLibrary.h"
 #include "GSCLog.h"
+#include "GSCStats.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loose Cost Checks"), STAT_GSC_LooseCostChecks, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loose Cost Check Cache Rebuilds"), STAT_GSC_LooseCostCheckCacheRebuilds, STATGROUP_GASCompanion);
+
+static bool GGSCCacheLooseCostChecks = true;
+static FAutoConsoleVariableRef CVarGSCCacheLooseCostChecks(
+	TEXT("GSC.CacheLooseCostChecks"),
+	GGSCCacheLooseCostChecks,
+	TEXT("If true, abilities with bLooselyCheckAbilityCost cache the attributes of their cost effect instead of building a cost spec on every check")
+);
 
 UGSCGameplayAbility::UGSCGameplayAbility() {}
 
@@ -27,7 +40,7 @@ FGSCGameplayEffectContainerSpec UGSCGameplayAbility::MakeEffectContainerSpecFrom
 			const UGSCTargetType* TargetTypeCDO = Container.TargetType.GetDefaultObject();
 			AActor* AvatarActor = GetAvatarActorFromActorInfo();
 			TargetTypeCDO->GetTargets(AvatarActor, EventData, HitResults, TargetActors);
-			ReturnSpec.AddTargets(HitResults, TargetActors);
+			ReturnSpec.AddTargets(HitResults, TargetActors, Container.bPackHitResults);
 		}
 
 		// If we don't have an override level, use the default on the ability itself
@@ -65,14 +78,16 @@ FGSCGameplayEffectContainerSpec UGSCGameplayAbility::MakeEffectContainerSpec(FGa
 
 TArray<FActiveGameplayEffectHandle> UGSCGameplayAbility::ApplyEffectContainerSpec(const FGSCGameplayEffectContainerSpec& ContainerSpec)
 {
-	TArray<FActiveGameplayEffectHandle> AllEffects;
-
-	// Iterate list of effect specs and apply them to their target data
-	for (const FGameplayEffectSpecHandle& SpecHandle : ContainerSpec.TargetGameplayEffectSpecs)
+	const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+	UAbilitySystemComponent* AbilitySystemComponent = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	if (!AbilitySystemComponent || !HasAuthorityOrPredictionKey(ActorInfo, &CurrentActivationInfo))
 	{
-		AllEffects.Append(K2_ApplyGameplayEffectSpecToTarget(SpecHandle, ContainerSpec.TargetData));
+		return TArray<FActiveGameplayEffectHandle>();
 	}
-	return AllEffects;
+
+	// Same as K2_ApplyGameplayEffectSpecToTarget for each spec, but with targets resolved once for all of them
+	TARGETLIST_SCOPE_LOCK(*AbilitySystemComponent);
+	return ContainerSpec.ApplyToTargets(AbilitySystemComponent->GetPredictionKeyForNewAction());
 }
 
 TArray<FActiveGameplayEffectHandle> UGSCGameplayAbility::ApplyEffectContainer(FGameplayTag ContainerTag, const FGameplayEventData& EventData, int32 OverrideGameplayLevel)
@@ -163,13 +178,44 @@ void UGSCGameplayAbility::AbilityEnded(UGameplayAbility* Ability)
 
 bool UGSCGameplayAbility::CheckForPositiveCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
 {
+	INC_DWORD_STAT(STAT_GSC_LooseCostChecks);
+
 	UGameplayEffect* CostGE = GetCostGameplayEffect();
 	if (!CostGE)
 	{
 		return true;
 	}
 
-	if (!CanApplyPositiveAttributeModifiers(CostGE, ActorInfo, GetAbilityLevel(Handle, ActorInfo), MakeEffectContext(Handle, ActorInfo)))
+	bool bCanApplyCost;
+	if (GGSCCacheLooseCostChecks)
+	{
+		// Modifier magnitudes are not looked at by loose checks, no need for a spec (nor an effect context) here
+		UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
+		bCanApplyCost = ASC != nullptr;
+		if (ASC)
+		{
+			for (const FGameplayAttribute& Attribute : GetCachedCostAttributes(CostGE))
+			{
+				if (!ASC->HasAttributeSetForAttribute(Attribute))
+				{
+					continue;
+				}
+
+				const UAttributeSet* Set = GetAttributeSubobjectForASC(ASC, Attribute.GetAttributeSetClass());
+				if (Attribute.GetNumericValueChecked(Set) <= 0.f)
+				{
+					bCanApplyCost = false;
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		bCanApplyCost = CanApplyPositiveAttributeModifiers(CostGE, ActorInfo, GetAbilityLevel(Handle, ActorInfo), MakeEffectContext(Handle, ActorInfo));
+	}
+
+	if (!bCanApplyCost)
 	{
 		const FGameplayTag& CostTag = UAbilitySystemGlobals::Get().ActivateFailCostTag;
 		if (OptionalRelevantTags && CostTag.IsValid())
@@ -239,3 +285,26 @@ const UAttributeSet* UGSCGameplayAbility::GetAttributeSubobjectForASC(UAbilitySy
 
 	return nullptr;
 }
+
+const TArray<FGameplayAttribute, TInlineAllocator<2>>& UGSCGameplayAbility::GetCachedCostAttributes(const UGameplayEffect* CostGameplayEffect) const
+{
+	if (CachedCostGameplayEffect.Get() == CostGameplayEffect)
+	{
+		return CachedCostAttributes;
+	}
+
+	INC_DWORD_STAT(STAT_GSC_LooseCostCheckCacheRebuilds);
+
+	// Same modifiers CanApplyPositiveAttributeModifiers would check: it only makes sense to check additive operators
+	CachedCostGameplayEffect = CostGameplayEffect;
+	CachedCostAttributes.Reset();
+	for (const FGameplayModifierInfo& ModDef : CostGameplayEffect->Modifiers)
+	{
+		if (ModDef.ModifierOp == EGameplayModOp::Additive && ModDef.Attribute.IsValid())
+		{
+			CachedCostAttributes.Add(ModDef.Attribute);
+		}
+	}
+
+	return CachedCostAttributes;
+}
@@ -3,6 +3,15 @@
 
 #include "Abilities/GSCTypes.h"
 
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayCueManager.h"
+#include "GameplayEffect.h"
+#include "GSCStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Effect Container Apply"), STAT_GSC_EffectContainerApply, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Container Effects Applied"), STAT_GSC_EffectContainerEffectsApplied, STATGROUP_GASCompanion);
+
 bool FGSCGameplayEffectContainerSpec::HasValidEffects() const
 {
 	return TargetGameplayEffectSpecs.Num() > 0;
@@ -13,12 +22,25 @@ bool FGSCGameplayEffectContainerSpec::HasValidTargets() const
 	return TargetData.Num() > 0;
 }
 
-void FGSCGameplayEffectContainerSpec::AddTargets(const TArray<FHitResult>& HitResults, const TArray<AActor*>& TargetActors)
+void FGSCGameplayEffectContainerSpec::AddTargets(const TArray<FHitResult>& HitResults, const TArray<AActor*>& TargetActors, const bool bPackHitResults)
 {
-	for (const FHitResult& HitResult : HitResults)
+	if (!bPackHitResults || HitResults.Num() == 1)
 	{
-		FGameplayAbilityTargetData_SingleTargetHit* NewData = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
-		TargetData.Add(NewData);
+		TargetData.Data.Reserve(TargetData.Num() + HitResults.Num() + 1);
+		for (const FHitResult& HitResult : HitResults)
+		{
+			TargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+		}
+	}
+	else if (HitResults.Num() > 1)
+	{
+		// AoE hits can be in the hundreds, keep them in a single allocation rather than one target data per hit
+		// Split in chunks small enough to be replicated
+		for (int32 First = 0; First < HitResults.Num(); First += FGSCGameplayAbilityTargetData_MultiHit::MaxHitResults)
+		{
+			const int32 NumHits = FMath::Min(HitResults.Num() - First, FGSCGameplayAbilityTargetData_MultiHit::MaxHitResults);
+			TargetData.Add(new FGSCGameplayAbilityTargetData_MultiHit(HitResults.GetData() + First, NumHits));
+		}
 	}
 
 	if (TargetActors.Num() > 0)
@@ -28,3 +50,224 @@ void FGSCGameplayEffectContainerSpec::AddTargets(const TArray<FHitResult>& HitRe
 		TargetData.Add(NewData);
 	}
 }
+
+TArray<FActiveGameplayEffectHandle> FGSCGameplayEffectContainerSpec::ApplyToTargets(const FPredictionKey PredictionKey) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GSC_EffectContainerApply);
+
+	TArray<FActiveGameplayEffectHandle> AppliedHandles;
+	if (!HasValidEffects() || !HasValidTargets())
+	{
+		return AppliedHandles;
+	}
+
+	/** A target of one of the target data, with what FGameplayAbilityTargetData::ApplyGameplayEffectSpec would add to its effect context */
+	struct FResolvedTarget
+	{
+		UAbilitySystemComponent* AbilitySystemComponent;
+		const FGameplayAbilityTargetData* Data;
+		const FHitResult* HitResult;
+	};
+
+	/** Range of resolved targets for a target data, or none for target data types we don't know how to batch */
+	struct FTargetDataRange
+	{
+		const TSharedPtr<FGameplayAbilityTargetData>* Data;
+		int32 First;
+		int32 Num;
+		bool bBatched;
+	};
+
+	TArray<FResolvedTarget, TInlineAllocator<16>> Targets;
+	TArray<FTargetDataRange, TInlineAllocator<4>> Ranges;
+	Ranges.Reserve(TargetData.Num());
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+	{
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		FTargetDataRange& Range = Ranges.Add_GetRef({ &Data, Targets.Num(), 0, true });
+		const UScriptStruct* DataStruct = Data->GetScriptStruct();
+		if (DataStruct == FGSCGameplayAbilityTargetData_MultiHit::StaticStruct())
+		{
+			for (const FHitResult& HitResult : static_cast<const FGSCGameplayAbilityTargetData_MultiHit*>(Data.Get())->GetHitResults())
+			{
+				if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitResult.GetActor()))
+				{
+					Targets.Add({ TargetASC, nullptr, &HitResult });
+				}
+			}
+		}
+		else if (DataStruct == FGameplayAbilityTargetData_SingleTargetHit::StaticStruct() || DataStruct == FGameplayAbilityTargetData_ActorArray::StaticStruct())
+		{
+			for (const TWeakObjectPtr<AActor>& Actor : Data->GetActors())
+			{
+				if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Actor.Get()))
+				{
+					Targets.Add({ TargetASC, Data.Get(), nullptr });
+				}
+			}
+		}
+		else
+		{
+			// Might have its own ApplyGameplayEffectSpec, let it apply specs itself
+			Range.bBatched = false;
+		}
+
+		Range.Num = Targets.Num() - Range.First;
+	}
+
+	FScopedGameplayCueSendContext GameplayCueSendContext;
+	AppliedHandles.Reserve(TargetGameplayEffectSpecs.Num() * Targets.Num());
+
+	for (const FGameplayEffectSpecHandle& SpecHandle : TargetGameplayEffectSpecs)
+	{
+		if (!SpecHandle.IsValid())
+		{
+			continue;
+		}
+
+		FGameplayEffectSpec& Spec = *SpecHandle.Data.Get();
+
+		// Same requirement as FGameplayAbilityTargetData::ApplyGameplayEffectSpec
+		if (!ensure(Spec.GetContext().IsValid() && Spec.GetContext().GetInstigatorAbilitySystemComponent()))
+		{
+			continue;
+		}
+
+		for (const FTargetDataRange& Range : Ranges)
+		{
+			if (!Range.bBatched)
+			{
+				AppliedHandles.Append((*Range.Data)->ApplyGameplayEffectSpec(Spec, PredictionKey));
+				continue;
+			}
+
+			for (int32 Index = Range.First; Index < Range.First + Range.Num; ++Index)
+			{
+				const FResolvedTarget& Target = Targets[Index];
+
+				// New spec and context per target, otherwise targeting info would accumulate in a shared context
+				FGameplayEffectSpec SpecToApply(Spec);
+				FGameplayEffectContextHandle EffectContext = SpecToApply.GetContext().Duplicate();
+				SpecToApply.SetContext(EffectContext);
+				if (Target.HitResult)
+				{
+					FGSCGameplayAbilityTargetData_MultiHit::AddHitToContext(EffectContext, *Target.HitResult);
+				}
+				else
+				{
+					Target.Data->AddTargetDataToContext(EffectContext, false);
+				}
+
+				AppliedHandles.Add(EffectContext.GetInstigatorAbilitySystemComponent()->ApplyGameplayEffectSpecToTarget(SpecToApply, Target.AbilitySystemComponent, PredictionKey));
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_GSC_EffectContainerEffectsApplied, AppliedHandles.Num());
+	return AppliedHandles;
+}
+
+TArray<TWeakObjectPtr<AActor>> FGSCGameplayAbilityTargetData_MultiHit::GetActors() const
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	Actors.Reserve(HitResults.Num());
+	for (const FHitResult& HitResult : HitResults)
+	{
+		if (HitResult.GetActor())
+		{
+			Actors.Add(HitResult.GetActor());
+		}
+	}
+	return Actors;
+}
+
+FTransform FGSCGameplayAbilityTargetData_MultiHit::GetOrigin() const
+{
+	if (HitResults.Num() == 0)
+	{
+		return FTransform::Identity;
+	}
+
+	// Same as FGameplayAbilityTargetData_SingleTargetHit, for the first hit
+	const FHitResult& HitResult = HitResults[0];
+	return FTransform((HitResult.TraceEnd - HitResult.TraceStart).Rotation(), HitResult.TraceStart);
+}
+
+void FGSCGameplayAbilityTargetData_MultiHit::AddHitToContext(FGameplayEffectContextHandle& EffectContext, const FHitResult& HitResult)
+{
+	// Same as FGameplayAbilityTargetData::AddTargetDataToContext for a FGameplayAbilityTargetData_SingleTargetHit of this hit
+	EffectContext.AddHitResult(HitResult, true);
+	EffectContext.AddOrigin(HitResult.TraceStart);
+}
+
+TArray<FActiveGameplayEffectHandle> FGSCGameplayAbilityTargetData_MultiHit::ApplyGameplayEffectSpec(FGameplayEffectSpec& InSpec, const FPredictionKey PredictionKey)
+{
+	TArray<FActiveGameplayEffectHandle> AppliedHandles;
+
+	if (!ensure(InSpec.GetContext().IsValid() && InSpec.GetContext().GetInstigatorAbilitySystemComponent()))
+	{
+		return AppliedHandles;
+	}
+
+	// Same as FGameplayAbilityTargetData::ApplyGameplayEffectSpec, but with each target own hit result in its effect context
+	AppliedHandles.Reserve(HitResults.Num());
+	for (const FHitResult& HitResult : HitResults)
+	{
+		UAbilitySystemComponent* TargetComponent = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(HitResult.GetActor());
+		if (!TargetComponent)
+		{
+			continue;
+		}
+
+		// New spec and context per target, otherwise hit results would accumulate in a shared context
+		FGameplayEffectSpec SpecToApply(InSpec);
+		FGameplayEffectContextHandle EffectContext = SpecToApply.GetContext().Duplicate();
+		AddHitToContext(EffectContext, HitResult);
+		SpecToApply.SetContext(EffectContext);
+
+		AppliedHandles.Add(EffectContext.GetInstigatorAbilitySystemComponent()->ApplyGameplayEffectSpecToTarget(SpecToApply, TargetComponent, PredictionKey));
+	}
+
+	return AppliedHandles;
+}
+
+bool FGSCGameplayAbilityTargetData_MultiHit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 NumHitResults = HitResults.Num();
+	if (Ar.IsSaving() && NumHitResults > (uint32)MaxHitResults)
+	{
+		// AddTargets splits hits, only target data built by hand can end up here
+		ensureMsgf(false, TEXT("FGSCGameplayAbilityTargetData_MultiHit::NetSerialize %u hit results, only the first %d are sent"), NumHitResults, MaxHitResults);
+		NumHitResults = MaxHitResults;
+	}
+
+	Ar.SerializeIntPacked(NumHitResults);
+
+	if (Ar.IsLoading())
+	{
+		// Guard against bogus counts before allocating
+		if (NumHitResults > (uint32)MaxHitResults)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+
+		HitResults.SetNum(NumHitResults);
+	}
+
+	bOutSuccess = true;
+	for (uint32 Index = 0; Index < NumHitResults; ++Index)
+	{
+		bool bHitSuccess = true;
+		HitResults[Index].NetSerialize(Ar, Map, bHitSuccess);
+		bOutSuccess &= bHitSuccess;
+	}
+
+	return true;
+}
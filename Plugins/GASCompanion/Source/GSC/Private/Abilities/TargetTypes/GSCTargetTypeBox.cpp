@@ -0,0 +1,15 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/TargetTypes/GSCTargetTypeBox.h"
+
+bool UGSCTargetTypeBox::ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const
+{
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Origin);
+	return FMath::Abs(LocalPoint.X) <= HalfExtent.X && FMath::Abs(LocalPoint.Y) <= HalfExtent.Y && FMath::Abs(LocalPoint.Z) <= HalfExtent.Z;
+}
+
+FCollisionShape UGSCTargetTypeBox::GetCollisionShape() const
+{
+	return FCollisionShape::MakeBox(HalfExtent);
+}
@@ -0,0 +1,16 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/TargetTypes/GSCTargetTypeCapsule.h"
+
+bool UGSCTargetTypeCapsule::ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const
+{
+	const FVector Axis = Rotation.GetUpVector() * FMath::Max(HalfHeight - Radius, 0.f);
+	const FVector ClosestPoint = FMath::ClosestPointOnSegment(Point, Origin - Axis, Origin + Axis);
+	return FVector::DistSquared(ClosestPoint, Point) <= FMath::Square(Radius);
+}
+
+FCollisionShape UGSCTargetTypeCapsule::GetCollisionShape() const
+{
+	return FCollisionShape::MakeCapsule(Radius, HalfHeight);
+}
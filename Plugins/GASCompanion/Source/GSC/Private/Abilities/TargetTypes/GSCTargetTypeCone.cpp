@@ -0,0 +1,28 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/TargetTypes/GSCTargetTypeCone.h"
+
+bool UGSCTargetTypeCone::ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const
+{
+	const FVector ToPoint = Point - Origin;
+	const float DistanceSquared = ToPoint.SizeSquared();
+	if (DistanceSquared > FMath::Square(Length))
+	{
+		return false;
+	}
+
+	// Apex itself is considered inside
+	if (DistanceSquared <= KINDA_SMALL_NUMBER)
+	{
+		return true;
+	}
+
+	const float CosAngle = FVector::DotProduct(ToPoint / FMath::Sqrt(DistanceSquared), Rotation.GetForwardVector());
+	return CosAngle >= FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+}
+
+FCollisionShape UGSCTargetTypeCone::GetCollisionShape() const
+{
+	return FCollisionShape::MakeSphere(Length);
+}
@@ -0,0 +1,111 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/TargetTypes/GSCTargetTypeOverlap.h"
+
+#include "DrawDebugHelpers.h"
+#include "GSCStats.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Type Overlap"), STAT_GSC_TargetTypeOverlap, STATGROUP_GASCompanion);
+
+void UGSCTargetTypeOverlap::GetTargets_Implementation(AActor* TargetingActor, FGameplayEventData EventData, TArray<FHitResult>& OutHitResults, TArray<AActor*>& OutActors) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GSC_TargetTypeOverlap);
+
+	UWorld* World = TargetingActor ? TargetingActor->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	FVector Origin;
+	FQuat Rotation;
+	GetQueryTransform(TargetingActor, Origin, Rotation);
+
+	const FCollisionShape Shape = GetCollisionShape();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GSCTargetTypeOverlap), false);
+	if (bIgnoreTargetingActor)
+	{
+		QueryParams.AddIgnoredActor(TargetingActor);
+	}
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByChannel(Overlaps, Origin, Rotation, CollisionChannel, Shape, QueryParams);
+
+#if ENABLE_DRAW_DEBUG
+	if (bDrawDebug)
+	{
+		if (Shape.IsBox())
+		{
+			DrawDebugBox(World, Origin, Shape.GetExtent(), Rotation, FColor::Red, false, 2.f);
+		}
+		else if (Shape.IsCapsule())
+		{
+			DrawDebugCapsule(World, Origin, Shape.GetCapsuleHalfHeight(), Shape.GetCapsuleRadius(), Rotation, FColor::Red, false, 2.f);
+		}
+		else
+		{
+			DrawDebugSphere(World, Origin, Shape.GetSphereRadius(), 16, FColor::Red, false, 2.f);
+		}
+	}
+#endif
+
+	// An actor can overlap with several of its components, only keep it once
+	struct FCandidate
+	{
+		AActor* Actor;
+		float DistanceSquared;
+	};
+
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+	Candidates.Reserve(Overlaps.Num());
+
+	TSet<const AActor*, DefaultKeyFuncs<const AActor*>, TInlineSetAllocator<32>> SeenActors;
+	SeenActors.Reserve(Overlaps.Num());
+
+	const bool bFilter = NeedsContainsPointFilter();
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Actor = Overlap.GetActor();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		SeenActors.Add(Actor, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			continue;
+		}
+
+		const FVector Location = Actor->GetActorLocation();
+		if (bFilter && !ContainsPoint(Origin, Rotation, Location))
+		{
+			continue;
+		}
+
+		Candidates.Add({ Actor, FVector::DistSquared(Origin, Location) });
+	}
+
+	if (bSortByDistance || MaxTargets > 0)
+	{
+		Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+	}
+
+	const int32 NumTargets = MaxTargets > 0 ? FMath::Min(MaxTargets, Candidates.Num()) : Candidates.Num();
+	OutActors.Reserve(OutActors.Num() + NumTargets);
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		OutActors.Add(Candidates[Index].Actor);
+	}
+}
+
+void UGSCTargetTypeOverlap::GetQueryTransform(const AActor* TargetingActor, FVector& OutOrigin, FQuat& OutRotation) const
+{
+	OutRotation = TargetingActor ? TargetingActor->GetActorQuat() : FQuat::Identity;
+	OutOrigin = TargetingActor ? TargetingActor->GetActorLocation() + OutRotation.RotateVector(Offset) : Offset;
+}
@@ -0,0 +1,14 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/TargetTypes/GSCTargetTypeSphere.h"
+
+bool UGSCTargetTypeSphere::ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const
+{
+	return FVector::DistSquared(Origin, Point) <= FMath::Square(Radius);
+}
+
+FCollisionShape UGSCTargetTypeSphere::GetCollisionShape() const
+{
+	return FCollisionShape::MakeSphere(Radius);
+}
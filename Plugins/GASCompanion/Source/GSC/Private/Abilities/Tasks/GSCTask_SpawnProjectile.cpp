@@ -4,6 +4,7 @@
 #include "Abilities/Tasks/GSCTask_SpawnProjectile.h"
 
 #include "AbilitySystemComponent.h"
+#include "Subsystems/GSCProjectilePoolSubsystem.h"
 
 UGSCTask_SpawnProjectile* UGSCTask_SpawnProjectile::SpawnProjectile(UGameplayAbility* OwningAbility, const FTransform SpawnTransform, ESpawnActorCollisionHandlingMethod CollisionHandlingOverride, TSubclassOf<AGSCProjectileBase> InClass)
 {
@@ -24,7 +25,15 @@ bool UGSCTask_SpawnProjectile::BeginSpawningActor(UGameplayAbility* OwningAbilit
 		{
 			AActor* OwningActor = Ability->GetOwningActorFromActorInfo();
 			APawn* AvatarPawn = Cast<APawn>(Ability->GetAvatarActorFromActorInfo());
-			SpawnedActor = World->SpawnActorDeferred<AGSCProjectileBase>(InClass, CachedSpawnTransform, OwningActor, AvatarPawn, CachedCollisionHandlingOverride);
+			UGSCProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UGSCProjectilePoolSubsystem>();
+			if (InClass && InClass->GetDefaultObject<AGSCProjectileBase>()->bPooled && ProjectilePool)
+			{
+				SpawnedActor = ProjectilePool->AcquireProjectile(InClass, CachedSpawnTransform, OwningActor, AvatarPawn, CachedCollisionHandlingOverride);
+			}
+			else
+			{
+				SpawnedActor = World->SpawnActorDeferred<AGSCProjectileBase>(InClass, CachedSpawnTransform, OwningActor, AvatarPawn, CachedCollisionHandlingOverride);
+			}
 		}
 	}
 
@@ -44,7 +53,25 @@ void UGSCTask_SpawnProjectile::FinishSpawningActor(UGameplayAbility* OwningAbili
 {
 	if (SpawnedActor)
 	{
-		SpawnedActor->FinishSpawning(CachedSpawnTransform);
+		UGSCProjectilePoolSubsystem* ProjectilePool = SpawnedActor->IsPooledProjectile() ? UGSCProjectilePoolSubsystem::Get(SpawnedActor) : nullptr;
+		if (ProjectilePool)
+		{
+			// Reused projectiles go through the spawn collision handling here, and might not be fired after all
+			if (!ProjectilePool->FinishProjectile(SpawnedActor, CachedSpawnTransform))
+			{
+				if (ShouldBroadcastAbilityTaskDelegates())
+				{
+					DidNotSpawn.Broadcast(nullptr);
+				}
+
+				EndTask();
+				return;
+			}
+		}
+		else
+		{
+			SpawnedActor->FinishSpawning(CachedSpawnTransform);
+		}
 
 		if (ShouldBroadcastAbilityTaskDelegates())
 		{
@@ -11,6 +11,7 @@
 #include "Components/GSCAbilityQueueComponent.h"
 #include "Components/GSCComboManagerComponent.h"
 #include "Components/GSCCoreComponent.h"
+#include "Subsystems/GSCSignificanceSubsystem.h"
 
 // Sets default values
 AGSCCharacterBase::AGSCCharacterBase(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -33,10 +34,30 @@ AGSCCharacterBase::AGSCCharacterBase(const FObjectInitializer& ObjectInitializer
     MeshComponent->bEnableUpdateRateOptimizations = true;
     MeshComponent->bPropagateCurvesToSlaves = true;
 
-    // Always tick Pose and refresh Bones!
+    // Always tick Pose and refresh Bones! Scaled down at runtime by UGSCSignificanceSubsystem when significance is enabled
     MeshComponent->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 }
 
+void AGSCCharacterBase::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+}
+
+void AGSCCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 UGSCAbilitySystemComponent* AGSCCharacterBase::GetASC()
 {
     return UGSCAbilitySystemComponent::GetAbilitySystemComponentFromActor(this);
@@ -3,6 +3,7 @@
 
 #include "Actors/Projectiles/GSCProjectileBase.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "Subsystems/GSCProjectilePoolSubsystem.h"
 
 // Sets default values
 AGSCProjectileBase::AGSCProjectileBase()
@@ -20,3 +21,104 @@ void AGSCProjectileBase::BeginPlay()
 {
 	Super::BeginPlay();
 }
+
+void AGSCProjectileBase::ReleaseProjectile()
+{
+	if (bInPool)
+	{
+		return;
+	}
+
+	UGSCProjectilePoolSubsystem* Pool = bManagedByPool ? UGSCProjectilePoolSubsystem::Get(this) : nullptr;
+	if (Pool)
+	{
+		Pool->ReleaseProjectile(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AGSCProjectileBase::OnProjectileActivated_Implementation()
+{
+}
+
+void AGSCProjectileBase::OnProjectileDeactivated_Implementation()
+{
+}
+
+void AGSCProjectileBase::LifeSpanExpired()
+{
+	if (bManagedByPool)
+	{
+		ReleaseProjectile();
+		return;
+	}
+
+	Super::LifeSpanExpired();
+}
+
+void AGSCProjectileBase::ActivatePooledProjectile(const FTransform& SpawnTransform)
+{
+	const AGSCProjectileBase* CDO = GetClass()->GetDefaultObject<AGSCProjectileBase>();
+
+	bInPool = false;
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(CDO->IsHidden());
+	SetActorEnableCollision(CDO->GetActorEnableCollision());
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
+	SetLifeSpan(CDO->InitialLifeSpan);
+
+	if (ProjectileMovement)
+	{
+		// Same initial velocity as UProjectileMovementComponent::InitializeComponent() would compute on a fresh spawn
+		const UProjectileMovementComponent* DefaultMovement = CDO->ProjectileMovement;
+		FVector InitialVelocity = DefaultMovement ? DefaultMovement->Velocity : FVector::ForwardVector;
+		if (ProjectileMovement->InitialSpeed > 0.f)
+		{
+			InitialVelocity = InitialVelocity.GetSafeNormal() * ProjectileMovement->InitialSpeed;
+		}
+
+		if (ProjectileMovement->bInitialVelocityInLocalSpace)
+		{
+			InitialVelocity = GetActorRotation().RotateVector(InitialVelocity);
+		}
+
+		ProjectileMovement->SetUpdatedComponent(GetRootComponent());
+		ProjectileMovement->Velocity = InitialVelocity;
+		ProjectileMovement->UpdateComponentVelocity();
+		ProjectileMovement->Activate(true);
+	}
+
+	SetNetDormancy(DORM_Awake);
+	ForceNetUpdate();
+
+	OnProjectileActivated();
+}
+
+void AGSCProjectileBase::DeactivatePooledProjectile()
+{
+	OnProjectileDeactivated();
+
+	bInPool = true;
+	SetLifeSpan(0.f);
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	// Don't keep the spec (and its context, instigator etc.) alive while sitting in the pool
+	DamageEffectSpecHandle = FGameplayEffectSpecHandle();
+
+	// Send the hidden state to clients before going dormant
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
@@ -3,11 +3,8 @@
 
 #include "Animations/GSCComboWindowNotifyState.h"
 #include "Abilities/GSCBlueprintFunctionLibrary.h"
-#include "Abilities/GSCGameplayAbility.h"
 #include "Actors/Characters/GSCCharacterBase.h"
 #include "Components/GSCComboManagerComponent.h"
-#include "Components/GSCCoreComponent.h"
-#include "GSCLog.h"
 
 void UGSCComboWindowNotifyState::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration)
 {
@@ -26,7 +23,7 @@ void UGSCComboWindowNotifyState::NotifyBegin(USkeletalMeshComponent* MeshComp, U
 	UGSCComboManagerComponent* ComboManagerComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(Owner);
 	if (ComboManagerComponent)
 	{
-		ComboManagerComponent->bComboWindowOpened = true;
+		ComboManagerComponent->OpenComboWindow(bEndCombo);
 	}
 }
 
@@ -47,62 +44,7 @@ void UGSCComboWindowNotifyState::NotifyEnd(USkeletalMeshComponent* MeshComp, UAn
 	UGSCComboManagerComponent* ComboManagerComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(Owner);
 	if (ComboManagerComponent)
 	{
-		GSC_LOG(Verbose, TEXT("NotifyEnd: bNextComboAbilityActivated %s (%s)"), ComboManagerComponent->bNextComboAbilityActivated ? TEXT("true") : TEXT("false"), *Owner->GetName())
-		GSC_LOG(Verbose, TEXT("NotifyEnd: bEndCombo %s (%s)"), bEndCombo ? TEXT("true") : TEXT("false"), *Owner->GetName())
-		if (!ComboManagerComponent->bNextComboAbilityActivated || bEndCombo)
-		{
-			GSC_LOG(Verbose, TEXT("NotifyEnd: ResetCombo  (%s)"), *Owner->GetName())
-			ComboManagerComponent->ResetCombo();
-		}
-
-		ComboManagerComponent->bComboWindowOpened = false;
-		ComboManagerComponent->bRequestTriggerCombo = false;
-		ComboManagerComponent->bShouldTriggerCombo = false;
-		ComboManagerComponent->bNextComboAbilityActivated = false;
-	}
-}
-
-void UGSCComboWindowNotifyState::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime)
-{
-	AActor* Owner = GetOwnerActor(MeshComp);
-	if (!Owner)
-	{
-		return;
-	}
-
-	// run only on server
-	if (!Owner->HasAuthority())
-	{
-		return;
-	}
-
-	UGSCComboManagerComponent* ComboManagerComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(Owner);
-	if (!ComboManagerComponent)
-	{
-		return;
-	}
-
-	if (ComboManagerComponent->bComboWindowOpened && ComboManagerComponent->bShouldTriggerCombo && ComboManagerComponent->bRequestTriggerCombo && !bEndCombo)
-	{
-		UGSCCoreComponent* CoreComponent = UGSCBlueprintFunctionLibrary::GetCompanionCoreComponent(Owner);
-		// prevent reactivate of ability in this tick window (especially on networked environment with some lags)
-		if (CoreComponent && !ComboManagerComponent->bNextComboAbilityActivated)
-		{
-			UGameplayAbility* ComboAbility = ComboManagerComponent->GetCurrentActiveComboAbility();
-			if (ComboAbility)
-			{
-				UGSCGameplayAbility* ActivatedAbility;
-				const bool bSuccess = CoreComponent->ActivateAbilityByClass(ComboAbility->GetClass(), ActivatedAbility);
-				if (bSuccess)
-				{
-					ComboManagerComponent->bNextComboAbilityActivated = true;
-				}
-				else
-				{
-					GSC_LOG(Verbose, TEXT("ComboWindowNotifyState:NotifyTick Ability %s didn't activate"), *ComboAbility->GetClass()->GetName())
-				}
-			}
-		}
+		ComboManagerComponent->CloseComboWindow(bEndCombo);
 	}
 }
 
@@ -24,7 +24,7 @@ void UGSCTriggerComboNotify::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 		return;
 	}
 
-	ComboManagerComponent->bRequestTriggerCombo = true;
+	ComboManagerComponent->RequestTriggerCombo();
 }
 
 FString UGSCTriggerComboNotify::GetNotifyName_Implementation() const
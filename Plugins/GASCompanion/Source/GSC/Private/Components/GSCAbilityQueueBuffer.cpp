@@ -0,0 +1,148 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Components/GSCAbilityQueueBuffer.h"
+
+#include "Abilities/GameplayAbility.h"
+#include "GSCStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Queue Dropped Activations"), STAT_GSC_AbilityQueueDroppedActivations, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Queue Expired Activations"), STAT_GSC_AbilityQueueExpiredActivations, STATGROUP_GASCompanion);
+
+void FGSCAbilityQueueBuffer::SetCapacity(const int32 InCapacity)
+{
+	const int32 NewCapacity = FMath::Max(InCapacity, 1);
+	if (NewCapacity == Entries.Num())
+	{
+		return;
+	}
+
+	// Keep the most recent activations, oldest first
+	TArray<FEntry, TInlineAllocator<4>> NewEntries;
+	NewEntries.SetNum(NewCapacity);
+
+	const int32 NumKept = FMath::Min(Count, NewCapacity);
+	for (int32 Index = 0; Index < NumKept; ++Index)
+	{
+		NewEntries[Index] = Entries[(Head + Count - NumKept + Index) % Entries.Num()];
+	}
+
+	Entries = MoveTemp(NewEntries);
+	Head = 0;
+	Count = NumKept;
+}
+
+void FGSCAbilityQueueBuffer::Enqueue(const UGameplayAbility* Ability, const double Time)
+{
+	if (Entries.Num() == 0)
+	{
+		SetCapacity(1);
+	}
+
+	if (Count == Entries.Num())
+	{
+		INC_DWORD_STAT(STAT_GSC_AbilityQueueDroppedActivations);
+		Head = (Head + 1) % Entries.Num();
+		--Count;
+	}
+
+	FEntry& Entry = Entries[(Head + Count) % Entries.Num()];
+	Entry.Ability = Ability;
+	Entry.QueuedTime = Time;
+	++Count;
+}
+
+const UGameplayAbility* FGSCAbilityQueueBuffer::Pop(const double Now, const float ExpiryTime, const TFunctionRef<bool(const UGameplayAbility*)> IsAllowed)
+{
+	while (Count > 0)
+	{
+		FEntry Entry = MoveTemp(Entries[Head]);
+		Entries[Head] = FEntry();
+		Head = (Head + 1) % Entries.Num();
+		--Count;
+
+		const UGameplayAbility* Ability = Entry.Ability.Get();
+		if (!Ability)
+		{
+			continue;
+		}
+
+		if (IsExpired(Entry, Now, ExpiryTime))
+		{
+			INC_DWORD_STAT(STAT_GSC_AbilityQueueExpiredActivations);
+			continue;
+		}
+
+		if (IsAllowed(Ability))
+		{
+			return Ability;
+		}
+	}
+
+	return nullptr;
+}
+
+void FGSCAbilityQueueBuffer::RemoveInvalid(const double Now, const float ExpiryTime, const TFunctionRef<bool(const UGameplayAbility*)> IsAllowed)
+{
+	// Compact kept activations towards the head, oldest first
+	int32 NumKept = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FEntry& Entry = Entries[(Head + Index) % Entries.Num()];
+		const UGameplayAbility* Ability = Entry.Ability.Get();
+		if (!Ability)
+		{
+			continue;
+		}
+
+		if (IsExpired(Entry, Now, ExpiryTime))
+		{
+			INC_DWORD_STAT(STAT_GSC_AbilityQueueExpiredActivations);
+			continue;
+		}
+
+		if (!IsAllowed(Ability))
+		{
+			continue;
+		}
+
+		if (NumKept != Index)
+		{
+			Entries[(Head + NumKept) % Entries.Num()] = MoveTemp(Entry);
+		}
+		++NumKept;
+	}
+
+	for (int32 Index = NumKept; Index < Count; ++Index)
+	{
+		Entries[(Head + Index) % Entries.Num()] = FEntry();
+	}
+
+	Count = NumKept;
+}
+
+const UGameplayAbility* FGSCAbilityQueueBuffer::Peek(const double Now, const float ExpiryTime) const
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FEntry& Entry = Entries[(Head + Index) % Entries.Num()];
+		const UGameplayAbility* Ability = Entry.Ability.Get();
+		if (Ability && !IsExpired(Entry, Now, ExpiryTime))
+		{
+			return Ability;
+		}
+	}
+
+	return nullptr;
+}
+
+void FGSCAbilityQueueBuffer::Reset()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry = FEntry();
+	}
+
+	Head = 0;
+	Count = 0;
+}
@@ -8,14 +8,16 @@
 #include "Abilities/GSCGameplayAbility.h"
 #include "UI/GSCUWDebugAbilityQueue.h"
 #include "GSCLog.h"
+#include "GSCStats.h"
 #include "Player/GSCHUD.h"
+#include "Subsystems/GSCComponentCacheSubsystem.h"
 
 // Sets default values for this component's properties
 UGSCAbilityQueueComponent::UGSCAbilityQueueComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// Ability queue state is entirely event driven (ability ended / failed, anim notifies), the debug widget refreshes
+	// itself from its own tick while displayed
+	PrimaryComponentTick.bCanEverTick = false;
 
 	// ...
 	SetIsReplicatedByDefault(true);
@@ -30,6 +32,37 @@ void UGSCAbilityQueueComponent::BeginPlay()
 	SetupOwner();
 }
 
+void UGSCAbilityQueueComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	QueuedAbilities.SetCapacity(AbilityQueueCapacity);
+
+	// Owner companion components changed, make sure we don't keep resolving to a previous one (or to none)
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+
+	INC_DWORD_STAT(STAT_GSC_CompanionComponents);
+	if (PrimaryComponentTick.bCanEverTick)
+	{
+		INC_DWORD_STAT(STAT_GSC_CompanionComponentTickFunctions);
+	}
+}
+
+void UGSCAbilityQueueComponent::OnUnregister()
+{
+	DEC_DWORD_STAT(STAT_GSC_CompanionComponents);
+	if (PrimaryComponentTick.bCanEverTick)
+	{
+		DEC_DWORD_STAT(STAT_GSC_CompanionComponentTickFunctions);
+	}
+
+	SetDebugWidget(nullptr);
+	ResetAbilityQueueState();
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+
+	Super::OnUnregister();
+}
+
 void UGSCAbilityQueueComponent::SetupOwner()
 {
 	if(!GetOwner())
@@ -78,7 +111,17 @@ void UGSCAbilityQueueComponent::UpdateAllowedAbilitiesForAbilityQueue(TArray<TSu
 		return;
 	}
 
-	QueuedAllowedAbilities = AllowedAbilities;
+	if (AllowedAbilities == QueuedAllowedAbilities)
+	{
+		return;
+	}
+
+	QueuedAllowedAbilities = MoveTemp(AllowedAbilities);
+	QueuedAllowedAbilityClasses.Reset();
+	for (const TSubclassOf<UGameplayAbility>& AllowedAbility : QueuedAllowedAbilities)
+	{
+		QueuedAllowedAbilityClasses.Add(AllowedAbility.Get());
+	}
 
 	// Notify Debug Widget if any is on screen
 	UpdateDebugWidgetAllowedAbilities();
@@ -91,6 +134,11 @@ void UGSCAbilityQueueComponent::SetAllowAllAbilitiesForAbilityQueue(const bool b
 		return;
 	}
 
+	if (bAllowAllAbilitiesForAbilityQueue == bAllowAllAbilities)
+	{
+		return;
+	}
+
 	bAllowAllAbilitiesForAbilityQueue = bAllowAllAbilities;
 
 	UpdateDebugWidgetAllowedAbilities();
@@ -106,9 +154,19 @@ bool UGSCAbilityQueueComponent::IsAllAbilitiesAllowedForAbilityQueue() const
     return bAllowAllAbilitiesForAbilityQueue;
 }
 
+bool UGSCAbilityQueueComponent::IsAbilityAllowedForAbilityQueue(const UGameplayAbility* Ability) const
+{
+	return Ability && (bAllowAllAbilitiesForAbilityQueue || QueuedAllowedAbilityClasses.Contains(Ability->GetClass()));
+}
+
 const UGameplayAbility* UGSCAbilityQueueComponent::GetCurrentQueuedAbility() const
 {
-	return QueuedAbility;
+	return QueuedAbilities.Peek(GetAbilityQueueTime(), AbilityQueueExpiryTime);
+}
+
+int32 UGSCAbilityQueueComponent::GetNumQueuedAbilities() const
+{
+	return QueuedAbilities.Num();
 }
 
 TArray<TSubclassOf<UGameplayAbility>> UGSCAbilityQueueComponent::GetQueuedAllowedAbilities() const
@@ -150,31 +208,32 @@ void UGSCAbilityQueueComponent::OnAbilityEnded(const UGameplayAbility* InAbility
 
 	if (bAbilityQueueEnabled)
 	{
-		if (QueuedAbility)
+		// Expired and no longer allowed activations are discarded on the way to the oldest one we can activate
+		const double Now = GetAbilityQueueTime();
+		const UGameplayAbility* AbilityToActivate = QueuedAbilities.Pop(Now, AbilityQueueExpiryTime, [this](const UGameplayAbility* QueuedAbility)
 		{
-			// Store queue ability in a local var, it is cleared in ResetAbilityQueueState
-			const UGameplayAbility* AbilityToActivate = QueuedAbility;
-			GSC_LOG(Log, TEXT("UGSCAbilityQueueComponent::OnAbilityEnded() has a queued input: %s [AbilityQueueSystem]"), *AbilityToActivate->GetName())
-			if (bAllowAllAbilitiesForAbilityQueue || QueuedAllowedAbilities.Contains(AbilityToActivate->GetClass()))
-			{
-				ResetAbilityQueueState();
+			const bool bAllowed = IsAbilityAllowedForAbilityQueue(QueuedAbility);
+			GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::OnAbilityEnded() has a queued input: %s, allowed: %d [AbilityQueueSystem]"), *QueuedAbility->GetName(), bAllowed ? 1 : -1)
+			return bAllowed;
+		});
 
-				GSC_LOG(Log, TEXT("UGSCAbilityQueueComponent::OnAbilityEnded() %s is within Allowed Abilties, try activate [AbilityQueueSystem]"), *AbilityToActivate->GetName())
-				if (OwnerAbilitySystemComponent)
-				{
-					OwnerAbilitySystemComponent->TryActivateAbilityByClass(AbilityToActivate->GetClass());
-				}
-			}
-			else
+		// Remaining valid activations are kept for the next ability end, minus those the window that just ended didn't allow
+		QueuedAbilities.RemoveInvalid(Now, AbilityQueueExpiryTime, [this](const UGameplayAbility* QueuedAbility)
+		{
+			return IsAbilityAllowedForAbilityQueue(QueuedAbility);
+		});
+
+		// Reset before activation, the activated ability might open the queue and set its own allowed abilities
+		ResetAllowedAbilities();
+
+		if (AbilityToActivate)
+		{
+			GSC_LOG(Log, TEXT("UGSCAbilityQueueComponent::OnAbilityEnded() %s is within Allowed Abilties, try activate [AbilityQueueSystem]"), *AbilityToActivate->GetName())
+			if (OwnerAbilitySystemComponent)
 			{
-				ResetAbilityQueueState();
-				GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::OnAbilityEnded() not allowed ability, do nothing: %s [AbilityQueueSystem]"), *AbilityToActivate->GetName())
+				OwnerAbilitySystemComponent->TryActivateAbilityByClass(AbilityToActivate->GetClass());
 			}
 		}
-		else
-		{
-			ResetAbilityQueueState();
-		}
 	}
 }
 
@@ -183,12 +242,11 @@ void UGSCAbilityQueueComponent::OnAbilityFailed(const UGameplayAbility* Ability,
 	GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::OnAbilityFailed() %s, Reason: %s"), *Ability->GetName(), *ReasonTags.ToStringSimple())
 	if (bAbilityQueueEnabled && bAbilityQueueOpened)
 	{
-		GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::OnAbilityFailed() Set QueuedAbility to %s"), *Ability->GetName())
-
 		// Only queue the ability if it's allowed (or AllowAllAbilities is turned on)
-		if (bAllowAllAbilitiesForAbilityQueue || QueuedAllowedAbilities.Contains(Ability->GetClass()))
+		if (IsAbilityAllowedForAbilityQueue(Ability))
 		{
-			QueuedAbility = Ability;
+			GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::OnAbilityFailed() Queue %s"), *Ability->GetName())
+			QueuedAbilities.Enqueue(Ability, GetAbilityQueueTime());
 		}
 	}
 }
@@ -216,12 +274,34 @@ UGSCUWDebugAbilityQueue* UGSCAbilityQueueComponent::GetDebugWidgetFromHUD()
 	return Cast<UGSCUWDebugAbilityQueue>(HUD->GetAbilityQueueWidget());
 }
 
+void UGSCAbilityQueueComponent::SetDebugWidget(UGSCUWDebugAbilityQueue* InDebugWidget)
+{
+	DebugWidget = InDebugWidget;
+}
+
+double UGSCAbilityQueueComponent::GetAbilityQueueTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.;
+}
+
 void UGSCAbilityQueueComponent::ResetAbilityQueueState()
 {
 	GSC_LOG(Verbose, TEXT("UGSCAbilityQueueComponent::ResetAbilityQueueState()"))
-	QueuedAbility = nullptr;
+	QueuedAbilities.Reset();
+	ResetAllowedAbilities();
+}
+
+void UGSCAbilityQueueComponent::ResetAllowedAbilities()
+{
+	if (!bAllowAllAbilitiesForAbilityQueue && QueuedAllowedAbilities.Num() == 0)
+	{
+		return;
+	}
+
 	bAllowAllAbilitiesForAbilityQueue = false;
-	QueuedAllowedAbilities.Empty();
+	QueuedAllowedAbilities.Reset();
+	QueuedAllowedAbilityClasses.Reset();
 
 	// Notify Debug Widget if any is on screen
 	UpdateDebugWidgetAllowedAbilities();
@@ -229,8 +309,8 @@ void UGSCAbilityQueueComponent::ResetAbilityQueueState()
 
 void UGSCAbilityQueueComponent::UpdateDebugWidgetAllowedAbilities()
 {
-	UGSCUWDebugAbilityQueue* DebugWidget = GetDebugWidgetFromHUD();
-	if (!DebugWidget)
+	// Only the registered widget (if any) displays this component state, no need to go through the HUD
+	if (!DebugWidget.IsValid())
 	{
 		return;
 	}
@@ -9,11 +9,73 @@
 #include "Components/GSCCoreComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Character.h"
+#include "TimerManager.h"
 #include "GSCLog.h"
+#include "GSCStats.h"
+#include "Subsystems/GSCComponentCacheSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combo State Serializations"), STAT_GSC_ComboStateSerializations, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combo Server RPCs"), STAT_GSC_ComboServerRPCs, STATGROUP_GASCompanion);
+
+namespace GSCComboState
+{
+	constexpr uint8 ComboWindowOpened = 1 << 0;
+	constexpr uint8 ShouldTriggerCombo = 1 << 1;
+	constexpr uint8 RequestTriggerCombo = 1 << 2;
+	constexpr uint8 NextComboAbilityActivated = 1 << 3;
+
+	constexpr uint8 ComboIndexShift = 4;
+
+	/** Highest combo index stored in the packed byte, that value means the actual index follows as a packed int */
+	constexpr uint32 MaxPackedComboIndex = 0xF;
+}
+
+bool FGSCComboState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 Packed = 0;
+	uint32 Index = FMath::Max(ComboIndex, 0);
+
+	if (Ar.IsSaving())
+	{
+		INC_DWORD_STAT(STAT_GSC_ComboStateSerializations);
+
+		Packed |= bComboWindowOpened ? GSCComboState::ComboWindowOpened : 0;
+		Packed |= bShouldTriggerCombo ? GSCComboState::ShouldTriggerCombo : 0;
+		Packed |= bRequestTriggerCombo ? GSCComboState::RequestTriggerCombo : 0;
+		Packed |= bNextComboAbilityActivated ? GSCComboState::NextComboAbilityActivated : 0;
+		Packed |= FMath::Min(Index, GSCComboState::MaxPackedComboIndex) << GSCComboState::ComboIndexShift;
+	}
+
+	Ar << Packed;
+
+	const uint32 PackedIndex = Packed >> GSCComboState::ComboIndexShift;
+	if (PackedIndex == GSCComboState::MaxPackedComboIndex)
+	{
+		Ar.SerializeIntPacked(Index);
+	}
+	else
+	{
+		Index = PackedIndex;
+	}
+
+	if (Ar.IsLoading())
+	{
+		bComboWindowOpened = (Packed & GSCComboState::ComboWindowOpened) != 0;
+		bShouldTriggerCombo = (Packed & GSCComboState::ShouldTriggerCombo) != 0;
+		bRequestTriggerCombo = (Packed & GSCComboState::RequestTriggerCombo) != 0;
+		bNextComboAbilityActivated = (Packed & GSCComboState::NextComboAbilityActivated) != 0;
+		ComboIndex = static_cast<int32>(Index);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
 
 UGSCComboManagerComponent::UGSCComboManagerComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Combo state is entirely event driven (input, anim notifies, replication), the debug widget refreshes itself from
+	// its own tick while displayed
+	PrimaryComponentTick.bCanEverTick = false;
 	SetIsReplicatedByDefault(true);
 
 
@@ -24,11 +86,36 @@ void UGSCComboManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimePrope
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSCComboManagerComponent, ComboIndex, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSCComboManagerComponent, bComboWindowOpened, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSCComboManagerComponent, bShouldTriggerCombo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSCComboManagerComponent, bRequestTriggerCombo, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSCComboManagerComponent, bNextComboAbilityActivated, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME(UGSCComboManagerComponent, ReplicatedComboState);
+}
+
+void UGSCComboManagerComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Combo state changes from many places (notifies, abilities, RPCs), pack it once here rather than on every change.
+	// Only sent when it differs from what was last replicated.
+	ReplicatedComboState = GetComboState();
+}
+
+FGSCComboState UGSCComboManagerComponent::GetComboState() const
+{
+	FGSCComboState State;
+	State.ComboIndex = ComboIndex;
+	State.bComboWindowOpened = bComboWindowOpened;
+	State.bShouldTriggerCombo = bShouldTriggerCombo;
+	State.bRequestTriggerCombo = bRequestTriggerCombo;
+	State.bNextComboAbilityActivated = bNextComboAbilityActivated;
+	return State;
+}
+
+void UGSCComboManagerComponent::OnRep_ComboState()
+{
+	ComboIndex = ReplicatedComboState.ComboIndex;
+	bComboWindowOpened = ReplicatedComboState.bComboWindowOpened;
+	bShouldTriggerCombo = ReplicatedComboState.bShouldTriggerCombo;
+	bRequestTriggerCombo = ReplicatedComboState.bRequestTriggerCombo;
+	bNextComboAbilityActivated = ReplicatedComboState.bNextComboAbilityActivated;
 }
 
 void UGSCComboManagerComponent::IncrementCombo()
@@ -70,6 +157,40 @@ void UGSCComboManagerComponent::SetComboIndex(const int32 InComboIndex)
 	}
 }
 
+void UGSCComboManagerComponent::OpenComboWindow(const bool bInEndCombo)
+{
+	bComboWindowOpened = true;
+	bComboWindowEnding = bInEndCombo;
+	TryTriggerCombo();
+}
+
+void UGSCComboManagerComponent::CloseComboWindow(const bool bInEndCombo)
+{
+	GSC_LOG(Verbose, TEXT("UGSCComboManagerComponent::CloseComboWindow() bNextComboAbilityActivated %s, bEndCombo %s (%s)"), bNextComboAbilityActivated ? TEXT("true") : TEXT("false"), bInEndCombo ? TEXT("true") : TEXT("false"), *GetNameSafe(GetOwner()))
+	if (!bNextComboAbilityActivated || bInEndCombo)
+	{
+		GSC_LOG(Verbose, TEXT("UGSCComboManagerComponent::CloseComboWindow() ResetCombo (%s)"), *GetNameSafe(GetOwner()))
+		ResetCombo();
+	}
+
+	bComboWindowOpened = false;
+	bComboWindowEnding = false;
+	bRequestTriggerCombo = false;
+	bShouldTriggerCombo = false;
+	bNextComboAbilityActivated = false;
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(TriggerComboRetryTimerHandle);
+	}
+}
+
+void UGSCComboManagerComponent::RequestTriggerCombo()
+{
+	bRequestTriggerCombo = true;
+	TryTriggerCombo();
+}
+
 bool UGSCComboManagerComponent::IsOwnerActorAuthoritative() const
 {
 	return !bCachedIsNetSimulated;
@@ -93,6 +214,28 @@ void UGSCComboManagerComponent::OnRegister()
 
 	// Cached off netrole to avoid constant checking on owning actor
 	CacheIsNetSimulated();
+
+	// Owner companion components changed, make sure we don't keep resolving to a previous one (or to none)
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+
+	INC_DWORD_STAT(STAT_GSC_CompanionComponents);
+	if (PrimaryComponentTick.bCanEverTick)
+	{
+		INC_DWORD_STAT(STAT_GSC_CompanionComponentTickFunctions);
+	}
+}
+
+void UGSCComboManagerComponent::OnUnregister()
+{
+	DEC_DWORD_STAT(STAT_GSC_CompanionComponents);
+	if (PrimaryComponentTick.bCanEverTick)
+	{
+		DEC_DWORD_STAT(STAT_GSC_CompanionComponentTickFunctions);
+	}
+
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+
+	Super::OnUnregister();
 }
 
 void UGSCComboManagerComponent::SetupOwner()
@@ -126,8 +269,7 @@ UGameplayAbility* UGSCComboManagerComponent::GetCurrentActiveComboAbility()
 		return nullptr;
 	}
 
-	TArray<UGameplayAbility*> Abilities = OwnerCoreComponent->GetActiveAbilitiesByClass(MeleeBaseAbility);
-	return Abilities.IsValidIndex(0) ? Abilities[0] : nullptr;
+	return OwnerCoreComponent->FindFirstActiveAbilityByClass(MeleeBaseAbility);
 }
 
 void UGSCComboManagerComponent::ActivateComboAbilityInternal(const TSubclassOf<UGSCGameplayAbility> AbilityClass, const bool bAllowRemoteActivation)
@@ -161,6 +303,7 @@ void UGSCComboManagerComponent::ActivateComboAbilityInternal(const TSubclassOf<U
 			bComboWindowOpened ? TEXT("true") : TEXT("false")
 		)
 		bShouldTriggerCombo = bComboWindowOpened;
+		TryTriggerCombo();
 	}
 	else
 	{
@@ -170,33 +313,58 @@ void UGSCComboManagerComponent::ActivateComboAbilityInternal(const TSubclassOf<U
     }
 }
 
-void UGSCComboManagerComponent::CacheIsNetSimulated()
+void UGSCComboManagerComponent::TryTriggerCombo()
 {
-	bCachedIsNetSimulated = IsNetSimulating();
-}
+	// Combo is triggered on server only, clients get the resulting combo state through ReplicatedComboState
+	if (!IsOwnerActorAuthoritative())
+	{
+		return;
+	}
 
-void UGSCComboManagerComponent::ServerSetComboIndex_Implementation(const int32 InComboIndex)
-{
-	MulticastSetComboIndex(InComboIndex);
-}
+	// prevent reactivate of ability in this combo window (especially on networked environment with some lags)
+	if (!bComboWindowOpened || !bShouldTriggerCombo || !bRequestTriggerCombo || bComboWindowEnding || bNextComboAbilityActivated)
+	{
+		return;
+	}
 
-void UGSCComboManagerComponent::MulticastSetComboIndex_Implementation(const int32 InComboIndex)
-{
-	if (OwningCharacter && !OwningCharacter->IsLocallyControlled())
+	if (!OwnerCoreComponent)
 	{
-		ComboIndex = InComboIndex;
+		return;
+	}
+
+	UGameplayAbility* ComboAbility = GetCurrentActiveComboAbility();
+	if (!ComboAbility)
+	{
+		return;
+	}
+
+	UGSCGameplayAbility* ActivatedAbility;
+	if (OwnerCoreComponent->ActivateAbilityByClass(ComboAbility->GetClass(), ActivatedAbility))
+	{
+		bNextComboAbilityActivated = true;
+		return;
+	}
+
+	GSC_LOG(Verbose, TEXT("UGSCComboManagerComponent::TryTriggerCombo() Ability %s didn't activate, retry on next frame"), *ComboAbility->GetClass()->GetName())
+	if (UWorld* World = GetWorld())
+	{
+		TriggerComboRetryTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &UGSCComboManagerComponent::TryTriggerCombo);
 	}
 }
 
-void UGSCComboManagerComponent::MulticastActivateComboAbility_Implementation(const TSubclassOf<UGSCGameplayAbility> AbilityClass, const bool bAllowRemoteActivation)
+void UGSCComboManagerComponent::CacheIsNetSimulated()
 {
-    if (OwningCharacter && !OwningCharacter->IsLocallyControlled())
-    {
-        ActivateComboAbilityInternal(AbilityClass, bAllowRemoteActivation);
-    }
+	bCachedIsNetSimulated = IsNetSimulating();
+}
+
+void UGSCComboManagerComponent::ServerSetComboIndex_Implementation(const int32 InComboIndex)
+{
+	INC_DWORD_STAT(STAT_GSC_ComboServerRPCs);
+	ComboIndex = InComboIndex;
 }
 
 void UGSCComboManagerComponent::ServerActivateComboAbility_Implementation(const TSubclassOf<UGSCGameplayAbility> AbilityClass, const bool bAllowRemoteActivation)
 {
-    MulticastActivateComboAbility(AbilityClass, bAllowRemoteActivation);
+	INC_DWORD_STAT(STAT_GSC_ComboServerRPCs);
+	ActivateComboAbilityInternal(AbilityClass, bAllowRemoteActivation);
 }
@@ -6,14 +6,18 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemInterface.h"
+#include "Abilities/GSCCooldownTracker.h"
 #include "Abilities/GSCGameplayAbility.h"
 #include "Abilities/Attributes/GSCAttributeSet.h"
 #include "Core/Settings/GSCDeveloperSettings.h"
+#include "Core/Interfaces/GSCAbilitySpecIndexInterface.h"
 #include "Core/Interfaces/GSCCompanionInterface.h"
 #include "Actors/Characters/GSCPlayerCharacter.h"
 #include "GameFramework/Character.h"
 #include "Player/GSCPlayerController.h"
 #include "GSCLog.h"
+#include "Subsystems/GSCComponentCacheSubsystem.h"
+#include "Subsystems/GSCCooldownSubsystem.h"
 
 // Sets default values for this component's properties
 UGSCCoreComponent::UGSCCoreComponent()
@@ -33,6 +37,21 @@ void UGSCCoreComponent::BeginPlay()
 	SetupOwner();
 }
 
+void UGSCCoreComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Owner companion components changed, make sure we don't keep resolving to a previous one (or to none)
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+}
+
+void UGSCCoreComponent::OnUnregister()
+{
+	UGSCComponentCacheSubsystem::InvalidateComponentOwner(this);
+
+	Super::OnUnregister();
+}
+
 void UGSCCoreComponent::BeginDestroy()
 {
 	// Clean up any bound delegates when component is destroyed
@@ -124,6 +143,15 @@ void UGSCCoreComponent::RegisterAbilitySystemDelegates(UAbilitySystemComponent*
 
 	// Handle Ability Commit events
 	ASC->AbilityCommittedCallbacks.AddUObject(this, &UGSCCoreComponent::OnAbilityCommitted);
+
+	// Handle Cooldowns, through the ASC shared tracker
+	CooldownTracker = UGSCCooldownSubsystem::GetCooldownTracker(ASC);
+	if (CooldownTracker.IsValid())
+	{
+		CooldownTracker->OnCooldownStart.AddUObject(this, &UGSCCoreComponent::OnTrackedCooldownStart);
+		CooldownTracker->OnCooldownChanged.AddUObject(this, &UGSCCoreComponent::OnTrackedCooldownChanged);
+		CooldownTracker->OnCooldownEnd.AddUObject(this, &UGSCCoreComponent::OnTrackedCooldownEnd);
+	}
 }
 
 void UGSCCoreComponent::ShutdownAbilitySystemDelegates(UAbilitySystemComponent* ASC)
@@ -166,9 +194,12 @@ void UGSCCoreComponent::ShutdownAbilitySystemDelegates(UAbilitySystemComponent*
 		}
 	}
 
-	for (const FGameplayTag GameplayTagBoundToDelegate : GameplayTagBoundToDelegates)
+	if (CooldownTracker.IsValid())
 	{
-		ASC->RegisterGameplayTagEvent(GameplayTagBoundToDelegate).RemoveAll(this);
+		CooldownTracker->OnCooldownStart.RemoveAll(this);
+		CooldownTracker->OnCooldownChanged.RemoveAll(this);
+		CooldownTracker->OnCooldownEnd.RemoveAll(this);
+		CooldownTracker.Reset();
 	}
 }
 
@@ -438,7 +469,7 @@ bool UGSCCoreComponent::IsUsingAbilityByClass(const TSubclassOf<UGameplayAbility
 		return false;
 	}
 
-	return GetActiveAbilitiesByClass(AbilityClass).Num() > 0;
+	return HasActiveAbilityOfClass(AbilityClass);
 }
 
 bool UGSCCoreComponent::IsUsingAbilityByTags(const FGameplayTagContainer AbilityTags)
@@ -449,7 +480,12 @@ bool UGSCCoreComponent::IsUsingAbilityByTags(const FGameplayTagContainer Ability
 		return false;
 	}
 
-	return GetActiveAbilitiesByTags(AbilityTags).Num() > 0;
+	return FindFirstActiveAbilityByTags(AbilityTags) != nullptr;
+}
+
+bool UGSCCoreComponent::HasActiveAbilityOfClass(const TSubclassOf<UGameplayAbility> AbilityClass) const
+{
+	return FindFirstActiveAbilityByClass(AbilityClass) != nullptr;
 }
 
 TArray<UGameplayAbility*> UGSCCoreComponent::GetActiveAbilitiesByClass(TSubclassOf<UGameplayAbility> AbilityToSearch) const
@@ -460,65 +496,145 @@ TArray<UGameplayAbility*> UGSCCoreComponent::GetActiveAbilitiesByClass(TSubclass
 		return {};
 	}
 
-	TArray<FGameplayAbilitySpec> Specs = OwnerAbilitySystemComponent->GetActivatableAbilities();
-	TArray<struct FGameplayAbilitySpec*> MatchingGameplayAbilities;
 	TArray<UGameplayAbility*> ActiveAbilities;
+	ForEachActiveAbilityByClass(AbilityToSearch, [&ActiveAbilities](UGameplayAbility* ActiveAbility)
+	{
+		ActiveAbilities.Add(ActiveAbility);
+		return true;
+	});
+
+	return ActiveAbilities;
+}
+
+TArray<UGameplayAbility*> UGSCCoreComponent::GetActiveAbilitiesByTags(const FGameplayTagContainer GameplayTagContainer) const
+{
+	if (!OwnerAbilitySystemComponent)
+	{
+		GSC_LOG(Error, TEXT("UGSCCoreComponent::GetActiveAbilitiesByClass() ASC is not valid"))
+		return {};
+	}
+
+	TArray<UGameplayAbility*> ActiveAbilities;
+	ForEachActiveAbilityByTags(GameplayTagContainer, [&ActiveAbilities](UGameplayAbility* ActiveAbility)
+	{
+		ActiveAbilities.Add(ActiveAbility);
+		return true;
+	});
+
+	return ActiveAbilities;
+}
+
+void UGSCCoreComponent::ForEachActiveAbilityByClass(const TSubclassOf<UGameplayAbility> AbilityToSearch, const TFunctionRef<bool(UGameplayAbility*)> Visitor) const
+{
+	if (!AbilityToSearch)
+	{
+		return;
+	}
 
-	// First, search for matching Abilities for this class
-	for (const FGameplayAbilitySpec& Spec : Specs)
+	// Only visit the specs granted for this class if the ASC maintains an index of them
+	if (IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(OwnerAbilitySystemComponent))
 	{
-		if (Spec.Ability && Spec.Ability->GetClass()->IsChildOf(AbilityToSearch))
+		SpecIndex->ForEachIndexedAbilitySpecByClass(AbilityToSearch, [&Visitor](const FGameplayAbilitySpec& Spec)
 		{
-			MatchingGameplayAbilities.Add(const_cast<FGameplayAbilitySpec*>(&Spec));
-		}
+			return VisitActiveAbilityInstances(Spec, Visitor);
+		});
+		return;
 	}
 
-	// Iterate the list of all ability specs
-	for (const FGameplayAbilitySpec* Spec : MatchingGameplayAbilities)
+	ForEachActiveAbility([AbilityToSearch](const FGameplayAbilitySpec& Spec)
 	{
-		// Iterate all instances on this ability spec, which can include instance per execution abilities
-		TArray<UGameplayAbility*> AbilityInstances = Spec->GetAbilityInstances();
+		return Spec.Ability && Spec.Ability->GetClass()->IsChildOf(AbilityToSearch);
+	}, Visitor);
+}
+
+void UGSCCoreComponent::ForEachActiveAbilityByTags(const FGameplayTagContainer& GameplayTagContainer, const TFunctionRef<bool(UGameplayAbility*)> Visitor) const
+{
+	// Like ASC GetActivatableGameplayAbilitySpecsByAllMatchingTags(), an empty container matches nothing
+	if (GameplayTagContainer.IsEmpty())
+	{
+		return;
+	}
 
-		for (UGameplayAbility* ActiveAbility : AbilityInstances)
+	if (IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(OwnerAbilitySystemComponent))
+	{
+		SpecIndex->ForEachIndexedAbilitySpecByTags(GameplayTagContainer, [&Visitor](const FGameplayAbilitySpec& Spec)
 		{
-			if (ActiveAbility->IsActive())
-			{
-				ActiveAbilities.Add(ActiveAbility);
-			}
-		}
+			return VisitActiveAbilityInstances(Spec, Visitor);
+		});
+		return;
 	}
 
-	return ActiveAbilities;
+	// Ability tags must contain every tag of the container, without requiring tag requirements to be satisfied
+	ForEachActiveAbility([&GameplayTagContainer](const FGameplayAbilitySpec& Spec)
+	{
+		return Spec.Ability && Spec.Ability->AbilityTags.HasAll(GameplayTagContainer);
+	}, Visitor);
 }
 
-TArray<UGameplayAbility*> UGSCCoreComponent::GetActiveAbilitiesByTags(const FGameplayTagContainer GameplayTagContainer) const
+UGameplayAbility* UGSCCoreComponent::FindFirstActiveAbilityByClass(const TSubclassOf<UGameplayAbility> AbilityToSearch) const
+{
+	UGameplayAbility* FoundAbility = nullptr;
+	ForEachActiveAbilityByClass(AbilityToSearch, [&FoundAbility](UGameplayAbility* ActiveAbility)
+	{
+		FoundAbility = ActiveAbility;
+		return false;
+	});
+
+	return FoundAbility;
+}
+
+UGameplayAbility* UGSCCoreComponent::FindFirstActiveAbilityByTags(const FGameplayTagContainer& GameplayTagContainer) const
+{
+	UGameplayAbility* FoundAbility = nullptr;
+	ForEachActiveAbilityByTags(GameplayTagContainer, [&FoundAbility](UGameplayAbility* ActiveAbility)
+	{
+		FoundAbility = ActiveAbility;
+		return false;
+	});
+
+	return FoundAbility;
+}
+
+void UGSCCoreComponent::ForEachActiveAbility(const TFunctionRef<bool(const FGameplayAbilitySpec&)> SpecFilter, const TFunctionRef<bool(UGameplayAbility*)> Visitor) const
 {
 	if (!OwnerAbilitySystemComponent)
 	{
-		GSC_LOG(Error, TEXT("UGSCCoreComponent::GetActiveAbilitiesByClass() ASC is not valid"))
-		return {};
+		return;
 	}
 
-	TArray<UGameplayAbility*> ActiveAbilities;
-	TArray<FGameplayAbilitySpec*> MatchingGameplayAbilities;
-	OwnerAbilitySystemComponent->GetActivatableGameplayAbilitySpecsByAllMatchingTags(GameplayTagContainer, MatchingGameplayAbilities, false);
+	// Prevent the spec list from being modified underneath us, in case Visitor ends up giving or clearing abilities
+	FScopedAbilityListLock ActiveScopeLock(*OwnerAbilitySystemComponent);
+
+	for (const FGameplayAbilitySpec& Spec : OwnerAbilitySystemComponent->GetActivatableAbilities())
+	{
+		if (SpecFilter(Spec) && !VisitActiveAbilityInstances(Spec, Visitor))
+		{
+			return;
+		}
+	}
+}
 
-	// Iterate the list of all ability specs
-	for (const FGameplayAbilitySpec* Spec : MatchingGameplayAbilities)
+bool UGSCCoreComponent::VisitActiveAbilityInstances(const FGameplayAbilitySpec& Spec, const TFunctionRef<bool(UGameplayAbility*)> Visitor)
+{
+	// Iterate all instances on this ability spec, which can include instance per execution abilities.
+	// Instance arrays are walked directly rather than through GetAbilityInstances() which returns a new array.
+	for (UGameplayAbility* ActiveAbility : Spec.ReplicatedInstances)
 	{
-		// Iterate all instances on this ability spec
-		TArray<UGameplayAbility*> AbilityInstances = Spec->GetAbilityInstances();
+		if (ActiveAbility && ActiveAbility->IsActive() && !Visitor(ActiveAbility))
+		{
+			return false;
+		}
+	}
 
-		for (UGameplayAbility* ActiveAbility : AbilityInstances)
+	for (UGameplayAbility* ActiveAbility : Spec.NonReplicatedInstances)
+	{
+		if (ActiveAbility && ActiveAbility->IsActive() && !Visitor(ActiveAbility))
 		{
-			if (ActiveAbility->IsActive())
-			{
-				ActiveAbilities.Add(ActiveAbility);
-			}
+			return false;
 		}
 	}
 
-	return ActiveAbilities;;
+	return true;
 }
 
 bool UGSCCoreComponent::ActivateAbilityByClass(const TSubclassOf<UGameplayAbility> AbilityClass, UGSCGameplayAbility*& ActivatedAbility, const bool bAllowRemoteActivation)
@@ -528,17 +644,27 @@ bool UGSCCoreComponent::ActivateAbilityByClass(const TSubclassOf<UGameplayAbilit
 		return false;
 	}
 
-	const bool bSuccess = OwnerAbilitySystemComponent->TryActivateAbilityByClass(AbilityClass, bAllowRemoteActivation);
+	bool bSuccess = false;
+	if (IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(OwnerAbilitySystemComponent))
+	{
+		// Same as TryActivateAbilityByClass(), without scanning every activatable abilities to find the spec
+		const FGameplayAbilitySpec* Spec = SpecIndex->FindIndexedAbilitySpecFromClass(AbilityClass);
+		bSuccess = Spec && OwnerAbilitySystemComponent->TryActivateAbility(Spec->Handle, bAllowRemoteActivation);
+	}
+	else
+	{
+		bSuccess = OwnerAbilitySystemComponent->TryActivateAbilityByClass(AbilityClass, bAllowRemoteActivation);
+	}
 
-	TArray<UGameplayAbility*> ActiveAbilities = GetActiveAbilitiesByClass(AbilityClass);
-	if (ActiveAbilities.Num() == 0)
+	UGameplayAbility* ActiveAbility = FindFirstActiveAbilityByClass(AbilityClass);
+	if (!ActiveAbility)
 	{
 		GSC_LOG(Warning, TEXT("UGSCCoreComponent::ActivateAbilityByClass Couldn't get back active abilities with Class %s"), *AbilityClass->GetName());
 	}
 
-	if (bSuccess && ActiveAbilities.Num() > 0)
+	if (bSuccess && ActiveAbility)
 	{
-		UGSCGameplayAbility* GSCAbility = Cast<UGSCGameplayAbility>(ActiveAbilities[0]);
+		UGSCGameplayAbility* GSCAbility = Cast<UGSCGameplayAbility>(ActiveAbility);
 		if (GSCAbility)
 		{
 			ActivatedAbility = GSCAbility;
@@ -556,7 +682,21 @@ bool UGSCCoreComponent::ActivateAbilityByTags(const FGameplayTagContainer Abilit
 	}
 
 	TArray<FGameplayAbilitySpec*> AbilitiesToActivate;
-	OwnerAbilitySystemComponent->GetActivatableGameplayAbilitySpecsByAllMatchingTags(AbilityTags, AbilitiesToActivate);
+	if (IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(OwnerAbilitySystemComponent))
+	{
+		SpecIndex->ForEachIndexedAbilitySpecByTags(AbilityTags, [this, &AbilitiesToActivate](FGameplayAbilitySpec& Spec)
+		{
+			if (Spec.Ability->DoesAbilitySatisfyTagRequirements(*OwnerAbilitySystemComponent))
+			{
+				AbilitiesToActivate.Add(&Spec);
+			}
+			return true;
+		});
+	}
+	else
+	{
+		OwnerAbilitySystemComponent->GetActivatableGameplayAbilitySpecsByAllMatchingTags(AbilityTags, AbilitiesToActivate);
+	}
 
 	const uint32 Count = AbilitiesToActivate.Num();
 
@@ -571,15 +711,15 @@ bool UGSCCoreComponent::ActivateAbilityByTags(const FGameplayTagContainer Abilit
 	// actually trigger the ability
 	const bool bSuccess = OwnerAbilitySystemComponent->TryActivateAbility(Spec->Handle, bAllowRemoteActivation);
 
-	TArray<UGameplayAbility*> ActiveAbilities = GetActiveAbilitiesByTags(AbilityTags);
-	if (ActiveAbilities.Num() == 0)
+	UGameplayAbility* ActiveAbility = FindFirstActiveAbilityByTags(AbilityTags);
+	if (!ActiveAbility)
 	{
 		GSC_LOG(Warning, TEXT("UGSCCoreComponent::ActivateAbilityByTags Couldn't get back active abilities with tags %s"), *AbilityTags.ToStringSimple());
 	}
 
-	if (bSuccess && ActiveAbilities.Num() > 0)
+	if (bSuccess && ActiveAbility)
 	{
-		UGSCGameplayAbility* GSCAbility = Cast<UGSCGameplayAbility>(ActiveAbilities[0]);
+		UGSCGameplayAbility* GSCAbility = Cast<UGSCGameplayAbility>(ActiveAbility);
 		if (GSCAbility)
 		{
 			ActivatedAbility = GSCAbility;
@@ -884,8 +1024,21 @@ void UGSCCoreComponent::OnAbilityCommitted(UGameplayAbility* ActivatedAbility)
 
 	// Trigger AbilityCommit event
 	OnAbilityCommit.Broadcast(ActivatedAbility);
+}
 
-	HandleCooldownOnAbilityCommit(ActivatedAbility);
+void UGSCCoreComponent::OnTrackedCooldownStart(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, const float TimeRemaining, const float Duration)
+{
+	OnCooldownStart.Broadcast(Ability, CooldownTags, TimeRemaining, Duration);
+}
+
+void UGSCCoreComponent::OnTrackedCooldownChanged(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, const float TimeRemaining, const float Duration)
+{
+	OnCooldownChanged.Broadcast(Ability, CooldownTags, TimeRemaining, Duration);
+}
+
+void UGSCCoreComponent::OnTrackedCooldownEnd(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTag& CooldownTag, const float Duration)
+{
+	OnCooldownGameplayTagChanged(CooldownTag, 0, AbilitySpecHandle, Duration);
 }
 
 void UGSCCoreComponent::OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, const int32 NewCount, const FGameplayAbilitySpecHandle AbilitySpecHandle, const float Duration)
@@ -914,60 +1067,29 @@ void UGSCCoreComponent::OnCooldownGameplayTagChanged(const FGameplayTag Gameplay
 	{
 		OnCooldownEnd.Broadcast(Ability, GameplayTag, Duration);
 	}
-
-	OwnerAbilitySystemComponent->RegisterGameplayTagEvent(GameplayTag, EGameplayTagEventType::NewOrRemoved).RemoveAll(this);
 }
 
 void UGSCCoreComponent::HandleCooldownOnAbilityCommit(UGameplayAbility* ActivatedAbility)
 {
-	if (!OwnerAbilitySystemComponent)
-	{
-		return;
-	}
-
 	if (!IsValid(ActivatedAbility))
 	{
 		GSC_LOG(Warning, TEXT("UGSCCoreComponent::HandleCooldownOnAbilityCommit() Activated ability not valid"))
 		return;
 	}
 
-	// Figure out cooldown
-	UGameplayEffect* CooldownGE = ActivatedAbility->GetCooldownGameplayEffect();
-	if (!CooldownGE)
-	{
-		return;
-	}
-
-	if (!ActivatedAbility->IsInstantiated())
-	{
-		return;
-	}
-
 	const FGameplayTagContainer* CooldownTags = ActivatedAbility->GetCooldownTags();
-	if (!CooldownTags || CooldownTags->Num() <= 0)
+	if (!ActivatedAbility->GetCooldownGameplayEffect() || !ActivatedAbility->IsInstantiated() || !CooldownTags || CooldownTags->Num() <= 0)
 	{
 		return;
 	}
 
-	FGameplayAbilityActorInfo ActorInfo = ActivatedAbility->GetActorInfo();
-	const FGameplayAbilitySpecHandle AbilitySpecHandle = ActivatedAbility->GetCurrentAbilitySpecHandle();
+	const FGameplayAbilityActorInfo ActorInfo = ActivatedAbility->GetActorInfo();
 
 	float TimeRemaining = 0.f;
 	float Duration = 0.f;
-	ActivatedAbility->GetCooldownTimeRemainingAndDuration(AbilitySpecHandle, &ActorInfo, TimeRemaining, Duration);
+	ActivatedAbility->GetCooldownTimeRemainingAndDuration(ActivatedAbility->GetCurrentAbilitySpecHandle(), &ActorInfo, TimeRemaining, Duration);
 
 	OnCooldownStart.Broadcast(ActivatedAbility, *CooldownTags, TimeRemaining, Duration);
-
-	// Register delegate to monitor any change to cooldown gameplay tag to be able to figure out when a cooldown expires
-	TArray<FGameplayTag> GameplayTags;
-	CooldownTags->GetGameplayTagArray(GameplayTags);
-	for (const FGameplayTag GameplayTag : GameplayTags)
-	{
-		OwnerAbilitySystemComponent->RegisterGameplayTagEvent(GameplayTag)
-			.AddUObject(this, &UGSCCoreComponent::OnCooldownGameplayTagChanged, AbilitySpecHandle, Duration);
-
-		GameplayTagBoundToDelegates.AddUnique(GameplayTag);
-	}
 }
 
 UGSCUWHud* UGSCCoreComponent::GetHUDWidget() const
@@ -0,0 +1,109 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Core/GSCAllocationCounter.h"
+
+#if GSC_WITH_ALLOCATION_COUNTER
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+namespace GSCAllocationCounter
+{
+	/** Forwards everything to the allocator it wraps, counting allocations made by a single thread */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* InnerMalloc = nullptr;
+		volatile uint32 CountingThreadId = 0;
+		int32 NumAllocations = 0;
+
+		virtual void* Malloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+		virtual SIZE_T QuantizeSize(const SIZE_T Count, const uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(const bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { InnerMalloc->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { InnerMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { InnerMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { InnerMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return InnerMalloc->GetDescriptiveName(); }
+		virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override { return InnerMalloc->Exec(InWorld, Cmd, Ar); }
+
+	private:
+		FORCEINLINE void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == CountingThreadId)
+			{
+				++NumAllocations;
+			}
+		}
+	};
+
+	/** Never destroyed, other threads might still be calling into it right after a scope restored GMalloc */
+	static FCountingMalloc& Get()
+	{
+		static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+		return *CountingMalloc;
+	}
+}
+
+FGSCScopedAllocationCounter::FGSCScopedAllocationCounter()
+{
+	GSCAllocationCounter::FCountingMalloc& CountingMalloc = GSCAllocationCounter::Get();
+	check(GMalloc != &CountingMalloc);
+
+	CountingMalloc.InnerMalloc = GMalloc;
+	CountingMalloc.NumAllocations = 0;
+	CountingMalloc.CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+	FPlatformMisc::MemoryBarrier();
+	GMalloc = &CountingMalloc;
+}
+
+FGSCScopedAllocationCounter::~FGSCScopedAllocationCounter()
+{
+	GSCAllocationCounter::FCountingMalloc& CountingMalloc = GSCAllocationCounter::Get();
+	GMalloc = CountingMalloc.InnerMalloc;
+	CountingMalloc.CountingThreadId = 0;
+	FPlatformMisc::MemoryBarrier();
+}
+
+int32 FGSCScopedAllocationCounter::GetNumAllocations() const
+{
+	return GSCAllocationCounter::Get().NumAllocations;
+}
+
+#endif
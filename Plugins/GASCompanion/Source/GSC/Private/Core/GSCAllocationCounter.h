@@ -0,0 +1,32 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Not available on platforms where GMalloc is a fixed class called directly (no virtual dispatch to wrap)
+#define GSC_WITH_ALLOCATION_COUNTER (!UE_BUILD_SHIPPING && !PLATFORM_USES_FIXED_GMalloc_CLASS)
+
+#if GSC_WITH_ALLOCATION_COUNTER
+
+/**
+ * Counts heap allocations made by the calling thread while in scope: every Malloc, and every Realloc to a non zero size.
+ *
+ * GMalloc is wrapped by a forwarding allocator for the lifetime of the scope, allocations made by other threads go through
+ * it but are not counted. For benchmarks and automation tests only, scopes can't be nested.
+ */
+class FGSCScopedAllocationCounter
+{
+public:
+	FGSCScopedAllocationCounter();
+	~FGSCScopedAllocationCounter();
+
+	/** Number of allocations made by this thread since the scope was entered */
+	int32 GetNumAllocations() const;
+
+private:
+	FGSCScopedAllocationCounter(const FGSCScopedAllocationCounter&) = delete;
+	FGSCScopedAllocationCounter& operator=(const FGSCScopedAllocationCounter&) = delete;
+};
+
+#endif
@@ -2,10 +2,31 @@
 
 
 #include "Core/GSCCheatManager.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "Abilities/Attributes/GSCAttributeSet.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Abilities/GSCGameplayAbility.h"
+#include "Abilities/GSCTypes.h"
+#include "Abilities/TargetTypes/GSCTargetTypeBox.h"
+#include "Abilities/TargetTypes/GSCTargetTypeCapsule.h"
+#include "Abilities/TargetTypes/GSCTargetTypeCone.h"
+#include "Abilities/TargetTypes/GSCTargetTypeSphere.h"
 #include "Blueprint/UserWidget.h"
+#include "Components/SphereComponent.h"
+#include "Core/GSCAllocationCounter.h"
+#include "Engine/CollisionProfile.h"
+#include "GameplayEffect.h"
 #include "Actors/Characters/GSCCharacterBase.h"
+#include "Actors/Projectiles/GSCProjectileBase.h"
+#include "Components/GSCComboManagerComponent.h"
 #include "Player/GSCHUD.h"
 #include "GSCLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/BitWriter.h"
+#include "Subsystems/GSCCooldownSubsystem.h"
+#include "Subsystems/GSCProjectilePoolSubsystem.h"
+#include "Subsystems/GSCSignificanceSubsystem.h"
 
 void UGSCCheatManager::GSC_AbilityQueueDebug()
 {
@@ -74,6 +95,655 @@ void UGSCCheatManager::GSC_OpenComboDebug()
 	}
 }
 
+void UGSCCheatManager::GSC_BenchmarkComboReplication(const int32 NumSwings, const int32 NumConnections) const
+{
+	if (NumSwings <= 0 || NumConnections <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkComboReplication() Invalid parameters"))
+		return;
+	}
+
+	// Combo state as seen by each net update of a combo chain: window opens, player queues up the next combo, trigger
+	// notify activates it (incrementing the combo index), window closes. Last swing window closes without input.
+	TArray<FGSCComboState> States;
+	States.AddDefaulted();
+	for (int32 Swing = 0; Swing < NumSwings; ++Swing)
+	{
+		FGSCComboState State = States.Last();
+		State.bComboWindowOpened = true;
+		States.Add(State);
+
+		if (Swing < NumSwings - 1)
+		{
+			State.bShouldTriggerCombo = true;
+			States.Add(State);
+
+			State.bRequestTriggerCombo = true;
+			State.bNextComboAbilityActivated = true;
+			State.ComboIndex++;
+			States.Add(State);
+		}
+		else
+		{
+			State.ComboIndex = 0;
+		}
+
+		State.bComboWindowOpened = false;
+		State.bShouldTriggerCombo = false;
+		State.bRequestTriggerCombo = false;
+		State.bNextComboAbilityActivated = false;
+		States.Add(State);
+	}
+
+	// Property handles are sent packed ahead of each changed property, any handle below 128 takes a byte
+	uint32 PropertyHandle = 1;
+
+	FBitWriter LegacyWriter(0, true);
+	FBitWriter PackedWriter(0, true);
+	for (int32 Index = 1; Index < States.Num(); ++Index)
+	{
+		const FGSCComboState& Previous = States[Index - 1];
+		FGSCComboState Current = States[Index];
+
+		// Previous layout, one property per member
+		auto WriteLegacyBool = [&LegacyWriter, &PropertyHandle](const bool bPrevious, const bool bCurrent)
+		{
+			if (bPrevious != bCurrent)
+			{
+				LegacyWriter.SerializeIntPacked(PropertyHandle);
+				LegacyWriter.WriteBit(bCurrent);
+			}
+		};
+
+		if (Previous.ComboIndex != Current.ComboIndex)
+		{
+			LegacyWriter.SerializeIntPacked(PropertyHandle);
+			LegacyWriter << Current.ComboIndex;
+		}
+		WriteLegacyBool(Previous.bComboWindowOpened, Current.bComboWindowOpened);
+		WriteLegacyBool(Previous.bShouldTriggerCombo, Current.bShouldTriggerCombo);
+		WriteLegacyBool(Previous.bRequestTriggerCombo, Current.bRequestTriggerCombo);
+		WriteLegacyBool(Previous.bNextComboAbilityActivated, Current.bNextComboAbilityActivated);
+
+		// Packed state, a single property
+		bool bSuccess = false;
+		PackedWriter.SerializeIntPacked(PropertyHandle);
+		Current.NetSerialize(PackedWriter, nullptr, bSuccess);
+	}
+
+	const float LegacyBytesPerSwing = LegacyWriter.GetNumBits() / 8.f / NumSwings;
+	const float PackedBytesPerSwing = PackedWriter.GetNumBits() / 8.f / NumSwings;
+
+	// Previously, every swing from a remote client was a reliable Server RPC followed by a reliable multicast to every
+	// relevant connection. Now a single reliable Server RPC.
+	const int32 LegacyRPCsPerSwing = 1 + NumConnections;
+	const int32 PackedRPCsPerSwing = 1;
+
+	GSC_LOG(
+		Display,
+		TEXT("UGSCCheatManager:GSC_BenchmarkComboReplication() %d swings, %d state updates - Combo state per swing and connection: %.2f bytes before, %.2f bytes after. RPCs per swing: %d before, %d after (reliable)"),
+		NumSwings,
+		States.Num() - 1,
+		LegacyBytesPerSwing,
+		PackedBytesPerSwing,
+		LegacyRPCsPerSwing,
+		PackedRPCsPerSwing
+	)
+}
+
+void UGSCCheatManager::GSC_BenchmarkProjectilePool(const int32 NumProjectiles, const int32 InFlight) const
+{
+	UWorld* World = GetWorld();
+	UGSCProjectilePoolSubsystem* ProjectilePool = UGSCProjectilePoolSubsystem::Get(World);
+	if (!World || !ProjectilePool || NumProjectiles <= 0 || InFlight <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkProjectilePool() Invalid World or parameters"))
+		return;
+	}
+
+	// Far from any geometry, projectiles don't get to move (or hit anything) before being destroyed / released
+	const FTransform SpawnTransform(FVector(0.f, 0.f, 100000.f));
+	const TSubclassOf<AGSCProjectileBase> ProjectileClass = AGSCProjectileBase::StaticClass();
+
+	TArray<AGSCProjectileBase*> Projectiles;
+	Projectiles.Reserve(InFlight);
+
+	auto TimeGarbageCollection = []()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		return (FPlatformTime::Seconds() - StartTime) * 1000.;
+	};
+
+	// Without pool
+	TimeGarbageCollection();
+	uint64 SpawnCycles = 0;
+	uint64 DestroyCycles = 0;
+	for (int32 Fired = 0; Fired < NumProjectiles; Fired += InFlight)
+	{
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Index = 0; Index < FMath::Min(InFlight, NumProjectiles - Fired); ++Index)
+		{
+			AGSCProjectileBase* Projectile = World->SpawnActorDeferred<AGSCProjectileBase>(ProjectileClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			if (Projectile)
+			{
+				Projectile->FinishSpawning(SpawnTransform);
+				Projectiles.Add(Projectile);
+			}
+		}
+		SpawnCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (AGSCProjectileBase* Projectile : Projectiles)
+		{
+			Projectile->Destroy();
+		}
+		DestroyCycles += FPlatformTime::Cycles64() - StartCycles;
+		Projectiles.Reset();
+	}
+	const double SpawnGCMs = TimeGarbageCollection();
+
+	// With pool, including its initial prewarm
+	uint64 AcquireCycles = 0;
+	uint64 ReleaseCycles = 0;
+	for (int32 Fired = 0; Fired < NumProjectiles; Fired += InFlight)
+	{
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Index = 0; Index < FMath::Min(InFlight, NumProjectiles - Fired); ++Index)
+		{
+			AGSCProjectileBase* Projectile = ProjectilePool->AcquireProjectile(ProjectileClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			if (Projectile)
+			{
+				ProjectilePool->FinishProjectile(Projectile, SpawnTransform);
+				Projectiles.Add(Projectile);
+			}
+		}
+		AcquireCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (AGSCProjectileBase* Projectile : Projectiles)
+		{
+			ProjectilePool->ReleaseProjectile(Projectile);
+		}
+		ReleaseCycles += FPlatformTime::Cycles64() - StartCycles;
+		Projectiles.Reset();
+	}
+	const double PoolGCMs = TimeGarbageCollection();
+
+	// Don't leave the benchmark projectiles around in the pool
+	const int32 NumDrained = ProjectilePool->DrainProjectiles(ProjectileClass);
+
+	GSC_LOG(
+		Display,
+		TEXT("UGSCCheatManager:GSC_BenchmarkProjectilePool() %d projectiles, %d in flight - Spawn: %.3f ms, Destroy: %.3f ms, GC: %.3f ms | Pool acquire: %.3f ms, Release: %.3f ms, GC: %.3f ms (%d pooled, drained)"),
+		NumProjectiles,
+		InFlight,
+		FPlatformTime::ToMilliseconds64(SpawnCycles),
+		FPlatformTime::ToMilliseconds64(DestroyCycles),
+		SpawnGCMs,
+		FPlatformTime::ToMilliseconds64(AcquireCycles),
+		FPlatformTime::ToMilliseconds64(ReleaseCycles),
+		PoolGCMs,
+		NumDrained
+	)
+}
+
+void UGSCCheatManager::GSC_BenchmarkTargetTypes(const int32 NumCandidates, const int32 Iterations) const
+{
+	UWorld* World = GetWorld();
+	if (!World || NumCandidates <= 0 || Iterations <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkTargetTypes() Invalid World or parameters"))
+		return;
+	}
+
+	// Far from any level geometry, candidates are tiny pawn spheres so that overlapping one is the same as containing its center
+	const FVector Center(0.f, 0.f, 100000.f);
+	const float CandidateRadius = 1.f;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	auto SpawnSphereActor = [World, &SpawnParameters](const FVector& Location, const float Radius)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParameters);
+		USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+		Sphere->InitSphereRadius(Radius);
+		Sphere->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+		Actor->SetRootComponent(Sphere);
+		Sphere->RegisterComponent();
+		Actor->SetActorLocation(Location);
+		return Actor;
+	};
+
+	AActor* TargetingActor = SpawnSphereActor(Center, CandidateRadius);
+	TargetingActor->SetActorRotation(FRotator(0.f, 30.f, 0.f));
+
+	FRandomStream RandomStream(NumCandidates);
+	TArray<AActor*> Candidates;
+	Candidates.Reserve(NumCandidates);
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		const FVector Location = Center + FVector(RandomStream.FRandRange(-1000.f, 1000.f), RandomStream.FRandRange(-1000.f, 1000.f), RandomStream.FRandRange(-500.f, 500.f));
+		Candidates.Add(SpawnSphereActor(Location, CandidateRadius));
+	}
+
+	UGSCTargetTypeSphere* Sphere = NewObject<UGSCTargetTypeSphere>();
+	Sphere->Radius = 500.f;
+
+	UGSCTargetTypeBox* Box = NewObject<UGSCTargetTypeBox>();
+	Box->HalfExtent = FVector(500.f, 300.f, 200.f);
+
+	UGSCTargetTypeCapsule* Capsule = NewObject<UGSCTargetTypeCapsule>();
+	Capsule->Radius = 300.f;
+	Capsule->HalfHeight = 600.f;
+
+	UGSCTargetTypeCone* Cone = NewObject<UGSCTargetTypeCone>();
+	Cone->Length = 800.f;
+	Cone->HalfAngleDegrees = 30.f;
+
+	const FGameplayEventData EventData;
+	for (const UGSCTargetTypeOverlap* TargetType : TArray<UGSCTargetTypeOverlap*>({ Sphere, Box, Capsule, Cone }))
+	{
+		TArray<FHitResult> HitResults;
+		TArray<AActor*> Targets;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Targets.Reset();
+			TargetType->GetTargets(TargetingActor, EventData, HitResults, Targets);
+		}
+		const double QueryMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) / Iterations;
+
+		FVector Origin;
+		FQuat Rotation;
+		TargetType->GetQueryTransform(TargetingActor, Origin, Rotation);
+
+		// Every candidate whose center is in the shape must be returned, and returned targets may only be outside of the
+		// shape by the candidate radius
+		int32 NumMissing = 0;
+		int32 NumUnexpected = 0;
+		for (AActor* Candidate : Candidates)
+		{
+			const bool bExpected = TargetType->ContainsPoint(Origin, Rotation, Candidate->GetActorLocation());
+			const bool bReturned = Targets.Contains(Candidate);
+			NumMissing += bExpected && !bReturned ? 1 : 0;
+			NumUnexpected += !bExpected && bReturned ? 1 : 0;
+		}
+
+		bool bSorted = true;
+		for (int32 Index = 1; Index < Targets.Num(); ++Index)
+		{
+			bSorted &= FVector::DistSquared(Origin, Targets[Index - 1]->GetActorLocation()) <= FVector::DistSquared(Origin, Targets[Index]->GetActorLocation());
+		}
+
+		GSC_LOG(
+			Display,
+			TEXT("UGSCCheatManager:GSC_BenchmarkTargetTypes() %s - %d candidates, %d targets, %.4f ms per query. Missing: %d, Outside of shape (within %.0f units of its boundary): %d, Sorted: %s"),
+			*TargetType->GetClass()->GetName(),
+			NumCandidates,
+			Targets.Num(),
+			QueryMs,
+			NumMissing,
+			CandidateRadius,
+			NumUnexpected,
+			bSorted ? TEXT("true") : TEXT("false")
+		)
+	}
+
+	for (AActor* Candidate : Candidates)
+	{
+		Candidate->Destroy();
+	}
+	TargetingActor->Destroy();
+}
+
+void UGSCCheatManager::GSC_BenchmarkTargetData(const int32 NumHits, const int32 Iterations) const
+{
+	if (NumHits <= 0 || Iterations <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkTargetData() Invalid parameters"))
+		return;
+	}
+
+	TArray<FHitResult> HitResults;
+	HitResults.SetNum(NumHits);
+	for (int32 Index = 0; Index < NumHits; ++Index)
+	{
+		HitResults[Index].Location = FVector(Index, 0.f, 0.f);
+		HitResults[Index].bBlockingHit = true;
+	}
+
+	const TArray<AActor*> NoActors;
+
+	// Allocations made building the target data, measured outside of the timed loop
+	int32 PerHitAllocations = INDEX_NONE;
+	int32 PackedAllocations = INDEX_NONE;
+#if GSC_WITH_ALLOCATION_COUNTER
+	{
+		FGameplayAbilityTargetDataHandle PerHitTargetData;
+		FGSCGameplayEffectContainerSpec ContainerSpec;
+		{
+			FGSCScopedAllocationCounter AllocationCounter;
+			for (const FHitResult& HitResult : HitResults)
+			{
+				PerHitTargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+			}
+			PerHitAllocations = AllocationCounter.GetNumAllocations();
+		}
+		{
+			FGSCScopedAllocationCounter AllocationCounter;
+			ContainerSpec.AddTargets(HitResults, NoActors, true);
+			PackedAllocations = AllocationCounter.GetNumAllocations();
+		}
+	}
+
+	if (NumHits > 1 && PackedAllocations >= PerHitAllocations)
+	{
+		GSC_LOG(Error, TEXT("UGSCCheatManager:GSC_BenchmarkTargetData() Packed hit results made %d allocations, not fewer than the %d with one target data per hit"), PackedAllocations, PerHitAllocations)
+	}
+#endif
+
+	int32 NumPerHitEntries = 0;
+	int32 NumContainerEntries = 0;
+	uint64 PerHitCycles = 0;
+	uint64 ContainerCycles = 0;
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		FGameplayAbilityTargetDataHandle PerHitTargetData;
+		for (const FHitResult& HitResult : HitResults)
+		{
+			PerHitTargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+		}
+		PerHitCycles += FPlatformTime::Cycles64() - StartCycles;
+		NumPerHitEntries = PerHitTargetData.Num();
+
+		StartCycles = FPlatformTime::Cycles64();
+		FGSCGameplayEffectContainerSpec ContainerSpec;
+		ContainerSpec.AddTargets(HitResults, NoActors, true);
+		ContainerCycles += FPlatformTime::Cycles64() - StartCycles;
+		NumContainerEntries = ContainerSpec.TargetData.Num();
+
+		// Every hit must still be reachable from the handle
+		if (Iteration == 0)
+		{
+			int32 NumContainerHits = 0;
+			for (int32 Index = 0; Index < NumContainerEntries; ++Index)
+			{
+				const FGameplayAbilityTargetData* Data = ContainerSpec.TargetData.Get(Index);
+				NumContainerHits += NumHits > 1 ? static_cast<const FGSCGameplayAbilityTargetData_MultiHit*>(Data)->GetHitResults().Num() : 1;
+			}
+
+			if (NumContainerHits != NumHits)
+			{
+				GSC_LOG(Error, TEXT("UGSCCheatManager:GSC_BenchmarkTargetData() Container target data holds %d hits, expected %d"), NumContainerHits, NumHits)
+			}
+		}
+	}
+
+	GSC_LOG(
+		Display,
+		TEXT("UGSCCheatManager:GSC_BenchmarkTargetData() %d hits, %d iterations - Target data entries: %d with one target data per hit, %d with packed hit results. Allocations: %d with one target data per hit, %d with packed hit results (-1 if not measured). Build time: %.4f ms with one target data per hit, %.4f ms with packed hit results"),
+		NumHits,
+		Iterations,
+		NumPerHitEntries,
+		NumContainerEntries,
+		PerHitAllocations,
+		PackedAllocations,
+		FPlatformTime::ToMilliseconds64(PerHitCycles) / Iterations,
+		FPlatformTime::ToMilliseconds64(ContainerCycles) / Iterations
+	)
+}
+
+void UGSCCheatManager::GSC_BenchmarkEffectContainer(const int32 NumTargets, const int32 NumEffects, const int32 Iterations) const
+{
+	UWorld* World = GetWorld();
+	if (!World || NumTargets <= 0 || NumEffects <= 0 || Iterations <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkEffectContainer() Invalid World or parameters"))
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+
+	AActor* Instigator = World->SpawnActor<AActor>(SpawnParameters);
+	UAbilitySystemComponent* InstigatorASC = NewObject<UAbilitySystemComponent>(Instigator);
+	InstigatorASC->RegisterComponent();
+	InstigatorASC->InitAbilityActorInfo(Instigator, Instigator);
+
+	// Half of the targets hit by a trace (hit result target data), the other half as actors (actor array target data)
+	TArray<AActor*> Targets;
+	TArray<UAbilitySystemComponent*> AbilitySystemComponents;
+	TArray<FHitResult> HitResults;
+	TArray<AActor*> TargetActors;
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		AActor* Target = World->SpawnActor<AActor>(SpawnParameters);
+		UAbilitySystemComponent* ASC = NewObject<UAbilitySystemComponent>(Target);
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(Target, Target);
+		ASC->InitStats(UGSCAttributeSet::StaticClass(), nullptr);
+
+		Targets.Add(Target);
+		AbilitySystemComponents.Add(ASC);
+
+		if (Index % 2 == 0)
+		{
+			FHitResult& HitResult = HitResults.AddDefaulted_GetRef();
+			HitResult.Actor = Target;
+			HitResult.Location = FVector(Index, 0.f, 0.f);
+			HitResult.bBlockingHit = true;
+		}
+		else
+		{
+			TargetActors.Add(Target);
+		}
+	}
+
+	const auto ResetAttributes = [&AbilitySystemComponents]()
+	{
+		for (UAbilitySystemComponent* ASC : AbilitySystemComponents)
+		{
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetMaxHealthAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetMaxStaminaAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetHealthAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetStaminaAttribute(), 1000.f);
+		}
+	};
+
+	// Target data built the way AddTargets used to, independently of it: one single target hit per hit and an actor array
+	FGameplayAbilityTargetDataHandle BaselineTargetData;
+	for (const FHitResult& HitResult : HitResults)
+	{
+		BaselineTargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+	}
+	FGameplayAbilityTargetData_ActorArray* BaselineActorArray = new FGameplayAbilityTargetData_ActorArray();
+	BaselineActorArray->TargetActorArray.Append(TargetActors);
+	BaselineTargetData.Add(BaselineActorArray);
+
+	// Instant damage and stamina drain effects, with different magnitudes so that application order matters
+	FGSCGameplayEffectContainerSpec ContainerSpec;
+	FGSCGameplayEffectContainerSpec PackedContainerSpec;
+	ContainerSpec.AddTargets(HitResults, TargetActors);
+	PackedContainerSpec.AddTargets(HitResults, TargetActors, true);
+	for (int32 Index = 0; Index < NumEffects; ++Index)
+	{
+		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+		Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+		FGameplayModifierInfo& Damage = Effect->Modifiers.AddDefaulted_GetRef();
+		Damage.Attribute = UGSCAttributeSet::GetHealthAttribute();
+		Damage.ModifierOp = Index % 2 == 0 ? EGameplayModOp::Additive : EGameplayModOp::Multiplicitive;
+		Damage.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Index % 2 == 0 ? -1.f - Index : 0.95f));
+
+		FGameplayModifierInfo& Drain = Effect->Modifiers.AddDefaulted_GetRef();
+		Drain.Attribute = UGSCAttributeSet::GetStaminaAttribute();
+		Drain.ModifierOp = EGameplayModOp::Additive;
+		Drain.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(-2.f));
+
+		ContainerSpec.TargetGameplayEffectSpecs.Add(FGameplayEffectSpecHandle(new FGameplayEffectSpec(Effect, InstigatorASC->MakeEffectContext(), 1.f)));
+	}
+	PackedContainerSpec.TargetGameplayEffectSpecs = ContainerSpec.TargetGameplayEffectSpecs;
+
+	// What UGSCGameplayAbility::ApplyEffectContainerSpec used to do, each spec applied to the baseline target data in turn
+	const auto ApplyPerSpec = [&ContainerSpec, &BaselineTargetData]()
+	{
+		int32 NumApplied = 0;
+		for (const FGameplayEffectSpecHandle& SpecHandle : ContainerSpec.TargetGameplayEffectSpecs)
+		{
+			for (const TSharedPtr<FGameplayAbilityTargetData>& Data : BaselineTargetData.Data)
+			{
+				NumApplied += Data->ApplyGameplayEffectSpec(*SpecHandle.Data.Get(), FPredictionKey()).Num();
+			}
+		}
+		return NumApplied;
+	};
+
+	const auto SnapshotAttributes = [&AbilitySystemComponents](TArray<float>& OutValues)
+	{
+		OutValues.Reset(AbilitySystemComponents.Num() * 2);
+		for (const UAbilitySystemComponent* ASC : AbilitySystemComponents)
+		{
+			OutValues.Add(ASC->GetNumericAttribute(UGSCAttributeSet::GetHealthAttribute()));
+			OutValues.Add(ASC->GetNumericAttribute(UGSCAttributeSet::GetStaminaAttribute()));
+		}
+	};
+
+	// Regression check first: batched application, with and without packed hit results, must end up with the exact same
+	// attribute values as the baseline
+	TArray<float> PerSpecValues;
+	TArray<float> BatchedValues;
+	ResetAttributes();
+	ApplyPerSpec();
+	SnapshotAttributes(PerSpecValues);
+
+	int32 NumMismatches = 0;
+	for (const FGSCGameplayEffectContainerSpec* Spec : { &ContainerSpec, &PackedContainerSpec })
+	{
+		ResetAttributes();
+		Spec->ApplyToTargets(FPredictionKey());
+		SnapshotAttributes(BatchedValues);
+
+		for (int32 Index = 0; Index < PerSpecValues.Num(); ++Index)
+		{
+			if (PerSpecValues[Index] != BatchedValues[Index])
+			{
+				++NumMismatches;
+			}
+		}
+	}
+
+	if (NumMismatches > 0)
+	{
+		GSC_LOG(Error, TEXT("UGSCCheatManager:GSC_BenchmarkEffectContainer() %d attribute values differ between baseline and batched application"), NumMismatches)
+	}
+
+	int32 PerSpecApplied = 0;
+	int32 BatchedApplied = 0;
+	uint64 PerSpecCycles = 0;
+	uint64 BatchedCycles = 0;
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		ResetAttributes();
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		PerSpecApplied += ApplyPerSpec();
+		PerSpecCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		ResetAttributes();
+		StartCycles = FPlatformTime::Cycles64();
+		BatchedApplied += ContainerSpec.ApplyToTargets(FPredictionKey()).Num();
+		BatchedCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+	const double PerSpecMs = FPlatformTime::ToMilliseconds64(PerSpecCycles);
+	const double BatchedMs = FPlatformTime::ToMilliseconds64(BatchedCycles);
+	GSC_LOG(
+		Display,
+		TEXT("UGSCCheatManager:GSC_BenchmarkEffectContainer() %d targets, %d effects, %d iterations - Per spec: %.1f effects/ms, Batched: %.1f effects/ms. Attribute values: %s"),
+		NumTargets,
+		NumEffects,
+		Iterations,
+		PerSpecMs > 0. ? PerSpecApplied / PerSpecMs : 0.,
+		BatchedMs > 0. ? BatchedApplied / BatchedMs : 0.,
+		NumMismatches == 0 ? TEXT("identical") : TEXT("DIFFERENT")
+	)
+
+	for (AActor* Target : Targets)
+	{
+		Target->Destroy();
+	}
+	Instigator->Destroy();
+}
+
+void UGSCCheatManager::GSC_BenchmarkCostChecks(const int32 NumChecks) const
+{
+	const APlayerController* PC = GetOuterAPlayerController();
+	UAbilitySystemComponent* ASC = PC ? UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(PC->GetPawn()) : nullptr;
+	IConsoleVariable* CacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("GSC.CacheLooseCostChecks"));
+	if (!ASC || !CacheCVar || NumChecks <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkCostChecks() No Ability System Component on player pawn or invalid parameters"))
+		return;
+	}
+
+	const bool bWasCaching = CacheCVar->GetBool();
+	const FGameplayAbilityActorInfo* ActorInfo = ASC->AbilityActorInfo.Get();
+
+	for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+	{
+		const UGSCGameplayAbility* Ability = Cast<UGSCGameplayAbility>(Spec.GetPrimaryInstance() ? Spec.GetPrimaryInstance() : Spec.Ability);
+		if (!Ability || !Ability->bLooselyCheckAbilityCost)
+		{
+			continue;
+		}
+
+		double CheckMs[2];
+		bool bCanActivate[2];
+		for (int32 Pass = 0; Pass < 2; ++Pass)
+		{
+			CacheCVar->Set(Pass == 0 ? 0 : 1, ECVF_SetByConsole);
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Check = 0; Check < NumChecks; ++Check)
+			{
+				bCanActivate[Pass] = Ability->CanActivateAbility(Spec.Handle, ActorInfo, nullptr, nullptr, nullptr);
+			}
+			CheckMs[Pass] = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+		}
+
+		GSC_LOG(
+			Display,
+			TEXT("UGSCCheatManager:GSC_BenchmarkCostChecks() %s, %d checks - Uncached: %.1f checks/ms, Cached: %.1f checks/ms%s"),
+			*GetNameSafe(Ability),
+			NumChecks,
+			CheckMs[0] > 0. ? NumChecks / CheckMs[0] : 0.,
+			CheckMs[1] > 0. ? NumChecks / CheckMs[1] : 0.,
+			bCanActivate[0] != bCanActivate[1] ? TEXT(" (MISMATCH between uncached and cached result)") : TEXT("")
+		)
+	}
+
+	CacheCVar->Set(bWasCaching ? 1 : 0, ECVF_SetByConsole);
+}
+
+void UGSCCheatManager::GSC_DumpCooldownTrackers() const
+{
+	const UWorld* World = GetWorld();
+	const UGSCCooldownSubsystem* CooldownSubsystem = World ? World->GetSubsystem<UGSCCooldownSubsystem>() : nullptr;
+	if (!CooldownSubsystem)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_DumpCooldownTrackers() No cooldown subsystem"))
+		return;
+	}
+
+	CooldownSubsystem->DumpTrackers();
+}
+
 void UGSCCheatManager::ExecuteConsoleCommand(const FString Command) const
 {
 	APlayerController* PC = Cast<APlayerController>(GetOuterAPlayerController());
@@ -86,3 +756,50 @@ void UGSCCheatManager::ExecuteConsoleCommand(const FString Command) const
 	PC->ConsoleCommand(Command, true);
 }
 
+
+void UGSCCheatManager::GSC_BenchmarkCrowdSignificance(const int32 NumCharacters, const int32 FramesPerBucket, const float Radius) const
+{
+	UWorld* World = GetWorld();
+	const APlayerController* PC = GetOuterAPlayerController();
+	const ACharacter* PlayerCharacter = PC ? Cast<ACharacter>(PC->GetPawn()) : nullptr;
+	UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(World);
+	if (!World || !PlayerCharacter || !SignificanceSubsystem || NumCharacters <= 0 || FramesPerBucket <= 0)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkCrowdSignificance() Invalid World, player character or parameters"))
+		return;
+	}
+
+	if (!GetDefault<UGSCDeveloperSettings>()->bEnableCharacterSignificance)
+	{
+		GSC_LOG(Warning, TEXT("UGSCCheatManager:GSC_BenchmarkCrowdSignificance() Character significance is disabled in GAS Companion settings"))
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+
+	const FVector Center = PlayerCharacter->GetActorLocation();
+	TArray<ACharacter*> Characters;
+	Characters.Reserve(NumCharacters);
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const float Angle = 2.f * PI * Index / NumCharacters;
+		const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius;
+		const FRotator Rotation = (Center - Location).Rotation();
+		if (ACharacter* Character = World->SpawnActor<ACharacter>(PlayerCharacter->GetClass(), Location, Rotation, SpawnParameters))
+		{
+			Characters.Add(Character);
+		}
+	}
+
+	GSC_LOG(
+		Display,
+		TEXT("UGSCCheatManager:GSC_BenchmarkCrowdSignificance() Spawned %d characters (%d registered for significance), running %d frames per bucket"),
+		Characters.Num(),
+		SignificanceSubsystem->NumRegisteredCharacters(),
+		FramesPerBucket
+	)
+
+	SignificanceSubsystem->RunCrowdBenchmark(Characters, FramesPerBucket);
+}
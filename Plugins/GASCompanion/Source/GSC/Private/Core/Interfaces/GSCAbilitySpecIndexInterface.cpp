@@ -0,0 +1,6 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Core/Interfaces/GSCAbilitySpecIndexInterface.h"
+
+// Add default functionality here for any IGSCAbilitySpecIndexInterface functions that are not pure virtual.
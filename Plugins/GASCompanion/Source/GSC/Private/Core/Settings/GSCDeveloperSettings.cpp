@@ -3,7 +3,52 @@
 
 #include "Core/Settings/GSCDeveloperSettings.h"
 
+#include "Abilities/Attributes/GSCAttributeClampTable.h"
+
 UGSCDeveloperSettings::UGSCDeveloperSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 
 }
+
+void UGSCDeveloperSettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FGSCAttributeClampTable::Get().Invalidate();
+	}
+}
+
+void UGSCDeveloperSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	FGSCAttributeClampTable::Get().Invalidate();
+}
+
+const FGSCCharacterSignificanceSettings& UGSCDeveloperSettings::GetSignificanceSettings(const EGSCCharacterSignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EGSCCharacterSignificance::Medium:
+		return MediumSignificanceSettings;
+	case EGSCCharacterSignificance::Low:
+		return LowSignificanceSettings;
+	default:
+		return HighSignificanceSettings;
+	}
+}
+
+#if WITH_EDITOR
+void UGSCDeveloperSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Member property, as edits of an array element report the nested property (Attribute / MinimumValue)
+	const FName PropertyName = PropertyChangedEvent.MemberProperty ? PropertyChangedEvent.MemberProperty->GetFName() : NAME_None;
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UGSCDeveloperSettings, MinimumValues) || PropertyName == NAME_None)
+	{
+		FGSCAttributeClampTable::Get().Invalidate();
+	}
+}
+#endif
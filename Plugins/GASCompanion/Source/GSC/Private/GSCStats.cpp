@@ -0,0 +1,8 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "GSCStats.h"
+
+DEFINE_STAT(STAT_GSC_CompanionComponents);
+DEFINE_STAT(STAT_GSC_CompanionComponentTickFunctions);
+DEFINE_STAT(STAT_GSC_DebugWidgetRefreshes);
@@ -0,0 +1,118 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Subsystems/GSCComponentCacheSubsystem.h"
+
+#include "GSCStats.h"
+#include "Components/ActorComponent.h"
+#include "Components/GSCAbilityQueueComponent.h"
+#include "Components/GSCComboManagerComponent.h"
+#include "Components/GSCCoreComponent.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Component Cache Hits"), STAT_GSC_ComponentCacheHits, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Component Cache Misses"), STAT_GSC_ComponentCacheMisses, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Component Cache Invalidations"), STAT_GSC_ComponentCacheInvalidations, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Component Cache Actors"), STAT_GSC_ComponentCacheActors, STATGROUP_GASCompanion);
+
+UGSCComponentCacheSubsystem* UGSCComponentCacheSubsystem::Get(const AActor* Actor)
+{
+	const UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGSCComponentCacheSubsystem>() : nullptr;
+}
+
+void UGSCComponentCacheSubsystem::InvalidateComponentOwner(const UActorComponent* Component)
+{
+	const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+	if (UGSCComponentCacheSubsystem* Subsystem = Get(Owner))
+	{
+		Subsystem->Invalidate(Owner);
+	}
+}
+
+void UGSCComponentCacheSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_GSC_ComponentCacheActors, CachedActors.Num());
+	CachedActors.Empty();
+	Super::Deinitialize();
+}
+
+UGSCCoreComponent* UGSCComponentCacheSubsystem::FindOrResolveCoreComponent(const AActor* Actor, const TFunctionRef<UGSCCoreComponent*(const AActor*)> Resolver)
+{
+	return FindOrResolve(Actor, &FCachedComponents::CoreComponent, Resolver);
+}
+
+UGSCComboManagerComponent* UGSCComponentCacheSubsystem::FindOrResolveComboManagerComponent(const AActor* Actor, const TFunctionRef<UGSCComboManagerComponent*(const AActor*)> Resolver)
+{
+	return FindOrResolve(Actor, &FCachedComponents::ComboManagerComponent, Resolver);
+}
+
+UGSCAbilityQueueComponent* UGSCComponentCacheSubsystem::FindOrResolveAbilityQueueComponent(const AActor* Actor, const TFunctionRef<UGSCAbilityQueueComponent*(const AActor*)> Resolver)
+{
+	return FindOrResolve(Actor, &FCachedComponents::AbilityQueueComponent, Resolver);
+}
+
+void UGSCComponentCacheSubsystem::Invalidate(const AActor* Actor)
+{
+	if (CachedActors.Remove(Actor) > 0)
+	{
+		INC_DWORD_STAT(STAT_GSC_ComponentCacheInvalidations);
+		DEC_DWORD_STAT(STAT_GSC_ComponentCacheActors);
+	}
+}
+
+template<typename ComponentType>
+ComponentType* UGSCComponentCacheSubsystem::FindOrResolve(const AActor* Actor, TCachedComponent<ComponentType> FCachedComponents::* Member, const TFunctionRef<ComponentType*(const AActor*)> Resolver)
+{
+	if (FCachedComponents* Entry = CachedActors.Find(Actor))
+	{
+		const TCachedComponent<ComponentType>& Cached = Entry->*Member;
+		if (Cached.IsUsable())
+		{
+			INC_DWORD_STAT(STAT_GSC_ComponentCacheHits);
+			return Cached.Component.Get();
+		}
+	}
+
+	INC_DWORD_STAT(STAT_GSC_ComponentCacheMisses);
+
+	// Resolve before adding the entry, in case the resolver ends up invalidating it (eg. BP implementation of the companion interface)
+	ComponentType* Component = Resolver(Actor);
+	if (Component)
+	{
+		(FindOrAddEntry(Actor).*Member).Component = Component;
+	}
+
+	return Component;
+}
+
+UGSCComponentCacheSubsystem::FCachedComponents& UGSCComponentCacheSubsystem::FindOrAddEntry(const AActor* Actor)
+{
+	if (FCachedComponents* Entry = CachedActors.Find(Actor))
+	{
+		return *Entry;
+	}
+
+	if (CachedActors.Num() >= PurgeThreshold)
+	{
+		PurgeStaleEntries();
+		PurgeThreshold = FMath::Max(64, CachedActors.Num() * 2);
+	}
+
+	INC_DWORD_STAT(STAT_GSC_ComponentCacheActors);
+	return CachedActors.Add(Actor);
+}
+
+void UGSCComponentCacheSubsystem::PurgeStaleEntries()
+{
+	// Actors owning companion components invalidate their entry when those are unregistered. This only catches actors
+	// that went away without doing so.
+	for (auto It = CachedActors.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+			DEC_DWORD_STAT(STAT_GSC_ComponentCacheActors);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Subsystems/GSCCooldownSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "GSCLog.h"
+#include "Abilities/GSCCooldownTracker.h"
+#include "Engine/World.h"
+
+TSharedPtr<FGSCCooldownTracker> UGSCCooldownSubsystem::GetCooldownTracker(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	const UWorld* World = AbilitySystemComponent ? AbilitySystemComponent->GetWorld() : nullptr;
+	UGSCCooldownSubsystem* Subsystem = World ? World->GetSubsystem<UGSCCooldownSubsystem>() : nullptr;
+	return Subsystem ? Subsystem->FindOrAddTracker(AbilitySystemComponent) : nullptr;
+}
+
+void UGSCCooldownSubsystem::Deinitialize()
+{
+	for (const TPair<TWeakObjectPtr<UAbilitySystemComponent>, TSharedPtr<FGSCCooldownTracker>>& Tracker : Trackers)
+	{
+		Tracker.Value->Shutdown();
+	}
+
+	Trackers.Empty();
+	Super::Deinitialize();
+}
+
+void UGSCCooldownSubsystem::DumpTrackers() const
+{
+	GSC_LOG(Display, TEXT("UGSCCooldownSubsystem::DumpTrackers() %d tracker(s)"), Trackers.Num())
+	for (const TPair<TWeakObjectPtr<UAbilitySystemComponent>, TSharedPtr<FGSCCooldownTracker>>& Tracker : Trackers)
+	{
+		const UAbilitySystemComponent* ASC = Tracker.Key.Get();
+		GSC_LOG(
+			Display,
+			TEXT("\t%s - Tracked cooldowns: %d, Tag subscriptions: %d"),
+			ASC ? *GetNameSafe(ASC->GetOwner()) : TEXT("(stale)"),
+			Tracker.Value->NumTrackedCooldowns(),
+			Tracker.Value->NumTagSubscriptions()
+		)
+	}
+}
+
+TSharedPtr<FGSCCooldownTracker> UGSCCooldownSubsystem::FindOrAddTracker(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	if (const TSharedPtr<FGSCCooldownTracker>* Tracker = Trackers.Find(AbilitySystemComponent))
+	{
+		return *Tracker;
+	}
+
+	// Trackers are only created once per ASC, a good time to get rid of the ones for destroyed ASCs
+	PurgeStaleTrackers();
+
+	TSharedPtr<FGSCCooldownTracker> Tracker = MakeShared<FGSCCooldownTracker>(AbilitySystemComponent);
+	Tracker->Initialize();
+	Trackers.Add(AbilitySystemComponent, Tracker);
+	return Tracker;
+}
+
+void UGSCCooldownSubsystem::PurgeStaleTrackers()
+{
+	for (auto It = Trackers.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.Value()->Shutdown();
+			It.RemoveCurrent();
+		}
+	}
+}
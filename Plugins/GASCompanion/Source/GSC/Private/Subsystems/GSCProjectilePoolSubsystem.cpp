@@ -0,0 +1,223 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Subsystems/GSCProjectilePoolSubsystem.h"
+
+#include "GSCLog.h"
+#include "GSCStats.h"
+#include "Actors/Projectiles/GSCProjectileBase.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Acquire"), STAT_GSC_ProjectileAcquire, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Spawned"), STAT_GSC_ProjectilesSpawned, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Reused"), STAT_GSC_ProjectilesReused, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Projectiles"), STAT_GSC_PooledProjectiles, STATGROUP_GASCompanion);
+
+UGSCProjectilePoolSubsystem* UGSCProjectilePoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGSCProjectilePoolSubsystem>() : nullptr;
+}
+
+void UGSCProjectilePoolSubsystem::Deinitialize()
+{
+	for (const TPair<TWeakObjectPtr<UClass>, FProjectileList>& Pool : AvailableProjectiles)
+	{
+		DEC_DWORD_STAT_BY(STAT_GSC_PooledProjectiles, Pool.Value.Num());
+	}
+
+	AvailableProjectiles.Empty();
+	PrewarmedClasses.Empty();
+	Super::Deinitialize();
+}
+
+AGSCProjectileBase* UGSCProjectilePoolSubsystem::AcquireProjectile(const TSubclassOf<AGSCProjectileBase> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, const ESpawnActorCollisionHandlingMethod CollisionHandlingOverride)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GSC_ProjectileAcquire);
+
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	if (!PrewarmedClasses.Contains(Class.Get()))
+	{
+		PrewarmedClasses.Add(Class.Get());
+		PrewarmProjectiles(Class, Class->GetDefaultObject<AGSCProjectileBase>()->PoolPrewarmCount);
+	}
+
+	FProjectileList* Available = AvailableProjectiles.Find(Class.Get());
+	if (Available && Available->Num() > 0)
+	{
+		// Same check as UWorld::SpawnActor(), done against the class default object before handing out an instance
+		const AGSCProjectileBase* CDO = Class->GetDefaultObject<AGSCProjectileBase>();
+		const ESpawnActorCollisionHandlingMethod CollisionHandlingMethod = CollisionHandlingOverride == ESpawnActorCollisionHandlingMethod::Undefined ? CDO->SpawnCollisionHandlingMethod : CollisionHandlingOverride;
+		if (CollisionHandlingMethod == ESpawnActorCollisionHandlingMethod::DontSpawnIfColliding && GetWorld()->EncroachingBlockingGeometry(CDO, SpawnTransform.GetLocation(), SpawnTransform.Rotator()))
+		{
+			GSC_LOG(Verbose, TEXT("UGSCProjectilePoolSubsystem::AcquireProjectile() %s not fired, spawn location is blocked"), *Class->GetName())
+			return nullptr;
+		}
+
+		while (Available->Num() > 0)
+		{
+			AGSCProjectileBase* Projectile = Available->Pop(false).Get();
+			DEC_DWORD_STAT(STAT_GSC_PooledProjectiles);
+
+			// Might have been destroyed while in the pool (level streamed out, explicit Destroy)
+			if (IsValid(Projectile))
+			{
+				INC_DWORD_STAT(STAT_GSC_ProjectilesReused);
+				Projectile->SetOwner(Owner);
+				Projectile->SetInstigator(Instigator);
+				Projectile->SpawnCollisionHandlingMethod = CollisionHandlingMethod;
+				return Projectile;
+			}
+		}
+	}
+
+	return SpawnPooledProjectile(Class, SpawnTransform, Owner, Instigator, CollisionHandlingOverride);
+}
+
+bool UGSCProjectilePoolSubsystem::FinishProjectile(AGSCProjectileBase* Projectile, const FTransform& SpawnTransform)
+{
+	if (!IsValid(Projectile))
+	{
+		return false;
+	}
+
+	// Newly spawned, go through construction and BeginPlay once (spawn collision handling included)
+	if (!Projectile->IsActorInitialized())
+	{
+		Projectile->FinishSpawning(SpawnTransform);
+		if (!IsValid(Projectile))
+		{
+			return false;
+		}
+
+		Projectile->ActivatePooledProjectile(Projectile->GetActorTransform());
+		return true;
+	}
+
+	Projectile->ActivatePooledProjectile(SpawnTransform);
+
+	// Reused, adjust the location like AActor::PostActorConstruction() does on a new spawn, now that collision is back
+	const ESpawnActorCollisionHandlingMethod CollisionHandlingMethod = Projectile->SpawnCollisionHandlingMethod;
+	if (CollisionHandlingMethod == ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn || CollisionHandlingMethod == ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding)
+	{
+		FVector AdjustedLocation = Projectile->GetActorLocation();
+		FRotator AdjustedRotation = Projectile->GetActorRotation();
+		if (GetWorld()->FindTeleportSpot(Projectile, AdjustedLocation, AdjustedRotation))
+		{
+			Projectile->SetActorLocationAndRotation(AdjustedLocation, AdjustedRotation, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+		else if (CollisionHandlingMethod == ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding)
+		{
+			GSC_LOG(Verbose, TEXT("UGSCProjectilePoolSubsystem::FinishProjectile() %s not fired, no free spot around spawn location"), *Projectile->GetName())
+			ReleaseProjectile(Projectile);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UGSCProjectilePoolSubsystem::ReleaseProjectile(AGSCProjectileBase* Projectile)
+{
+	if (!IsValid(Projectile) || Projectile->bInPool)
+	{
+		return;
+	}
+
+	FProjectileList& Available = AvailableProjectiles.FindOrAdd(Projectile->GetClass());
+	if (Available.Num() >= Projectile->GetClass()->GetDefaultObject<AGSCProjectileBase>()->MaxPoolSize)
+	{
+		GSC_LOG(Verbose, TEXT("UGSCProjectilePoolSubsystem::ReleaseProjectile() Pool for %s is full, destroying %s"), *GetNameSafe(Projectile->GetClass()), *Projectile->GetName())
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->DeactivatePooledProjectile();
+	Available.Add(Projectile);
+	INC_DWORD_STAT(STAT_GSC_PooledProjectiles);
+}
+
+void UGSCProjectilePoolSubsystem::PrewarmProjectiles(const TSubclassOf<AGSCProjectileBase> Class, const int32 Count)
+{
+	if (!Class)
+	{
+		return;
+	}
+
+	const int32 MaxPoolSize = Class->GetDefaultObject<AGSCProjectileBase>()->MaxPoolSize;
+	FProjectileList& Available = AvailableProjectiles.FindOrAdd(Class.Get());
+	const int32 NumToSpawn = FMath::Min(Count, MaxPoolSize - Available.Num());
+	if (NumToSpawn <= 0)
+	{
+		return;
+	}
+
+	GSC_LOG(Verbose, TEXT("UGSCProjectilePoolSubsystem::PrewarmProjectiles() Spawning %d %s"), NumToSpawn, *Class->GetName())
+	Available.Reserve(Available.Num() + NumToSpawn);
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		AGSCProjectileBase* Projectile = SpawnPooledProjectile(Class, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Projectile)
+		{
+			break;
+		}
+
+		Projectile->FinishSpawning(FTransform::Identity);
+		Projectile->DeactivatePooledProjectile();
+		Available.Add(Projectile);
+		INC_DWORD_STAT(STAT_GSC_PooledProjectiles);
+	}
+}
+
+int32 UGSCProjectilePoolSubsystem::NumAvailable(const TSubclassOf<AGSCProjectileBase> Class) const
+{
+	const FProjectileList* Available = AvailableProjectiles.Find(Class.Get());
+	return Available ? Available->Num() : 0;
+}
+
+int32 UGSCProjectilePoolSubsystem::DrainProjectiles(const TSubclassOf<AGSCProjectileBase> Class)
+{
+	FProjectileList Available;
+	if (!AvailableProjectiles.RemoveAndCopyValue(Class.Get(), Available))
+	{
+		return 0;
+	}
+
+	PrewarmedClasses.Remove(Class.Get());
+	DEC_DWORD_STAT_BY(STAT_GSC_PooledProjectiles, Available.Num());
+
+	int32 NumDestroyed = 0;
+	for (const TWeakObjectPtr<AGSCProjectileBase>& Projectile : Available)
+	{
+		if (Projectile.IsValid())
+		{
+			Projectile->Destroy();
+			++NumDestroyed;
+		}
+	}
+
+	GSC_LOG(Verbose, TEXT("UGSCProjectilePoolSubsystem::DrainProjectiles() Destroyed %d %s"), NumDestroyed, *GetNameSafe(Class.Get()))
+	return NumDestroyed;
+}
+
+AGSCProjectileBase* UGSCProjectilePoolSubsystem::SpawnPooledProjectile(const TSubclassOf<AGSCProjectileBase> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, const ESpawnActorCollisionHandlingMethod CollisionHandlingOverride) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	AGSCProjectileBase* Projectile = World->SpawnActorDeferred<AGSCProjectileBase>(Class, SpawnTransform, Owner, Instigator, CollisionHandlingOverride);
+	if (Projectile)
+	{
+		INC_DWORD_STAT(STAT_GSC_ProjectilesSpawned);
+		Projectile->bManagedByPool = true;
+	}
+
+	return Projectile;
+}
@@ -0,0 +1,398 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Subsystems/GSCSignificanceSubsystem.h"
+
+#include "GSCLog.h"
+#include "GSCStats.h"
+#include "SignificanceManager.h"
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "Misc/App.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Significance Update"), STAT_GSC_SignificanceUpdate, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance High Characters"), STAT_GSC_SignificanceHighCharacters, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Medium Characters"), STAT_GSC_SignificanceMediumCharacters, STATGROUP_GASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Low Characters"), STAT_GSC_SignificanceLowCharacters, STATGROUP_GASCompanion);
+
+static const FName NAME_GSCCharacterSignificance = TEXT("GSCCharacter");
+
+void UGSCSignificanceMontageListener::OnMontageStarted(UAnimMontage* Montage)
+{
+	if (UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(Character.Get()))
+	{
+		SignificanceSubsystem->OnCharacterMontageStarted(Character.Get());
+	}
+}
+
+UGSCSignificanceSubsystem* UGSCSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGSCSignificanceSubsystem>() : nullptr;
+}
+
+void UGSCSignificanceSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+	}
+
+	for (const TPair<TWeakObjectPtr<ACharacter>, TStrongObjectPtr<UGSCSignificanceMontageListener>>& Pair : MontageListeners)
+	{
+		if (UAnimInstance* AnimInstance = Pair.Value->AnimInstance.Get())
+		{
+			AnimInstance->OnMontageStarted.RemoveDynamic(Pair.Value.Get(), &UGSCSignificanceMontageListener::OnMontageStarted);
+		}
+	}
+
+	MontageListeners.Empty();
+	RegisteredCharacters.Empty();
+	CrowdBenchmark.Reset();
+
+	SET_DWORD_STAT(STAT_GSC_SignificanceHighCharacters, 0);
+	SET_DWORD_STAT(STAT_GSC_SignificanceMediumCharacters, 0);
+	SET_DWORD_STAT(STAT_GSC_SignificanceLowCharacters, 0);
+	Super::Deinitialize();
+}
+
+void UGSCSignificanceSubsystem::RegisterCharacter(ACharacter* Character)
+{
+	UWorld* World = GetWorld();
+	if (!Character || !World || !World->IsGameWorld() || !GetDefault<UGSCDeveloperSettings>()->bEnableCharacterSignificance)
+	{
+		return;
+	}
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+	if (!SignificanceManager)
+	{
+		GSC_LOG(Verbose, TEXT("UGSCSignificanceSubsystem::RegisterCharacter() No significance manager for world %s, %s keeps its default tick settings"), *GetNameSafe(World), *Character->GetName())
+		return;
+	}
+
+	SignificanceManager->RegisterObject(
+		Character,
+		NAME_GSCCharacterSignificance,
+		[this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+		{
+			return CalculateSignificance(CastChecked<ACharacter>(ObjectInfo->GetObject()), Viewpoint);
+		}
+	);
+
+	RegisteredCharacters.Add(Character);
+	AddMontageListener(Character);
+
+	if (!UpdateTimerHandle.IsValid())
+	{
+		const float Interval = FMath::Max(GetDefault<UGSCDeveloperSettings>()->SignificanceUpdateInterval, 0.01f);
+		World->GetTimerManager().SetTimer(UpdateTimerHandle, this, &UGSCSignificanceSubsystem::UpdateSignificance, Interval, true);
+	}
+}
+
+void UGSCSignificanceSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+	if (!Character || RegisteredCharacters.Remove(Character) == 0)
+	{
+		return;
+	}
+
+	RemoveMontageListener(Character);
+
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(Character);
+	}
+
+	if (RegisteredCharacters.Num() == 0)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+		}
+	}
+}
+
+EGSCCharacterSignificance UGSCSignificanceSubsystem::GetCharacterSignificance(const ACharacter* Character) const
+{
+	const USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!SignificanceManager || !RegisteredCharacters.Contains(Character))
+	{
+		return EGSCCharacterSignificance::High;
+	}
+
+	return ToSignificance(SignificanceManager->GetSignificance(Character));
+}
+
+void UGSCSignificanceSubsystem::SetForcedSignificance(const EGSCCharacterSignificance Significance)
+{
+	ForcedSignificance = Significance;
+	UpdateSignificance();
+}
+
+void UGSCSignificanceSubsystem::ClearForcedSignificance()
+{
+	ForcedSignificance.Reset();
+	UpdateSignificance();
+}
+
+void UGSCSignificanceSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GSC_SignificanceUpdate);
+
+	UWorld* World = GetWorld();
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+	if (!SignificanceManager)
+	{
+		return;
+	}
+
+	// Every player viewpoint we know about (on a listen / dedicated server, remote players view from their pawn)
+	TArray<FTransform, TInlineAllocator<4>> Viewpoints;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PC = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PC->GetPlayerViewPoint(Location, Rotation);
+			Viewpoints.Emplace(Rotation, Location);
+		}
+	}
+
+	if (Viewpoints.Num() > 0)
+	{
+		SignificanceManager->Update(Viewpoints);
+	}
+
+	int32 NumPerBucket[(int32)EGSCCharacterSignificance::MAX] = {};
+	for (auto It = RegisteredCharacters.CreateIterator(); It; ++It)
+	{
+		ACharacter* Character = It->Get();
+		if (!Character)
+		{
+			MontageListeners.Remove(*It);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Without any viewpoint, nobody is there to look at them
+		const EGSCCharacterSignificance Significance = Viewpoints.Num() > 0 ? ToSignificance(SignificanceManager->GetSignificance(Character)) : EGSCCharacterSignificance::Low;
+		ApplySignificance(Character, Significance);
+		NumPerBucket[(int32)Significance]++;
+	}
+
+	SET_DWORD_STAT(STAT_GSC_SignificanceHighCharacters, NumPerBucket[(int32)EGSCCharacterSignificance::High]);
+	SET_DWORD_STAT(STAT_GSC_SignificanceMediumCharacters, NumPerBucket[(int32)EGSCCharacterSignificance::Medium]);
+	SET_DWORD_STAT(STAT_GSC_SignificanceLowCharacters, NumPerBucket[(int32)EGSCCharacterSignificance::Low]);
+}
+
+void UGSCSignificanceSubsystem::OnCharacterMontageStarted(ACharacter* Character)
+{
+	if (!Character || !Character->HasAuthority() || !RegisteredCharacters.Contains(Character))
+	{
+		return;
+	}
+
+	// Montage override in ApplySignificance kicks in now that a montage is playing
+	ApplySignificance(Character, GetCharacterSignificance(Character));
+}
+
+void UGSCSignificanceSubsystem::AddMontageListener(ACharacter* Character)
+{
+	// Montage override only applies on authority
+	if (!Character->HasAuthority() || MontageListeners.Contains(Character))
+	{
+		return;
+	}
+
+	const USkeletalMeshComponent* Mesh = Character->GetMesh();
+	UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+	if (!AnimInstance)
+	{
+		GSC_LOG(Verbose, TEXT("UGSCSignificanceSubsystem::AddMontageListener() No anim instance for %s, montages are only handled on significance updates"), *Character->GetName())
+		return;
+	}
+
+	UGSCSignificanceMontageListener* Listener = NewObject<UGSCSignificanceMontageListener>(this);
+	Listener->Character = Character;
+	Listener->AnimInstance = AnimInstance;
+	AnimInstance->OnMontageStarted.AddDynamic(Listener, &UGSCSignificanceMontageListener::OnMontageStarted);
+	MontageListeners.Add(Character, TStrongObjectPtr<UGSCSignificanceMontageListener>(Listener));
+}
+
+void UGSCSignificanceSubsystem::RemoveMontageListener(ACharacter* Character)
+{
+	TStrongObjectPtr<UGSCSignificanceMontageListener> Listener;
+	if (!MontageListeners.RemoveAndCopyValue(Character, Listener))
+	{
+		return;
+	}
+
+	if (UAnimInstance* AnimInstance = Listener->AnimInstance.Get())
+	{
+		AnimInstance->OnMontageStarted.RemoveDynamic(Listener.Get(), &UGSCSignificanceMontageListener::OnMontageStarted);
+	}
+}
+
+float UGSCSignificanceSubsystem::CalculateSignificance(const ACharacter* Character, const FTransform& Viewpoint) const
+{
+	if (Character->IsLocallyControlled())
+	{
+		return ToSignificanceValue(EGSCCharacterSignificance::High);
+	}
+
+	if (ForcedSignificance.IsSet())
+	{
+		return ToSignificanceValue(ForcedSignificance.GetValue());
+	}
+
+	const UGSCDeveloperSettings* Settings = GetDefault<UGSCDeveloperSettings>();
+	const float DistanceSquared = FVector::DistSquared(Character->GetActorLocation(), Viewpoint.GetLocation());
+
+	// Nothing is ever rendered on a dedicated server, rely on distance only there
+	const USkeletalMeshComponent* Mesh = Character->GetMesh();
+	const bool bRendered = IsRunningDedicatedServer() || (Mesh && Mesh->WasRecentlyRendered(0.2f));
+
+	EGSCCharacterSignificance Significance = EGSCCharacterSignificance::Low;
+	if (DistanceSquared <= FMath::Square(Settings->HighSignificanceDistance))
+	{
+		Significance = bRendered ? EGSCCharacterSignificance::High : EGSCCharacterSignificance::Medium;
+	}
+	else if (DistanceSquared <= FMath::Square(Settings->MediumSignificanceDistance))
+	{
+		Significance = bRendered ? EGSCCharacterSignificance::Medium : EGSCCharacterSignificance::Low;
+	}
+
+	return ToSignificanceValue(Significance);
+}
+
+void UGSCSignificanceSubsystem::ApplySignificance(ACharacter* Character, const EGSCCharacterSignificance Significance) const
+{
+	const FGSCCharacterSignificanceSettings& Settings = GetDefault<UGSCDeveloperSettings>()->GetSignificanceSettings(Significance);
+
+	float ActorTickInterval = Settings.ActorTickInterval;
+	float MeshTickInterval = Settings.MeshTickInterval;
+	EVisibilityBasedAnimTickOption TickOption = Settings.VisibilityBasedAnimTickOption;
+
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	if (!Mesh)
+	{
+		return;
+	}
+
+	// Montages drive gameplay on authority (notifies, root motion, combo windows), keep them accurate even off screen
+	const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (Character->HasAuthority() && AnimInstance && AnimInstance->IsAnyMontagePlaying())
+	{
+		ActorTickInterval = 0.f;
+		MeshTickInterval = 0.f;
+		TickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	}
+
+	if (Character->GetActorTickInterval() != ActorTickInterval)
+	{
+		Character->SetActorTickInterval(ActorTickInterval);
+	}
+
+	if (Mesh->GetComponentTickInterval() != MeshTickInterval)
+	{
+		Mesh->SetComponentTickInterval(MeshTickInterval);
+	}
+
+	Mesh->VisibilityBasedAnimTickOption = TickOption;
+
+	// Only there once the mesh was registered with update rate optimizations enabled
+	if (Mesh->AnimUpdateRateParams)
+	{
+		Mesh->AnimUpdateRateParams->BaseNonRenderedUpdateRate = FMath::Max(Settings.NonRenderedAnimUpdateRate, 1);
+	}
+}
+
+EGSCCharacterSignificance UGSCSignificanceSubsystem::ToSignificance(const float SignificanceValue)
+{
+	// Values are stored so that the most significant viewpoint wins in the significance manager
+	const int32 Index = (int32)EGSCCharacterSignificance::Low - FMath::RoundToInt(SignificanceValue);
+	return (EGSCCharacterSignificance)FMath::Clamp(Index, 0, (int32)EGSCCharacterSignificance::Low);
+}
+
+float UGSCSignificanceSubsystem::ToSignificanceValue(const EGSCCharacterSignificance Significance)
+{
+	return (float)((int32)EGSCCharacterSignificance::Low - (int32)Significance);
+}
+
+void UGSCSignificanceSubsystem::RunCrowdBenchmark(const TArray<ACharacter*>& Characters, const int32 FramesPerBucket)
+{
+	if (CrowdBenchmark.IsSet())
+	{
+		GSC_LOG(Warning, TEXT("UGSCSignificanceSubsystem::RunCrowdBenchmark() A benchmark is already running"))
+		return;
+	}
+
+	FCrowdBenchmark& Benchmark = CrowdBenchmark.Emplace();
+	Benchmark.FramesPerBucket = FMath::Max(FramesPerBucket, 1);
+	Benchmark.Characters.Append(Characters);
+
+	SetForcedSignificance(EGSCCharacterSignificance::High);
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UGSCSignificanceSubsystem::TickCrowdBenchmark);
+}
+
+void UGSCSignificanceSubsystem::TickCrowdBenchmark()
+{
+	if (!CrowdBenchmark.IsSet())
+	{
+		return;
+	}
+
+	FCrowdBenchmark& Benchmark = CrowdBenchmark.GetValue();
+
+	// Skip the first frames of each bucket, to measure with the new tick intervals settled
+	static constexpr int32 WarmupFrames = 2;
+	if (Benchmark.Frame >= WarmupFrames)
+	{
+		Benchmark.GameThreadMs[Benchmark.Bucket] += FPlatformTime::ToMilliseconds(GGameThreadTime);
+		Benchmark.FrameMs[Benchmark.Bucket] += FApp::GetDeltaTime() * 1000.0;
+	}
+
+	if (++Benchmark.Frame < Benchmark.FramesPerBucket + WarmupFrames)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UGSCSignificanceSubsystem::TickCrowdBenchmark);
+		return;
+	}
+
+	Benchmark.Frame = 0;
+	if (++Benchmark.Bucket < (int32)EGSCCharacterSignificance::MAX)
+	{
+		SetForcedSignificance((EGSCCharacterSignificance)Benchmark.Bucket);
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UGSCSignificanceSubsystem::TickCrowdBenchmark);
+		return;
+	}
+
+	const UEnum* SignificanceEnum = StaticEnum<EGSCCharacterSignificance>();
+	GSC_LOG(Display, TEXT("UGSCSignificanceSubsystem::RunCrowdBenchmark() %d characters, %d frames per bucket"), Benchmark.Characters.Num(), Benchmark.FramesPerBucket)
+	for (int32 Bucket = 0; Bucket < (int32)EGSCCharacterSignificance::MAX; ++Bucket)
+	{
+		GSC_LOG(
+			Display,
+			TEXT("\t%s - Game thread: %.3f ms/frame, Frame: %.3f ms/frame"),
+			*SignificanceEnum->GetNameStringByValue(Bucket),
+			Benchmark.GameThreadMs[Bucket] / Benchmark.FramesPerBucket,
+			Benchmark.FrameMs[Bucket] / Benchmark.FramesPerBucket
+		)
+	}
+
+	for (const TWeakObjectPtr<ACharacter>& Character : Benchmark.Characters)
+	{
+		if (Character.IsValid())
+		{
+			Character->Destroy();
+		}
+	}
+
+	CrowdBenchmark.Reset();
+	ClearForcedSignificance();
+}
@@ -0,0 +1,163 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Abilities/GSCAbilitySystemComponent.h"
+#include "Components/GSCAbilityQueueComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Tests/GSCTestTypes.h"
+#include "Tests/GSCTestWorld.h"
+
+namespace GSCAbilityQueueTest
+{
+	/** Inputs recorded while playing, replayed against an ability queue component */
+	struct FRecordedStream
+	{
+		const TCHAR* Name;
+		int32 Capacity;
+		float ExpiryTime;
+
+		/** Abilities allowed by the queue window each ability opens, eg. "A:BC B:A", all of them for abilities not listed */
+		const TCHAR* Windows;
+
+		/** "<Time> <Event>" comma separated. Event is an ability letter for its input, '!' to end the active ability, ']' to close the queue window */
+		const TCHAR* Inputs;
+
+		/** Letters of the abilities activated, in order */
+		const TCHAR* Expected;
+	};
+
+	static const FRecordedStream Streams[] = {
+		{ TEXT("Single buffered input"), 4, 0.f, TEXT(""), TEXT("0 A, 0.1 B, 0.3 !, 0.5 !"), TEXT("AB") },
+		{ TEXT("Inputs faster than abilities"), 4, 0.f, TEXT(""), TEXT("0 A, 0.1 B, 0.15 C, 0.2 !, 0.3 !, 0.4 !"), TEXT("ABC") },
+		{ TEXT("Full queue drops the oldest input"), 2, 0.f, TEXT(""), TEXT("0 A, 0.1 B, 0.11 C, 0.12 B, 0.2 !, 0.3 !, 0.4 !"), TEXT("ACB") },
+		{ TEXT("Expired input"), 4, 0.5f, TEXT(""), TEXT("0 A, 0.1 B, 1 !, 1.1 C, 1.2 !"), TEXT("AC") },
+		{ TEXT("Input not allowed by the window"), 4, 0.f, TEXT("A:AC"), TEXT("0 A, 0.1 B, 0.2 C, 0.3 !, 0.4 !"), TEXT("AC") },
+		{ TEXT("Input not allowed by the next window"), 4, 0.f, TEXT("A:BC B:A"), TEXT("0 A, 0.1 B, 0.2 C, 0.3 !, 0.4 !, 0.5 !"), TEXT("AB") },
+		{ TEXT("Input after the window closed"), 4, 0.f, TEXT(""), TEXT("0 A, 0.1 ], 0.2 B, 0.3 !"), TEXT("A") },
+	};
+
+	static TSubclassOf<UGSCTestQueueAbility> GetAbilityClass(const TCHAR Letter)
+	{
+		switch (Letter)
+		{
+			case 'A': return UGSCTestQueueAbility_A::StaticClass();
+			case 'B': return UGSCTestQueueAbility_B::StaticClass();
+			case 'C': return UGSCTestQueueAbility_C::StaticClass();
+			default: return nullptr;
+		}
+	}
+
+	static TCHAR GetAbilityLetter(const UGameplayAbility* Ability)
+	{
+		for (const TCHAR Letter : { 'A', 'B', 'C' })
+		{
+			if (Ability && Ability->GetClass() == GetAbilityClass(Letter))
+			{
+				return Letter;
+			}
+		}
+		return '?';
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSCAbilityQueueRecordedStreamsTest, "GASCompanion.AbilityQueue.RecordedStreams", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGSCAbilityQueueRecordedStreamsTest::RunTest(const FString& Parameters)
+{
+	using namespace GSCAbilityQueueTest;
+
+	for (const FRecordedStream& Stream : Streams)
+	{
+		FGSCTestWorld TestWorld;
+		UGSCAbilitySystemComponent* ASC = TestWorld.SpawnAbilitySystemActor<UGSCAbilitySystemComponent, APawn>();
+		APawn* Pawn = CastChecked<APawn>(ASC->GetOwner());
+
+		// Capacity is applied on register
+		UGSCAbilityQueueComponent* AbilityQueueComponent = NewObject<UGSCAbilityQueueComponent>(Pawn);
+		AbilityQueueComponent->AbilityQueueCapacity = Stream.Capacity;
+		AbilityQueueComponent->AbilityQueueExpiryTime = Stream.ExpiryTime;
+		AbilityQueueComponent->RegisterComponent();
+		if (!TestEqual(FString::Printf(TEXT("%s: ability queue component set up with the pawn ability system"), Stream.Name), AbilityQueueComponent->OwnerAbilitySystemComponent, static_cast<UAbilitySystemComponent*>(ASC)))
+		{
+			return false;
+		}
+
+		for (const TCHAR Letter : { 'A', 'B', 'C' })
+		{
+			ASC->GiveAbility(FGameplayAbilitySpec(GetAbilityClass(Letter), 1));
+		}
+
+		TArray<FString> Windows;
+		FString(Stream.Windows).ParseIntoArrayWS(Windows);
+		for (const FString& Window : Windows)
+		{
+			FString Letter;
+			FString AllowedLetters;
+			Window.Split(TEXT(":"), &Letter, &AllowedLetters);
+
+			const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromClass(GetAbilityClass(Letter[0]));
+			UGSCTestQueueAbility* Ability = Spec ? Cast<UGSCTestQueueAbility>(Spec->GetPrimaryInstance()) : nullptr;
+			if (!TestNotNull(FString::Printf(TEXT("%s: ability %s instanced"), Stream.Name, *Letter), Ability))
+			{
+				return false;
+			}
+
+			for (const TCHAR AllowedLetter : AllowedLetters)
+			{
+				Ability->QueueAllowedAbilities.Add(GetAbilityClass(AllowedLetter));
+			}
+		}
+
+		FString Activated;
+		ASC->AbilityActivatedCallbacks.AddLambda([&Activated](UGameplayAbility* Ability)
+		{
+			Activated.AppendChar(GetAbilityLetter(Ability));
+		});
+
+		TArray<FString> Inputs;
+		FString(Stream.Inputs).ParseIntoArray(Inputs, TEXT(","));
+		for (const FString& Input : Inputs)
+		{
+			FString Time;
+			FString Event;
+			Input.TrimStartAndEnd().Split(TEXT(" "), &Time, &Event);
+			TestWorld.TickUntil(FCString::Atod(*Time));
+
+			if (Event == TEXT("!"))
+			{
+				UGSCTestQueueAbility* ActiveAbility = nullptr;
+				for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+				{
+					if (Spec.IsActive())
+					{
+						ActiveAbility = Cast<UGSCTestQueueAbility>(Spec.GetPrimaryInstance());
+						break;
+					}
+				}
+
+				if (ActiveAbility)
+				{
+					ActiveAbility->EndTestAbility();
+				}
+			}
+			else if (Event == TEXT("]"))
+			{
+				AbilityQueueComponent->CloseAbilityQueue();
+			}
+			else
+			{
+				ASC->TryActivateAbilityByClass(GetAbilityClass(Event[0]));
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("%s: activated abilities"), Stream.Name), Activated, FString(Stream.Expected));
+	}
+
+	return true;
+}
+
+#endif
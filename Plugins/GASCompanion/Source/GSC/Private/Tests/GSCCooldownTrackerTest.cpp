@@ -0,0 +1,106 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "Abilities/GSCCooldownTracker.h"
+#include "Components/GSCCoreComponent.h"
+#include "Subsystems/GSCCooldownSubsystem.h"
+#include "Tests/GSCTestTypes.h"
+#include "Tests/GSCTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSCCooldownTrackerSoakTest, "GASCompanion.Cooldowns.TrackerSoak", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGSCCooldownTrackerSoakTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCycles = 500;
+	constexpr int32 NumCommitsPerCycle = 4;
+
+	const FGameplayTagContainer& CooldownTags = UGSCTestCooldownAbility::GetTestCooldownTags();
+	if (!TestTrue(TEXT("Test cooldown tag is registered"), CooldownTags.IsValid()))
+	{
+		return false;
+	}
+
+	FGSCTestWorld TestWorld;
+	UAbilitySystemComponent* ASC = TestWorld.SpawnAbilitySystemActor();
+	AActor* Actor = ASC->GetOwner();
+
+	// Two companion components listening to cooldowns of the same ASC
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		UGSCCoreComponent* CoreComponent = FGSCTestWorld::AddComponent<UGSCCoreComponent>(Actor);
+		CoreComponent->SetupAbilityActor(ASC, Actor, Actor);
+	}
+
+	const TSharedPtr<FGSCCooldownTracker> Tracker = UGSCCooldownSubsystem::GetCooldownTracker(ASC);
+	if (!TestTrue(TEXT("Cooldown tracker is created for the ASC"), Tracker.IsValid()))
+	{
+		return false;
+	}
+
+	int32 NumStarts = 0;
+	int32 NumEnds = 0;
+	const FDelegateHandle StartHandle = Tracker->OnCooldownStart.AddLambda([&NumStarts](FGameplayAbilitySpecHandle, UGameplayAbility*, const FGameplayTagContainer&, float, float)
+	{
+		++NumStarts;
+	});
+	const FDelegateHandle EndHandle = Tracker->OnCooldownEnd.AddLambda([&NumEnds](FGameplayAbilitySpecHandle, UGameplayAbility*, const FGameplayTag&, float)
+	{
+		++NumEnds;
+	});
+
+	const FOnGameplayEffectTagCountChanged& TagEvent = ASC->RegisterGameplayTagEvent(CooldownTags.First(), EGameplayTagEventType::NewOrRemoved);
+	SIZE_T TagEventSize = 0;
+	SIZE_T CommitCallbacksSize = 0;
+
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(FGameplayAbilitySpec(UGSCTestCooldownAbility::StaticClass()));
+
+		// Rapid fire, committing again while cooldown tag is still there
+		for (int32 Commit = 0; Commit < NumCommitsPerCycle; ++Commit)
+		{
+			ASC->TryActivateAbility(Handle);
+		}
+
+		const int32 NumTagSubscriptions = Tracker->NumTagSubscriptions();
+		const int32 NumTrackedCooldowns = Tracker->NumTrackedCooldowns();
+
+		// Cooldown expires, then ability is removed
+		ASC->RemoveActiveEffectsWithGrantedTags(CooldownTags);
+		const int32 NumTrackedCooldownsAfterEnd = Tracker->NumTrackedCooldowns();
+		ASC->ClearAbility(Handle);
+
+		if (Cycle == 0)
+		{
+			TagEventSize = TagEvent.GetAllocatedSize();
+			CommitCallbacksSize = ASC->AbilityCommittedCallbacks.GetAllocatedSize();
+		}
+
+		if (NumTagSubscriptions != 1 || NumTrackedCooldowns != 1 || NumTrackedCooldownsAfterEnd != 0)
+		{
+			AddError(FString::Printf(TEXT("Cycle %d: %d tag subscription(s) and %d tracked cooldown(s) while on cooldown (expected 1 and 1), %d after cooldown end (expected 0)"), Cycle, NumTagSubscriptions, NumTrackedCooldowns, NumTrackedCooldownsAfterEnd));
+			break;
+		}
+
+		if (TagEvent.GetAllocatedSize() != TagEventSize || ASC->AbilityCommittedCallbacks.GetAllocatedSize() != CommitCallbacksSize)
+		{
+			AddError(FString::Printf(TEXT("Cycle %d: ASC delegate lists grew (cooldown tag event: %d -> %d bytes, ability committed: %d -> %d bytes)"), Cycle, static_cast<int32>(TagEventSize), static_cast<int32>(TagEvent.GetAllocatedSize()), static_cast<int32>(CommitCallbacksSize), static_cast<int32>(ASC->AbilityCommittedCallbacks.GetAllocatedSize())));
+			break;
+		}
+	}
+
+	TestEqual(TEXT("OnCooldownStart is broadcast on every commit"), NumStarts, NumCycles * NumCommitsPerCycle);
+	TestEqual(TEXT("OnCooldownEnd is broadcast once per cooldown end"), NumEnds, NumCycles);
+	TestTrue(TEXT("Listeners of the same ASC share its tracker"), UGSCCooldownSubsystem::GetCooldownTracker(ASC) == Tracker);
+
+	Tracker->OnCooldownStart.Remove(StartHandle);
+	Tracker->OnCooldownEnd.Remove(EndHandle);
+	return true;
+}
+
+#endif
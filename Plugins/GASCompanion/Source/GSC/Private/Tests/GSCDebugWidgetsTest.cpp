@@ -0,0 +1,136 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/GSCAbilityQueueComponent.h"
+#include "Components/GSCComboManagerComponent.h"
+#include "Components/TextBlock.h"
+#include "Core/GSCAllocationCounter.h"
+#include "Tests/GSCTestTypes.h"
+#include "Tests/GSCTestWorld.h"
+#include "UI/GSCUWDebugComboWidget.h"
+#include "UObject/UObjectHash.h"
+
+namespace GSCDebugWidgetsTest
+{
+	/** Number of objects owned by Outer once garbage is collected, removed rows and their slots included until then */
+	static int32 GetNumLiveOwnedObjects(const UObject* Outer)
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		TArray<UObject*> Objects;
+		GetObjectsWithOuter(Outer, Objects, true);
+		return Objects.Num();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSCDebugWidgetsSoakTest, "GASCompanion.DebugWidgets.Soak", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGSCDebugWidgetsSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace GSCDebugWidgetsTest;
+
+	constexpr int32 NumIterations = 100000;
+	constexpr int32 NumIterationsPerFrame = 100;
+	constexpr float FrameDeltaSeconds = 0.05f;
+
+	FGSCTestWorld TestWorld;
+	AActor* Actor = TestWorld.SpawnActor();
+	UGSCAbilityQueueComponent* AbilityQueueComponent = FGSCTestWorld::AddComponent<UGSCAbilityQueueComponent>(Actor);
+	FGSCTestWorld::AddComponent<UGSCComboManagerComponent>(Actor);
+
+	UGSCTestDebugAbilityQueueWidget* AbilityQueueWidget = CreateWidget<UGSCTestDebugAbilityQueueWidget>(TestWorld.World);
+	UGSCUWDebugComboWidget* ComboWidget = CreateWidget<UGSCUWDebugComboWidget>(TestWorld.World);
+	if (!TestTrue(TEXT("Debug widgets are created"), AbilityQueueWidget && ComboWidget))
+	{
+		return false;
+	}
+
+	// Not added to the viewport, kept alive through garbage collection by hand
+	AbilityQueueWidget->AddToRoot();
+	ComboWidget->AddToRoot();
+
+	AbilityQueueWidget->CreateBoundWidgets();
+	ComboWidget->ComboWindowOpenedText = ComboWidget->WidgetTree->ConstructWidget<UTextBlock>();
+	ComboWidget->ShouldTriggerComboText = ComboWidget->WidgetTree->ConstructWidget<UTextBlock>();
+	ComboWidget->RequestTriggerComboText = ComboWidget->WidgetTree->ConstructWidget<UTextBlock>();
+	ComboWidget->NextComboAbilityActivatedText = ComboWidget->WidgetTree->ConstructWidget<UTextBlock>();
+	ComboWidget->ComboIndexText = ComboWidget->WidgetTree->ConstructWidget<UTextBlock>();
+	AbilityQueueWidget->SetOwnerActor(Actor);
+	ComboWidget->SetOwnerActor(Actor);
+
+	// Rows added much faster than they are cleared, with the queue state changing on every refresh
+	int32 MaxRows = 0;
+	bool bPendingClearsWithinRows = true;
+	int32 NumOwnedObjectsAtHalf = 0;
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		if (Iteration % 2 == 0)
+		{
+			AbilityQueueComponent->OpenAbilityQueue();
+		}
+		else
+		{
+			AbilityQueueComponent->CloseAbilityQueue();
+		}
+
+		AbilityQueueWidget->AddAbilityQueueFromMontageRow(nullptr, true);
+		AbilityQueueWidget->RefreshDebugState();
+		ComboWidget->RefreshDebugState();
+
+		MaxRows = FMath::Max(MaxRows, AbilityQueueWidget->GetNumFromMontageRows());
+		bPendingClearsWithinRows &= AbilityQueueWidget->GetNumPendingFromMontageRowClears() <= AbilityQueueWidget->GetNumFromMontageRows();
+
+		if ((Iteration + 1) % NumIterationsPerFrame == 0)
+		{
+			TestWorld.Tick(FrameDeltaSeconds);
+		}
+
+		if (Iteration == NumIterations / 2)
+		{
+			NumOwnedObjectsAtHalf = GetNumLiveOwnedObjects(AbilityQueueWidget);
+		}
+	}
+
+	const int32 NumOwnedObjects = GetNumLiveOwnedObjects(AbilityQueueWidget);
+	AddInfo(FString::Printf(TEXT("%d iterations - Max rows: %d, objects owned by the widget: %d (%d at half)"), NumIterations, MaxRows, NumOwnedObjects, NumOwnedObjectsAtHalf));
+
+	TestTrue(TEXT("Rows are capped to MaxFromMontageRows"), MaxRows > 0 && MaxRows <= AbilityQueueWidget->GetMaxFromMontageRows());
+	TestTrue(TEXT("Pending clears never outnumber rows"), bPendingClearsWithinRows);
+	TestEqual(TEXT("Objects owned by the widget don't grow with rows added"), NumOwnedObjects, NumOwnedObjectsAtHalf);
+
+#if GSC_WITH_ALLOCATION_COUNTER
+	// Nothing changed since last refresh, no text to update
+	constexpr int32 NumUnchangedRefreshes = 1000;
+	int32 NumRefreshAllocations;
+	{
+		FGSCScopedAllocationCounter AllocationCounter;
+		for (int32 Index = 0; Index < NumUnchangedRefreshes; ++Index)
+		{
+			AbilityQueueWidget->RefreshDebugState();
+			ComboWidget->RefreshDebugState();
+		}
+		NumRefreshAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	AddInfo(FString::Printf(TEXT("%d allocations for %d refreshes with unchanged state"), NumRefreshAllocations, NumUnchangedRefreshes));
+	TestTrue(TEXT("Refreshing unchanged state doesn't allocate per refresh"), NumRefreshAllocations < NumUnchangedRefreshes / 10);
+#endif
+
+	// Every row is eventually cleared, along with its pending clear
+	TestWorld.TickUntil(TestWorld.World->GetTimeSeconds() + AbilityQueueWidget->GetClearFromMontageDelay() + 1.f);
+	TestEqual(TEXT("Rows are cleared after the clear delay"), AbilityQueueWidget->GetNumFromMontageRows(), 0);
+	TestEqual(TEXT("No pending clear left"), AbilityQueueWidget->GetNumPendingFromMontageRowClears(), 0);
+
+	AbilityQueueWidget->RemoveFromRoot();
+	ComboWidget->RemoveFromRoot();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Abilities/GSCTypes.h"
+#include "Abilities/Attributes/GSCAttributeSet.h"
+#include "Tests/GSCTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSCEffectContainerApplyTest, "GASCompanion.EffectContainer.ApplyToTargets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGSCEffectContainerApplyTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumTargets = 20;
+	constexpr int32 NumEffects = 4;
+
+	FGSCTestWorld TestWorld;
+	UAbilitySystemComponent* InstigatorASC = TestWorld.SpawnAbilitySystemActor();
+
+	// Half of the targets hit by a trace, the other half as actors
+	TArray<UAbilitySystemComponent*> AbilitySystemComponents;
+	TArray<FHitResult> HitResults;
+	TArray<AActor*> TargetActors;
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		UAbilitySystemComponent* ASC = TestWorld.SpawnAbilitySystemActor();
+		ASC->InitStats(UGSCAttributeSet::StaticClass(), nullptr);
+		AbilitySystemComponents.Add(ASC);
+
+		if (Index % 2 == 0)
+		{
+			FHitResult& HitResult = HitResults.AddDefaulted_GetRef();
+			HitResult.Actor = ASC->GetOwner();
+			HitResult.Location = FVector(Index, 0.f, 0.f);
+			HitResult.bBlockingHit = true;
+		}
+		else
+		{
+			TargetActors.Add(ASC->GetOwner());
+		}
+	}
+
+	// Target data built the way AddTargets used to: one single target hit per hit and an actor array
+	FGameplayAbilityTargetDataHandle BaselineTargetData;
+	for (const FHitResult& HitResult : HitResults)
+	{
+		BaselineTargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+	}
+	FGameplayAbilityTargetData_ActorArray* BaselineActorArray = new FGameplayAbilityTargetData_ActorArray();
+	BaselineActorArray->TargetActorArray.Append(TargetActors);
+	BaselineTargetData.Add(BaselineActorArray);
+
+	// Instant damage and stamina drain effects, additive and multiplicative so that application order matters
+	FGSCGameplayEffectContainerSpec ContainerSpec;
+	FGSCGameplayEffectContainerSpec PackedContainerSpec;
+	ContainerSpec.AddTargets(HitResults, TargetActors);
+	PackedContainerSpec.AddTargets(HitResults, TargetActors, true);
+	for (int32 Index = 0; Index < NumEffects; ++Index)
+	{
+		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+		Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+		FGameplayModifierInfo& Damage = Effect->Modifiers.AddDefaulted_GetRef();
+		Damage.Attribute = UGSCAttributeSet::GetHealthAttribute();
+		Damage.ModifierOp = Index % 2 == 0 ? EGameplayModOp::Additive : EGameplayModOp::Multiplicitive;
+		Damage.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Index % 2 == 0 ? -1.f - Index : 0.95f));
+
+		FGameplayModifierInfo& Drain = Effect->Modifiers.AddDefaulted_GetRef();
+		Drain.Attribute = UGSCAttributeSet::GetStaminaAttribute();
+		Drain.ModifierOp = EGameplayModOp::Additive;
+		Drain.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(-2.f));
+
+		ContainerSpec.TargetGameplayEffectSpecs.Add(FGameplayEffectSpecHandle(new FGameplayEffectSpec(Effect, InstigatorASC->MakeEffectContext(), 1.f)));
+	}
+	PackedContainerSpec.TargetGameplayEffectSpecs = ContainerSpec.TargetGameplayEffectSpecs;
+
+	const auto ResetAttributes = [&AbilitySystemComponents]()
+	{
+		for (UAbilitySystemComponent* ASC : AbilitySystemComponents)
+		{
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetMaxHealthAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetMaxStaminaAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetHealthAttribute(), 1000.f);
+			ASC->SetNumericAttributeBase(UGSCAttributeSet::GetStaminaAttribute(), 1000.f);
+		}
+	};
+
+	const auto SnapshotAttributes = [&AbilitySystemComponents]()
+	{
+		TArray<float> Values;
+		for (const UAbilitySystemComponent* ASC : AbilitySystemComponents)
+		{
+			Values.Add(ASC->GetNumericAttribute(UGSCAttributeSet::GetHealthAttribute()));
+			Values.Add(ASC->GetNumericAttribute(UGSCAttributeSet::GetStaminaAttribute()));
+		}
+		return Values;
+	};
+
+	// Baseline, what UGSCGameplayAbility::ApplyEffectContainerSpec used to do: each spec applied to the target data in turn
+	ResetAttributes();
+	int32 NumBaselineApplied = 0;
+	for (const FGameplayEffectSpecHandle& SpecHandle : ContainerSpec.TargetGameplayEffectSpecs)
+	{
+		for (const TSharedPtr<FGameplayAbilityTargetData>& Data : BaselineTargetData.Data)
+		{
+			NumBaselineApplied += Data->ApplyGameplayEffectSpec(*SpecHandle.Data.Get(), FPredictionKey()).Num();
+		}
+	}
+	const TArray<float> BaselineValues = SnapshotAttributes();
+
+	TestEqual(TEXT("Baseline applies every effect to every target"), NumBaselineApplied, NumTargets * NumEffects);
+	TestTrue(TEXT("Effects modified attributes"), BaselineValues[0] != 1000.f);
+
+	ResetAttributes();
+	TestEqual(TEXT("Batched application applies every effect to every target"), ContainerSpec.ApplyToTargets(FPredictionKey()).Num(), NumBaselineApplied);
+	TestEqual(TEXT("Batched application attribute values"), SnapshotAttributes(), BaselineValues);
+
+	ResetAttributes();
+	TestEqual(TEXT("Batched application with packed hit results applies every effect to every target"), PackedContainerSpec.ApplyToTargets(FPredictionKey()).Num(), NumBaselineApplied);
+	TestEqual(TEXT("Batched application with packed hit results attribute values"), SnapshotAttributes(), BaselineValues);
+
+	return true;
+}
+
+#endif
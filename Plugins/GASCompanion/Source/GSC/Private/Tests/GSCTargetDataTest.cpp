@@ -0,0 +1,104 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Abilities/GSCTypes.h"
+#include "Core/GSCAllocationCounter.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSCTargetDataAllocationTest, "GASCompanion.TargetData.Allocations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGSCTargetDataAllocationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumHits = 500;
+
+	TArray<FHitResult> HitResults;
+	HitResults.SetNum(NumHits);
+	for (int32 Index = 0; Index < NumHits; ++Index)
+	{
+		HitResults[Index].Location = FVector(Index, 0.f, 0.f);
+		HitResults[Index].ImpactPoint = HitResults[Index].Location;
+		HitResults[Index].bBlockingHit = true;
+	}
+
+	const TArray<AActor*> NoActors;
+
+	// Default: one single target hit per hit, as consumers of the target data handle expect
+	FGSCGameplayEffectContainerSpec PerHitSpec;
+	FGSCGameplayEffectContainerSpec PackedSpec;
+#if GSC_WITH_ALLOCATION_COUNTER
+	int32 PerHitAllocations;
+	int32 PackedAllocations;
+	{
+		FGSCScopedAllocationCounter AllocationCounter;
+		PerHitSpec.AddTargets(HitResults, NoActors);
+		PerHitAllocations = AllocationCounter.GetNumAllocations();
+	}
+	{
+		FGSCScopedAllocationCounter AllocationCounter;
+		PackedSpec.AddTargets(HitResults, NoActors, true);
+		PackedAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	AddInfo(FString::Printf(TEXT("%d hits - %d allocations with one target data per hit, %d with packed hit results"), NumHits, PerHitAllocations, PackedAllocations));
+
+	// Target data and its hit array, the shared pointer reference controller and the target data handle array
+	TestTrue(TEXT("Packed hit results allocate a constant number of times"), PackedAllocations <= 4);
+	TestTrue(TEXT("One target data per hit allocates for each hit"), PerHitAllocations >= NumHits);
+#else
+	PerHitSpec.AddTargets(HitResults, NoActors);
+	PackedSpec.AddTargets(HitResults, NoActors, true);
+	AddWarning(TEXT("Allocation counter not available on this platform, only checking target data contents"));
+#endif
+
+	TestEqual(TEXT("One target data per hit by default"), UAbilitySystemBlueprintLibrary::GetDataCountFromTargetData(PerHitSpec.TargetData), NumHits);
+	bool bAllSingleTargetHits = true;
+	for (int32 Index = 0; Index < PerHitSpec.TargetData.Num(); ++Index)
+	{
+		const FGameplayAbilityTargetData* Data = PerHitSpec.TargetData.Get(Index);
+		bAllSingleTargetHits &= Data && Data->GetScriptStruct() == FGameplayAbilityTargetData_SingleTargetHit::StaticStruct() && Data->GetHitResult()->Location == HitResults[Index].Location;
+	}
+	TestTrue(TEXT("Each hit is a single target hit, in order"), bAllSingleTargetHits);
+
+	if (!TestEqual(TEXT("Packed hit results fit in one target data"), PackedSpec.TargetData.Num(), 1))
+	{
+		return false;
+	}
+
+	const FGameplayAbilityTargetData* PackedData = PackedSpec.TargetData.Get(0);
+	if (!TestTrue(TEXT("Packed hit results are a multi hit target data"), PackedData && PackedData->GetScriptStruct() == FGSCGameplayAbilityTargetData_MultiHit::StaticStruct()))
+	{
+		return false;
+	}
+
+	// Replication round trip
+	FGSCGameplayAbilityTargetData_MultiHit& MultiHit = *static_cast<FGSCGameplayAbilityTargetData_MultiHit*>(PackedSpec.TargetData.Data[0].Get());
+	FBitWriter Writer(0, true);
+	bool bWriteSuccess = false;
+	MultiHit.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	FGSCGameplayAbilityTargetData_MultiHit Received;
+	bool bReadSuccess = false;
+	Received.NetSerialize(Reader, nullptr, bReadSuccess);
+
+	TestTrue(TEXT("Multi hit target data serializes"), bWriteSuccess && bReadSuccess && !Reader.IsError());
+	if (TestEqual(TEXT("Every hit is replicated"), Received.GetHitResults().Num(), NumHits))
+	{
+		bool bSameLocations = true;
+		for (int32 Index = 0; Index < NumHits; ++Index)
+		{
+			bSameLocations &= Received.GetHitResults()[Index].Location.Equals(HitResults[Index].Location);
+		}
+		TestTrue(TEXT("Replicated hits keep their location, in order"), bSameLocations);
+	}
+
+	return true;
+}
+
+#endif
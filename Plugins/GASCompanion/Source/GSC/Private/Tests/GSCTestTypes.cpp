@@ -0,0 +1,154 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Tests/GSCTestTypes.h"
+
+#include "AbilitySystemComponent.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+#include "GameplayTagsManager.h"
+#include "Abilities/GSCBlueprintFunctionLibrary.h"
+#include "Components/GSCAbilityQueueComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+/** Tags used by automation tests, not registered in builds without them */
+struct FGSCTestTags : public FGameplayTagNativeAdder
+{
+	FGameplayTagContainer CooldownTags;
+
+	virtual void AddTags() override
+	{
+		CooldownTags.AddTag(UGameplayTagsManager::Get().AddNativeGameplayTag(TEXT("GASCompanion.Test.Cooldown"), TEXT("GAS Companion automation tests")));
+	}
+
+	static FGSCTestTags Tags;
+};
+
+FGSCTestTags FGSCTestTags::Tags;
+#endif
+
+UGSCTestCooldownEffect::UGSCTestCooldownEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(10.f));
+}
+
+UGSCTestCooldownAbility::UGSCTestCooldownAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+	CooldownGameplayEffectClass = UGSCTestCooldownEffect::StaticClass();
+}
+
+const FGameplayTagContainer& UGSCTestCooldownAbility::GetTestCooldownTags()
+{
+#if WITH_DEV_AUTOMATION_TESTS
+	return FGSCTestTags::Tags.CooldownTags;
+#else
+	return FGameplayTagContainer::EmptyContainer;
+#endif
+}
+
+const FGameplayTagContainer* UGSCTestCooldownAbility::GetCooldownTags() const
+{
+	return &GetTestCooldownTags();
+}
+
+bool UGSCTestCooldownAbility::CheckCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	return true;
+}
+
+void UGSCTestCooldownAbility::ApplyCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const
+{
+	const UGameplayEffect* CooldownEffect = GetCooldownGameplayEffect();
+	if (!CooldownEffect)
+	{
+		return;
+	}
+
+	const FGameplayEffectSpecHandle SpecHandle = MakeOutgoingGameplayEffectSpec(Handle, ActorInfo, ActivationInfo, CooldownEffect->GetClass(), GetAbilityLevel(Handle, ActorInfo));
+	if (SpecHandle.IsValid())
+	{
+		SpecHandle.Data->DynamicGrantedTags.AppendTags(GetTestCooldownTags());
+		ApplyGameplayEffectSpecToOwner(Handle, ActorInfo, ActivationInfo, SpecHandle);
+	}
+}
+
+void UGSCTestCooldownAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	const bool bCommitted = CommitAbility(Handle, ActorInfo, ActivationInfo);
+	EndAbility(Handle, ActorInfo, ActivationInfo, true, !bCommitted);
+}
+
+UGSCTestQueueAbility::UGSCTestQueueAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+	bEnableAbilityQueue = true;
+}
+
+void UGSCTestQueueAbility::EndTestAbility()
+{
+	if (IsActive())
+	{
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+	}
+}
+
+bool UGSCTestQueueAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	// Busy while one of them is active, as if blocked by its activation owned tags
+	const UAbilitySystemComponent* AbilitySystemComponent = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	if (AbilitySystemComponent)
+	{
+		for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+		{
+			if (Spec.IsActive() && Spec.Ability && Spec.Ability->IsA<UGSCTestQueueAbility>())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void UGSCTestQueueAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	if (QueueAllowedAbilities.Num() == 0)
+	{
+		return;
+	}
+
+	// Same as UGSCAbilityQueueNotifyState at the start of the ability montage
+	UGSCAbilityQueueComponent* AbilityQueueComponent = UGSCBlueprintFunctionLibrary::GetAbilityQueueComponent(GetAvatarActorFromActorInfo());
+	if (AbilityQueueComponent)
+	{
+		AbilityQueueComponent->SetAllowAllAbilitiesForAbilityQueue(false);
+		AbilityQueueComponent->UpdateAllowedAbilitiesForAbilityQueue(QueueAllowedAbilities);
+	}
+}
+
+void UGSCTestDebugAbilityQueueWidget::CreateBoundWidgets()
+{
+	check(WidgetTree);
+
+	AbilityQueueEnabledText = WidgetTree->ConstructWidget<UTextBlock>();
+	AbilityQueueOpenedText = WidgetTree->ConstructWidget<UTextBlock>();
+	CurrentQueuedAbilityText = WidgetTree->ConstructWidget<UTextBlock>();
+	AllowAllAbilitiesText = WidgetTree->ConstructWidget<UTextBlock>();
+	AllowedAbilityTemplateText = WidgetTree->ConstructWidget<UTextBlock>();
+	AbilityQueueFromMontageTemplateText = WidgetTree->ConstructWidget<UTextBlock>();
+	AllowedAbilitiesBox = WidgetTree->ConstructWidget<UVerticalBox>();
+	AbilityQueueFromMontagesBox = WidgetTree->ConstructWidget<UVerticalBox>();
+	AbilityQueueFromMontagesPanel = WidgetTree->ConstructWidget<UCanvasPanel>();
+	AbilityQueueFromMontagesPanel->AddChild(AbilityQueueFromMontagesBox);
+}
@@ -0,0 +1,103 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "Abilities/GameplayAbility.h"
+#include "Abilities/GSCGameplayAbility.h"
+#include "UI/GSCUWDebugAbilityQueue.h"
+#include "GSCTestTypes.generated.h"
+
+/** Cooldown effect of UGSCTestCooldownAbility, its cooldown tag is set on the spec */
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestCooldownEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTestCooldownEffect();
+};
+
+/**
+ * Automation tests ability, committing a cooldown as soon as it is activated then ending.
+ *
+ * Cooldown is not checked on activation, so that it can be committed again while still on cooldown (eg. rapid fire).
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestCooldownAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTestCooldownAbility();
+
+	/** Cooldown tags granted by the ability cooldown, only registered in builds with automation tests */
+	static const FGameplayTagContainer& GetTestCooldownTags();
+
+	//~ Begin UGameplayAbility interface
+	virtual const FGameplayTagContainer* GetCooldownTags() const override;
+	virtual bool CheckCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void ApplyCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const override;
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	//~ End UGameplayAbility interface
+};
+
+/**
+ * Automation tests ability for the ability queue, staying active until EndTestAbility() is called.
+ *
+ * Activation fails while another test queue ability is active, so that the ability queue can buffer it. Opens the
+ * ability queue like any companion ability with bEnableAbilityQueue, restricted to QueueAllowedAbilities if set.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestQueueAbility : public UGSCGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTestQueueAbility();
+
+	/** Abilities allowed by the ability queue window opened on activation, all of them if empty */
+	TArray<TSubclassOf<UGameplayAbility>> QueueAllowedAbilities;
+
+	/** Ends the ability, if active */
+	void EndTestAbility();
+
+	//~ Begin UGameplayAbility interface
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	//~ End UGameplayAbility interface
+};
+
+/** Ability queue replays refer to abilities by class, one per recorded input */
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestQueueAbility_A : public UGSCTestQueueAbility
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestQueueAbility_B : public UGSCTestQueueAbility
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestQueueAbility_C : public UGSCTestQueueAbility
+{
+	GENERATED_BODY()
+};
+
+/** Ability queue debug widget creating its own bound widgets, in place of a Widget Blueprint */
+UCLASS(NotBlueprintable, HideDropdown)
+class UGSCTestDebugAbilityQueueWidget : public UGSCUWDebugAbilityQueue
+{
+	GENERATED_BODY()
+
+public:
+	/** Creates the widgets bound by a Widget Blueprint, the widget must be initialized */
+	void CreateBoundWidgets();
+
+	int32 GetMaxFromMontageRows() const { return MaxFromMontageRows; }
+	float GetClearFromMontageDelay() const { return ClearFromMontageDelay; }
+};
@@ -0,0 +1,85 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+/**
+ * Game world created for the duration of an automation test, destroyed along with its actors when going out of scope.
+ *
+ * World subsystems are initialized and play has begun, world time only advances through Tick().
+ */
+struct FGSCTestWorld
+{
+	UWorld* World = nullptr;
+
+	FGSCTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		const FURL URL;
+		World->InitializeActorsForPlay(URL);
+		World->BeginPlay();
+	}
+
+	~FGSCTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FGSCTestWorld(const FGSCTestWorld&) = delete;
+	FGSCTestWorld& operator=(const FGSCTestWorld&) = delete;
+
+	/** Advances world time, timers and ticking components by DeltaSeconds */
+	void Tick(const float DeltaSeconds) const
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	/** Ticks until world time reaches Time, in steps short enough not to be clamped by the world settings max frame time */
+	void TickUntil(const double Time) const
+	{
+		for (int32 Step = 0; Step < 100000 && World->GetTimeSeconds() < Time - KINDA_SMALL_NUMBER; ++Step)
+		{
+			Tick(FMath::Min(static_cast<float>(Time - World->GetTimeSeconds()), 0.1f));
+		}
+	}
+
+	template<typename ActorType = AActor>
+	ActorType* SpawnActor() const
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		return World->SpawnActor<ActorType>(SpawnParameters);
+	}
+
+	/** Adds a registered component of the given class to Actor */
+	template<typename ComponentType>
+	static ComponentType* AddComponent(AActor* Actor)
+	{
+		ComponentType* Component = NewObject<ComponentType>(Actor);
+		Component->RegisterComponent();
+		return Component;
+	}
+
+	/** Spawns an actor owning and avatar of its own Ability System Component */
+	template<typename AbilitySystemComponentType = UAbilitySystemComponent, typename ActorType = AActor>
+	AbilitySystemComponentType* SpawnAbilitySystemActor() const
+	{
+		ActorType* Actor = SpawnActor<ActorType>();
+		AbilitySystemComponentType* ASC = AddComponent<AbilitySystemComponentType>(Actor);
+		ASC->InitAbilityActorInfo(Actor, Actor);
+		return ASC;
+	}
+};
+
+#endif
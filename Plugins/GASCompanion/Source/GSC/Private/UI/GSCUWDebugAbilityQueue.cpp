@@ -10,6 +10,7 @@
 #include "Components/GSCAbilityQueueComponent.h"
 #include "TimerManager.h"
 #include "GSCLog.h"
+#include "GSCStats.h"
 
 void UGSCUWDebugAbilityQueue::SetOwnerActor(AActor* Actor)
 {
@@ -20,44 +21,78 @@ void UGSCUWDebugAbilityQueue::SetOwnerActor(AActor* Actor)
 void UGSCUWDebugAbilityQueue::NativeConstruct()
 {
 	Super::NativeConstruct();
+
+	if (OwnerAbilityQueueComponent.IsValid())
+	{
+		bHasDisplayedState = false;
+		OwnerAbilityQueueComponent->SetDebugWidget(this);
+		RefreshDebugState();
+		UpdateAllowedAbilities(OwnerAbilityQueueComponent->GetQueuedAllowedAbilities());
+	}
+}
+
+void UGSCUWDebugAbilityQueue::NativeDestruct()
+{
+	if (OwnerAbilityQueueComponent.IsValid())
+	{
+		OwnerAbilityQueueComponent->SetDebugWidget(nullptr);
+	}
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ClearFromMontageTimerHandle);
+	}
+	ClearFromMontageTimes.Reset();
+
+	Super::NativeDestruct();
+}
+
+void UGSCUWDebugAbilityQueue::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+	RefreshDebugState();
 }
 
 void UGSCUWDebugAbilityQueue::UpdateAllowedAbilities(TArray<TSubclassOf<UGameplayAbility>> AllowedAbilities)
 {
 	if (AllowedAbilitiesBox && AllowedAbilityTemplateText)
 	{
-		GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::UpdateAllowedAbilities() clearing children"))
-		AllowedAbilitiesBox->ClearChildren();
-
+		// Rows are reused from one update to the next, only the extra ones are removed
+		int32 NumRows = 0;
 		if (OwnerAbilityQueueComponent.IsValid() && OwnerAbilityQueueComponent->IsAllAbilitiesAllowedForAbilityQueue())
 		{
 			GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::UpdateAllowedAbilities() All abilities are allowed"))
 
-			UTextBlock* Text = DuplicateObject(AllowedAbilityTemplateText, this);
-			if (Text)
+			static const FText AllText = FText::AsCultureInvariant(TEXT("All"));
+			if (UTextBlock* Text = GetOrDuplicateTextBlock(AllowedAbilitiesBox, NumRows, AllowedAbilityTemplateText))
 			{
-				Text->SetText(FText::FromString("All"));
-				AllowedAbilitiesBox->AddChild(Text);
+				Text->SetText(AllText);
+				++NumRows;
 			}
-			return;
 		}
-
-		for (const TSubclassOf<UGameplayAbility> Ability : AllowedAbilities)
+		else
 		{
-			if (!Ability)
+			for (const TSubclassOf<UGameplayAbility> Ability : AllowedAbilities)
 			{
-				continue;
-			}
+				if (!Ability)
+				{
+					continue;
+				}
 
-			GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::UpdateAllowedAbilities() Adding child for %s"), *Ability->GetName())
+				GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::UpdateAllowedAbilities() Adding child for %s"), *Ability->GetName())
 
-			UTextBlock* Text = DuplicateObject(AllowedAbilityTemplateText, this);
-			if (Text)
-			{
-				Text->SetText(FText::FromString(Ability->GetName()));
-				AllowedAbilitiesBox->AddChild(Text);
+				if (UTextBlock* Text = GetOrDuplicateTextBlock(AllowedAbilitiesBox, NumRows, AllowedAbilityTemplateText))
+				{
+					Text->SetText(FText::FromName(Ability->GetFName()));
+					++NumRows;
+				}
 			}
 		}
+
+		while (AllowedAbilitiesBox->GetChildrenCount() > NumRows)
+		{
+			AllowedAbilitiesBox->RemoveChildAt(AllowedAbilitiesBox->GetChildrenCount() - 1);
+		}
 	}
 }
 
@@ -66,14 +101,30 @@ void UGSCUWDebugAbilityQueue::AddAbilityQueueFromMontageRow(UAnimSequenceBase* A
 	if (AbilityQueueFromMontagesBox && AbilityQueueFromMontageTemplateText)
 	{
 		GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::AddAbilityQueueFromMontageRow()"))
-		// AllowedAbilitiesBox->ClearChildren();
 
-		UTextBlock* Text = DuplicateObject(AbilityQueueFromMontageTemplateText, this);
+		// Too many rows, drop the oldest one (and its pending clear) and recycle its text block for the new row
+		UTextBlock* Text = nullptr;
+		if (AbilityQueueFromMontagesBox->GetChildrenCount() >= FMath::Max(MaxFromMontageRows, 1))
+		{
+			Text = Cast<UTextBlock>(AbilityQueueFromMontagesBox->GetChildAt(0));
+			AbilityQueueFromMontagesBox->RemoveChildAt(0);
+			if (ClearFromMontageTimes.Num() > AbilityQueueFromMontagesBox->GetChildrenCount())
+			{
+				// Timer was set for the evicted row, move it to the next one
+				ClearFromMontageTimes.RemoveAt(0, 1, false);
+				ScheduleClearFromMontageRow();
+			}
+		}
+
+		if (!Text)
+		{
+			Text = DuplicateObject(AbilityQueueFromMontageTemplateText, this);
+		}
+
 		if (Text)
 		{
 			GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::AddAbilityQueueFromMontageRow() Add Child Text"))
-			// Text->SetText(FText::FromString("Ability Queue Opened from Montage: " + Anim->GetName()));
-			Text->SetText(FText::FromString(Anim->GetName()));
+			Text->SetText(Anim ? FText::FromName(Anim->GetFName()) : FText::GetEmpty());
 			Text->SetVisibility(ESlateVisibility::HitTestInvisible);
 			AbilityQueueFromMontagesBox->AddChild(Text);
 
@@ -94,52 +145,105 @@ void UGSCUWDebugAbilityQueue::AddAbilityQueueFromMontageRow(UAnimSequenceBase* A
 void UGSCUWDebugAbilityQueue::StartClearFromMontageRowTimer()
 {
 	GSC_UI_LOG(Verbose, TEXT("UGSCUWDebugAbilityQueue::StartClearFromMontageRowTimer()"))
-	FTimerHandle TimerHandle;
-	ClearFromMontageTimerHandles.Add(TimerHandle);
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UGSCUWDebugAbilityQueue::ClearFromMontageRow, ClearFromMontageDelay, false);
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Every row already has its clear timer started
+	if (ClearFromMontageTimes.Num() >= GetNumFromMontageRows())
+	{
+		return;
+	}
+
+	// Rows are cleared in order with the same delay, a single timer set for the oldest one is enough
+	ClearFromMontageTimes.Add(World->GetTimeSeconds() + ClearFromMontageDelay);
+	if (!World->GetTimerManager().IsTimerActive(ClearFromMontageTimerHandle))
+	{
+		World->GetTimerManager().SetTimer(ClearFromMontageTimerHandle, this, &UGSCUWDebugAbilityQueue::ClearFromMontageRow, ClearFromMontageDelay, false);
+	}
 }
 
-void UGSCUWDebugAbilityQueue::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
+int32 UGSCUWDebugAbilityQueue::GetNumFromMontageRows() const
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
+	return AbilityQueueFromMontagesBox ? AbilityQueueFromMontagesBox->GetChildrenCount() : 0;
+}
 
+void UGSCUWDebugAbilityQueue::RefreshDebugState()
+{
 	if (!OwnerAbilityQueueComponent.IsValid())
 	{
-		GSC_UI_LOG(Warning, TEXT("UGSCUWDebugAbilityQueue::NativeTick() OwnerAbilityQueueComponent not valid"))
+		GSC_UI_LOG(Warning, TEXT("UGSCUWDebugAbilityQueue::RefreshDebugState() OwnerAbilityQueueComponent not valid"))
 		return;
 	}
 
-	if (AbilityQueueEnabledText)
+	INC_DWORD_STAT(STAT_GSC_DebugWidgetRefreshes);
+
+	// Only touch texts that actually changed, everything is refreshed the first time
+	const bool bRefreshAll = !bHasDisplayedState;
+	bHasDisplayedState = true;
+
+	const bool bAbilityQueueEnabled = OwnerAbilityQueueComponent->bAbilityQueueEnabled;
+	if (bRefreshAll || bAbilityQueueEnabled != bDisplayedAbilityQueueEnabled)
 	{
-		const bool bAbilityQueueEnabled = OwnerAbilityQueueComponent->bAbilityQueueEnabled;
-		AbilityQueueEnabledText->SetText(bAbilityQueueEnabled ? FText::FromString("true") : FText::FromString("false"));
-		AbilityQueueEnabledText->SetColorAndOpacity(FSlateColor(bAbilityQueueEnabled ? GreenColor : RedColor));
+		bDisplayedAbilityQueueEnabled = bAbilityQueueEnabled;
+		SetBoolText(AbilityQueueEnabledText, bAbilityQueueEnabled, GreenColor, RedColor);
 	}
 
-	if (AbilityQueueOpenedText)
+	const bool bAbilityQueueOpened = OwnerAbilityQueueComponent->IsAbilityQueueOpened();
+	if (bRefreshAll || bAbilityQueueOpened != bDisplayedAbilityQueueOpened)
 	{
-		const bool bAbilityQueueOpened = OwnerAbilityQueueComponent->IsAbilityQueueOpened();
-		AbilityQueueOpenedText->SetText(bAbilityQueueOpened ? FText::FromString("true") : FText::FromString("false"));
-		AbilityQueueOpenedText->SetColorAndOpacity(FSlateColor(bAbilityQueueOpened ? GreenColor : RedColor));
+		bDisplayedAbilityQueueOpened = bAbilityQueueOpened;
+		SetBoolText(AbilityQueueOpenedText, bAbilityQueueOpened, GreenColor, RedColor);
 	}
 
-	if (CurrentQueuedAbilityText)
+	const UGameplayAbility* Ability = OwnerAbilityQueueComponent->GetCurrentQueuedAbility();
+	if (bRefreshAll || Ability != DisplayedQueuedAbility.Get())
 	{
-		const UGameplayAbility* Ability = OwnerAbilityQueueComponent->GetCurrentQueuedAbility();
-		CurrentQueuedAbilityText->SetText(Ability ? FText::FromString(Ability->GetName()): FText::FromString("None"));
-		CurrentQueuedAbilityText->SetColorAndOpacity(Ability ? GreenColor : WhiteColor);
+		DisplayedQueuedAbility = Ability;
+		if (CurrentQueuedAbilityText)
+		{
+			static const FText NoneText = FText::AsCultureInvariant(TEXT("None"));
+			CurrentQueuedAbilityText->SetText(Ability ? FText::FromName(Ability->GetFName()) : NoneText);
+			CurrentQueuedAbilityText->SetColorAndOpacity(Ability ? GreenColor : WhiteColor);
+		}
 	}
 
-	if (AllowAllAbilitiesText)
+	const bool bAllowAllAbilities = OwnerAbilityQueueComponent->IsAllAbilitiesAllowedForAbilityQueue();
+	if (bRefreshAll || bAllowAllAbilities != bDisplayedAllowAllAbilities)
 	{
-		const bool bAllowAllAbilities = OwnerAbilityQueueComponent->IsAllAbilitiesAllowedForAbilityQueue();
-		AllowAllAbilitiesText->SetText(bAllowAllAbilities ? FText::FromString("true"): FText::FromString("false"));
-		AllowAllAbilitiesText->SetColorAndOpacity(bAllowAllAbilities ? GreenColor : RedColor);
+		bDisplayedAllowAllAbilities = bAllowAllAbilities;
+		SetBoolText(AllowAllAbilitiesText, bAllowAllAbilities, GreenColor, RedColor);
 	}
 }
 
+UTextBlock* UGSCUWDebugAbilityQueue::GetOrDuplicateTextBlock(UVerticalBox* Box, const int32 Index, UTextBlock* Template)
+{
+	if (UTextBlock* Text = Cast<UTextBlock>(Box->GetChildAt(Index)))
+	{
+		return Text;
+	}
+
+	UTextBlock* Text = DuplicateObject(Template, this);
+	if (Text)
+	{
+		Box->AddChild(Text);
+	}
+
+	return Text;
+}
+
 void UGSCUWDebugAbilityQueue::ClearFromMontageRow()
 {
+	if (ClearFromMontageTimes.Num() > 0)
+	{
+		ClearFromMontageTimes.RemoveAt(0, 1, false);
+	}
+
+	// Next row to clear, if its timer was started
+	ScheduleClearFromMontageRow();
+
 	if (AbilityQueueFromMontagesBox)
 	{
 		AbilityQueueFromMontagesBox->RemoveChildAt(0);
@@ -154,3 +258,21 @@ void UGSCUWDebugAbilityQueue::ClearFromMontageRow()
 		}
 	}
 }
+
+void UGSCUWDebugAbilityQueue::ScheduleClearFromMontageRow()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (ClearFromMontageTimes.Num() == 0)
+	{
+		World->GetTimerManager().ClearTimer(ClearFromMontageTimerHandle);
+		return;
+	}
+
+	const float Delay = FMath::Max(ClearFromMontageTimes[0] - World->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+	World->GetTimerManager().SetTimer(ClearFromMontageTimerHandle, this, &UGSCUWDebugAbilityQueue::ClearFromMontageRow, Delay, false);
+}
@@ -7,6 +7,7 @@
 #include "Actors/Characters/GSCCharacterBase.h"
 #include "Components/GSCComboManagerComponent.h"
 #include "Components/TextBlock.h"
+#include "GSCStats.h"
 
 void UGSCUWDebugComboWidget::SetOwnerActor(AActor* Actor)
 {
@@ -14,42 +15,72 @@ void UGSCUWDebugComboWidget::SetOwnerActor(AActor* Actor)
 	OwnerComboManagerComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(Actor);
 }
 
-void UGSCUWDebugComboWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UGSCUWDebugComboWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (OwnerComboManagerComponent.IsValid())
+	{
+		bHasDisplayedComboState = false;
+		RefreshDebugState();
+	}
+}
+
+void UGSCUWDebugComboWidget::NativeDestruct()
+{
+	bHasDisplayedComboState = false;
+	Super::NativeDestruct();
+}
+
+void UGSCUWDebugComboWidget::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
+	RefreshDebugState();
+}
 
+void UGSCUWDebugComboWidget::RefreshDebugState()
+{
 	if (!OwnerComboManagerComponent.IsValid())
 	{
 		return;
 	}
 
-	if (ComboWindowOpenedText)
+	INC_DWORD_STAT(STAT_GSC_DebugWidgetRefreshes);
+
+	const FGSCComboState ComboState = OwnerComboManagerComponent->GetComboState();
+	if (bHasDisplayedComboState && ComboState == DisplayedComboState)
+	{
+		return;
+	}
+
+	// Only touch texts that actually changed, everything is refreshed the first time
+	const bool bRefreshAll = !bHasDisplayedComboState;
+	if (bRefreshAll || ComboState.bComboWindowOpened != DisplayedComboState.bComboWindowOpened)
 	{
-		ComboWindowOpenedText->SetText(FText::FromString(OwnerComboManagerComponent->bComboWindowOpened ? TEXT("true") : TEXT("false")));
-		ComboWindowOpenedText->SetColorAndOpacity(FSlateColor(OwnerComboManagerComponent->bComboWindowOpened ? GreenColor : RedColor));
+		SetBoolText(ComboWindowOpenedText, ComboState.bComboWindowOpened, GreenColor, RedColor);
 	}
 
-	if (ShouldTriggerComboText)
+	if (bRefreshAll || ComboState.bShouldTriggerCombo != DisplayedComboState.bShouldTriggerCombo)
 	{
-		ShouldTriggerComboText->SetText(FText::FromString(OwnerComboManagerComponent->bShouldTriggerCombo ? TEXT("true") : TEXT("false")));
-		ShouldTriggerComboText->SetColorAndOpacity(FSlateColor(OwnerComboManagerComponent->bShouldTriggerCombo ? GreenColor : RedColor));
+		SetBoolText(ShouldTriggerComboText, ComboState.bShouldTriggerCombo, GreenColor, RedColor);
 	}
 
-	if (RequestTriggerComboText)
+	if (bRefreshAll || ComboState.bRequestTriggerCombo != DisplayedComboState.bRequestTriggerCombo)
 	{
-		RequestTriggerComboText->SetText(FText::FromString(OwnerComboManagerComponent->bRequestTriggerCombo ? TEXT("true") : TEXT("false")));
-		RequestTriggerComboText->SetColorAndOpacity(FSlateColor(OwnerComboManagerComponent->bRequestTriggerCombo ? GreenColor : RedColor));
+		SetBoolText(RequestTriggerComboText, ComboState.bRequestTriggerCombo, GreenColor, RedColor);
 	}
 
-	if (NextComboAbilityActivatedText)
+	if (bRefreshAll || ComboState.bNextComboAbilityActivated != DisplayedComboState.bNextComboAbilityActivated)
 	{
-		NextComboAbilityActivatedText->SetText(FText::FromString(OwnerComboManagerComponent->bNextComboAbilityActivated ? TEXT("true") : TEXT("false")));
-		NextComboAbilityActivatedText->SetColorAndOpacity(FSlateColor(OwnerComboManagerComponent->bNextComboAbilityActivated ? GreenColor : RedColor));
+		SetBoolText(NextComboAbilityActivatedText, ComboState.bNextComboAbilityActivated, GreenColor, RedColor);
 	}
 
-	if (ComboIndexText)
+	if (ComboIndexText && (bRefreshAll || ComboState.ComboIndex != DisplayedComboState.ComboIndex))
 	{
-		ComboIndexText->SetText(FText::FromString(FString::FromInt(OwnerComboManagerComponent->ComboIndex)));
-		ComboIndexText->SetColorAndOpacity(FSlateColor(OwnerComboManagerComponent->ComboIndex == 0 ? WhiteColor : GreenColor));
+		ComboIndexText->SetText(FText::AsNumber(ComboState.ComboIndex));
+		ComboIndexText->SetColorAndOpacity(FSlateColor(ComboState.ComboIndex == 0 ? WhiteColor : GreenColor));
 	}
+
+	DisplayedComboState = ComboState;
+	bHasDisplayedComboState = true;
 }
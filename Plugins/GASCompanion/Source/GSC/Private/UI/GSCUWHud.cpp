@@ -5,10 +5,18 @@
 
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemGlobals.h"
+#include "Abilities/GSCCooldownTracker.h"
 #include "Abilities/Attributes/GSCAttributeSet.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
 #include "GSCLog.h"
+#include "GSCStats.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "Subsystems/GSCCooldownSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Update Requests"), STAT_GSC_HUDUpdateRequests, STATGROUP_GASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Widget Updates"), STAT_GSC_HUDWidgetUpdates, STATGROUP_GASCompanion);
 
 void UGSCUWHud::NativeConstruct()
 {
@@ -21,6 +29,17 @@ void UGSCUWHud::NativeDestruct()
 {
 	// Clean up previously registered delegates for OwningPlayer AbilitySystemComponent
 	ShutdownAbilitySystemComponentListeners();
+	GameplayEffectAddedHandles.Empty();
+
+	// Widget is going away, no need to push what's left
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(FlushHUDUpdatesTimerHandle);
+	}
+
+	bHUDUpdateScheduled = false;
+	PendingAttributeChanges.Empty();
+	PendingEffectChanges.Empty();
 
 	Super::NativeDestruct();
 }
@@ -80,6 +99,15 @@ void UGSCUWHud::RegisterAbilitySystemDelegates()
 
 	// Handle Ability Commit events
 	OwningAbilitySystemComponent->AbilityCommittedCallbacks.AddUObject(this, &UGSCUWHud::OnAbilityCommitted);
+
+	// Handle Cooldowns, through the ASC shared tracker
+	CooldownTracker = UGSCCooldownSubsystem::GetCooldownTracker(OwningAbilitySystemComponent);
+	if (CooldownTracker.IsValid())
+	{
+		CooldownTracker->OnCooldownStart.AddUObject(this, &UGSCUWHud::OnTrackedCooldownStart);
+		CooldownTracker->OnCooldownChanged.AddUObject(this, &UGSCUWHud::OnTrackedCooldownChanged);
+		CooldownTracker->OnCooldownEnd.AddUObject(this, &UGSCUWHud::OnTrackedCooldownEnd);
+	}
 }
 
 void UGSCUWHud::ShutdownAbilitySystemComponentListeners() const
@@ -120,14 +148,34 @@ void UGSCUWHud::ShutdownAbilitySystemComponentListeners() const
 		}
 	}
 
-	for (const FGameplayTag GameplayTagBoundToDelegate : GameplayTagBoundToDelegates)
+	if (CooldownTracker.IsValid())
 	{
-		OwningAbilitySystemComponent->RegisterGameplayTagEvent(GameplayTagBoundToDelegate).RemoveAll(this);
+		CooldownTracker->OnCooldownStart.RemoveAll(this);
+		CooldownTracker->OnCooldownChanged.RemoveAll(this);
+		CooldownTracker->OnCooldownEnd.RemoveAll(this);
 	}
 }
 
 void UGSCUWHud::OnAttributeChanged(const FOnAttributeChangeData& Data)
 {
+	INC_DWORD_STAT(STAT_GSC_HUDUpdateRequests);
+	if (bCoalesceHUDUpdates)
+	{
+		// Keep the value from before the first change since last flush as old value
+		if (FGSCHUDPendingAttributeChange* Change = PendingAttributeChanges.Find(Data.Attribute))
+		{
+			Change->NewValue = Data.NewValue;
+		}
+		else
+		{
+			PendingAttributeChanges.Add(Data.Attribute, { Data.NewValue, Data.OldValue });
+		}
+
+		ScheduleHUDUpdate();
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
 	HandleAttributeChange(Data.Attribute, Data.NewValue, Data.OldValue);
 	// TODO - Maybe find a way to prevent regen from triggering attribute change when it reaches higher / lower bounds of clamping instead ?
 	// if (Data.NewValue != Data.OldValue)
@@ -150,9 +198,11 @@ void UGSCUWHud::OnActiveGameplayEffectAdded(UAbilitySystemComponent* Target, con
 		OwningAbilitySystemComponent->OnGameplayEffectTimeChangeDelegate(ActiveHandle)->AddUObject(this, &UGSCUWHud::OnActiveGameplayEffectTimeChanged);
 
 		// Store active handles to clear out bound delegates when shutting down listeners
-		GameplayEffectAddedHandles.AddUnique(ActiveHandle);
+		GameplayEffectAddedHandles.Add(ActiveHandle);
 	}
 
+	INC_DWORD_STAT(STAT_GSC_HUDUpdateRequests);
+	INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
 	HandleGameplayEffectAdded(AssetTags, GrantedTags, ActiveHandle);
 }
 
@@ -163,6 +213,21 @@ void UGSCUWHud::OnActiveGameplayEffectStackChanged(const FActiveGameplayEffectHa
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_GSC_HUDUpdateRequests);
+	if (bCoalesceHUDUpdates)
+	{
+		FGSCHUDPendingEffectChange& Change = PendingEffectChanges.FindOrAdd(ActiveHandle);
+		if (!Change.bStackChanged)
+		{
+			Change.bStackChanged = true;
+			Change.OldStackCount = PreviousStackCount;
+		}
+
+		Change.NewStackCount = NewStackCount;
+		ScheduleHUDUpdate();
+		return;
+	}
+
 	const FActiveGameplayEffect* GameplayEffect = OwningAbilitySystemComponent->GetActiveGameplayEffect(ActiveHandle);
 	if (!GameplayEffect)
 	{
@@ -175,6 +240,7 @@ void UGSCUWHud::OnActiveGameplayEffectStackChanged(const FActiveGameplayEffectHa
 	FGameplayTagContainer GrantedTags;
 	GameplayEffect->Spec.GetAllGrantedTags(GrantedTags);
 
+	INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
 	HandleGameplayEffectStackChange(AssetTags, GrantedTags, ActiveHandle, NewStackCount, PreviousStackCount);
 }
 
@@ -185,6 +251,17 @@ void UGSCUWHud::OnActiveGameplayEffectTimeChanged(const FActiveGameplayEffectHan
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_GSC_HUDUpdateRequests);
+	if (bCoalesceHUDUpdates)
+	{
+		FGSCHUDPendingEffectChange& Change = PendingEffectChanges.FindOrAdd(ActiveHandle);
+		Change.bTimeChanged = true;
+		Change.NewStartTime = NewStartTime;
+		Change.NewDuration = NewDuration;
+		ScheduleHUDUpdate();
+		return;
+	}
+
 	const FActiveGameplayEffect* GameplayEffect = OwningAbilitySystemComponent->GetActiveGameplayEffect(ActiveHandle);
 	if (!GameplayEffect)
 	{
@@ -197,6 +274,7 @@ void UGSCUWHud::OnActiveGameplayEffectTimeChanged(const FActiveGameplayEffectHan
 	FGameplayTagContainer GrantedTags;
 	GameplayEffect->Spec.GetAllGrantedTags(GrantedTags);
 
+	INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
 	HandleGameplayEffectTimeChange(AssetTags, GrantedTags, ActiveHandle, NewStartTime, NewDuration);
 }
 
@@ -213,79 +291,109 @@ void UGSCUWHud::OnAnyGameplayEffectRemoved(const FActiveGameplayEffect& EffectRe
 	FGameplayTagContainer GrantedTags;
 	EffectRemoved.Spec.GetAllGrantedTags(GrantedTags);
 
+	// Effect is gone along with its delegates, and removal below supersedes any pending stack / time change
+	GameplayEffectAddedHandles.Remove(EffectRemoved.Handle);
+	PendingEffectChanges.Remove(EffectRemoved.Handle);
+
 	// Broadcast any GameplayEffect change to HUD
+	INC_DWORD_STAT(STAT_GSC_HUDUpdateRequests);
+	INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
 	HandleGameplayEffectStackChange(AssetTags, GrantedTags, EffectRemoved.Handle, 0, 1);
 	HandleGameplayEffectRemoved(AssetTags, GrantedTags, EffectRemoved.Handle);
 }
 
-void UGSCUWHud::OnAnyGameplayTagChanged(const FGameplayTag GameplayTag, const int32 NewCount)
+void UGSCUWHud::FlushPendingHUDUpdates()
 {
-	HandleGameplayTagChange(GameplayTag, NewCount);
-}
+	bHUDUpdateScheduled = false;
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(FlushHUDUpdatesTimerHandle);
+	}
 
-void UGSCUWHud::OnAbilityCommitted(UGameplayAbility* ActivatedAbility)
-{
-	if (!OwningAbilitySystemComponent)
+	// Move pending changes out, handlers might trigger new changes to be pushed on next flush
+	TMap<FGameplayAttribute, FGSCHUDPendingAttributeChange> AttributeChanges = MoveTemp(PendingAttributeChanges);
+	TMap<FActiveGameplayEffectHandle, FGSCHUDPendingEffectChange> EffectChanges = MoveTemp(PendingEffectChanges);
+	PendingAttributeChanges.Reset();
+	PendingEffectChanges.Reset();
+
+	for (const TPair<FGameplayAttribute, FGSCHUDPendingAttributeChange>& AttributeChange : AttributeChanges)
 	{
-		return;
+		INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
+		HandleAttributeChange(AttributeChange.Key, AttributeChange.Value.NewValue, AttributeChange.Value.OldValue);
 	}
 
-	if (!IsValid(ActivatedAbility))
+	if (!OwningAbilitySystemComponent)
 	{
-		GSC_LOG(Warning, TEXT("UGSCUWHud::OnAbilityCommitted() Activated ability not valid"))
 		return;
 	}
 
-	// Figure out cooldown
-	UGameplayEffect* CooldownGE = ActivatedAbility->GetCooldownGameplayEffect();
-	if (!CooldownGE)
+	FGameplayTagContainer AssetTags;
+	FGameplayTagContainer GrantedTags;
+	for (const TPair<FActiveGameplayEffectHandle, FGSCHUDPendingEffectChange>& EffectChange : EffectChanges)
 	{
-		return;
+		const FActiveGameplayEffect* GameplayEffect = OwningAbilitySystemComponent->GetActiveGameplayEffect(EffectChange.Key);
+		if (!GameplayEffect)
+		{
+			continue;
+		}
+
+		// Tag containers reused across effects
+		AssetTags.Reset();
+		GameplayEffect->Spec.GetAllAssetTags(AssetTags);
+		GrantedTags.Reset();
+		GameplayEffect->Spec.GetAllGrantedTags(GrantedTags);
+
+		const FGSCHUDPendingEffectChange& Change = EffectChange.Value;
+		if (Change.bStackChanged)
+		{
+			INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
+			HandleGameplayEffectStackChange(AssetTags, GrantedTags, EffectChange.Key, Change.NewStackCount, Change.OldStackCount);
+		}
+
+		if (Change.bTimeChanged)
+		{
+			INC_DWORD_STAT(STAT_GSC_HUDWidgetUpdates);
+			HandleGameplayEffectTimeChange(AssetTags, GrantedTags, EffectChange.Key, Change.NewStartTime, Change.NewDuration);
+		}
 	}
+}
 
-	if (!ActivatedAbility->IsInstantiated())
+void UGSCUWHud::ScheduleHUDUpdate()
+{
+	if (bHUDUpdateScheduled)
 	{
 		return;
 	}
 
-	const FGameplayTagContainer* CooldownTags = ActivatedAbility->GetCooldownTags();
-	if (!CooldownTags || CooldownTags->Num() <= 0)
+	UWorld* World = GetWorld();
+	if (!World)
 	{
+		FlushPendingHUDUpdates();
 		return;
 	}
 
-	const FGameplayAbilityActorInfo ActorInfo = ActivatedAbility->GetActorInfo();
-	const FGameplayAbilitySpecHandle AbilitySpecHandle = ActivatedAbility->GetCurrentAbilitySpecHandle();
-
-	float TimeRemaining = 0.f;
-	float Duration = 0.f;
-	ActivatedAbility->GetCooldownTimeRemainingAndDuration(AbilitySpecHandle, &ActorInfo, TimeRemaining, Duration);
-
-	// Broadcast start of cooldown to HUD
-	const FGameplayAbilitySpec* AbilitySpec = OwningAbilitySystemComponent->FindAbilitySpecFromHandle(AbilitySpecHandle);
-	if (AbilitySpec)
+	bHUDUpdateScheduled = true;
+	if (HUDUpdateInterval > 0.f)
 	{
-		HandleCooldownStart(AbilitySpec->Ability, *CooldownTags, TimeRemaining, Duration);
+		World->GetTimerManager().SetTimer(FlushHUDUpdatesTimerHandle, this, &UGSCUWHud::FlushPendingHUDUpdates, HUDUpdateInterval, false);
 	}
-
-	// Register delegate to monitor any change to cooldown gameplay tag to be able to figure out when a cooldown expires
-	TArray<FGameplayTag> GameplayTags;
-	CooldownTags->GetGameplayTagArray(GameplayTags);
-	for (const FGameplayTag GameplayTag : GameplayTags)
+	else
 	{
+		FlushHUDUpdatesTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &UGSCUWHud::FlushPendingHUDUpdates);
+	}
+}
 
-		FOnGameplayEffectTagCountChanged CountChangedDelegate = OwningAbilitySystemComponent->RegisterGameplayTagEvent(GameplayTag);
+void UGSCUWHud::OnAnyGameplayTagChanged(const FGameplayTag GameplayTag, const int32 NewCount)
+{
+	HandleGameplayTagChange(GameplayTag, NewCount);
+}
 
-		// Add a change callback if it isn't on it already
-		if (CountChangedDelegate.IsBoundToObject(this))
-		{
-			CountChangedDelegate.AddUObject(this, &UGSCUWHud::OnCooldownGameplayTagChanged, AbilitySpecHandle, Duration);
-			GameplayTagBoundToDelegates.AddUnique(GameplayTag);
-		}
-	}
+void UGSCUWHud::OnAbilityCommitted(UGameplayAbility* ActivatedAbility)
+{
+	// Cooldowns are tracked by the ASC cooldown tracker, see OnTrackedCooldownStart()
 }
 
-void UGSCUWHud::OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, const int32 NewCount, FGameplayAbilitySpecHandle AbilitySpecHandle, float Duration)
+void UGSCUWHud::OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, const int32 NewCount, const FGameplayAbilitySpecHandle AbilitySpecHandle, const float Duration)
 {
 	if (NewCount != 0)
 	{
@@ -304,15 +412,37 @@ void UGSCUWHud::OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, con
 		return;
 	}
 
-	UGameplayAbility* Ability = AbilitySpec->Ability;
-
 	// Broadcast cooldown expiration to HUD
-	if (IsValid(Ability))
+	if (IsValid(AbilitySpec->Ability))
 	{
 		HandleCooldownEnd(AbilitySpec->Ability, GameplayTag, Duration);
 	}
+}
+
+void UGSCUWHud::OnTrackedCooldownStart(const FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, const float TimeRemaining, const float Duration)
+{
+	if (!OwningAbilitySystemComponent)
+	{
+		return;
+	}
 
-	OwningAbilitySystemComponent->RegisterGameplayTagEvent(GameplayTag, EGameplayTagEventType::NewOrRemoved).RemoveAll(this);
+	// Broadcast start of cooldown to HUD
+	const FGameplayAbilitySpec* AbilitySpec = OwningAbilitySystemComponent->FindAbilitySpecFromHandle(AbilitySpecHandle);
+	if (AbilitySpec)
+	{
+		HandleCooldownStart(AbilitySpec->Ability, CooldownTags, TimeRemaining, Duration);
+	}
+}
+
+void UGSCUWHud::OnTrackedCooldownChanged(const FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, const float TimeRemaining, const float Duration)
+{
+	// Cooldown was extended, restart its display with updated time remaining / duration
+	HandleCooldownStart(Ability, CooldownTags, TimeRemaining, Duration);
+}
+
+void UGSCUWHud::OnTrackedCooldownEnd(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTag& CooldownTag, const float Duration)
+{
+	OnCooldownGameplayTagChanged(CooldownTag, 0, AbilitySpecHandle, Duration);
 }
 
 void UGSCUWHud::InitFromCharacter()
@@ -466,22 +596,22 @@ void UGSCUWHud::HandleAttributeChange(const FGameplayAttribute Attribute, const
 	}
 }
 
-void UGSCUWHud::HandleGameplayEffectStackChange(const FGameplayTagContainer AssetTags, const FGameplayTagContainer GrantedTags, const FActiveGameplayEffectHandle ActiveHandle, const int32 NewStackCount, const int32 OldStackCount)
+void UGSCUWHud::HandleGameplayEffectStackChange(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, const FActiveGameplayEffectHandle ActiveHandle, const int32 NewStackCount, const int32 OldStackCount)
 {
 	OnGameplayEffectStackChange(AssetTags, GrantedTags, ActiveHandle, NewStackCount, OldStackCount);
 }
 
-void UGSCUWHud::HandleGameplayEffectTimeChange(const FGameplayTagContainer AssetTags, const FGameplayTagContainer GrantedTags, const FActiveGameplayEffectHandle ActiveHandle, const float NewStartTime, const float NewDuration)
+void UGSCUWHud::HandleGameplayEffectTimeChange(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, const FActiveGameplayEffectHandle ActiveHandle, const float NewStartTime, const float NewDuration)
 {
 	OnGameplayEffectTimeChange(AssetTags, GrantedTags, ActiveHandle, NewStartTime, NewDuration);
 }
 
-void UGSCUWHud::HandleGameplayEffectAdded(const FGameplayTagContainer AssetTags, const FGameplayTagContainer GrantedTags, const FActiveGameplayEffectHandle ActiveHandle)
+void UGSCUWHud::HandleGameplayEffectAdded(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, const FActiveGameplayEffectHandle ActiveHandle)
 {
 	OnGameplayEffectAdded(AssetTags, GrantedTags, ActiveHandle, GetGameplayEffectUIData(ActiveHandle));
 }
 
-void UGSCUWHud::HandleGameplayEffectRemoved(const FGameplayTagContainer AssetTags, const FGameplayTagContainer GrantedTags, const FActiveGameplayEffectHandle ActiveHandle)
+void UGSCUWHud::HandleGameplayEffectRemoved(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, const FActiveGameplayEffectHandle ActiveHandle)
 {
 	OnGameplayEffectRemoved(AssetTags, GrantedTags, ActiveHandle, GetGameplayEffectUIData(ActiveHandle));
 }
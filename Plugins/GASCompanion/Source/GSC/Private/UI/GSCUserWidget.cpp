@@ -6,6 +6,7 @@
 #include "GSCLog.h"
 #include "Abilities/GSCBlueprintFunctionLibrary.h"
 #include "Components/GSCCoreComponent.h"
+#include "Components/TextBlock.h"
 
 
 void UGSCUserWidget::SetOwnerActor(AActor* Actor)
@@ -33,3 +34,19 @@ float UGSCUserWidget::GetPercentForAttributes(const FGameplayAttribute Attribute
 
 	return AttributeValue / MaxAttributeValue;
 }
+
+const FText& UGSCUserWidget::GetBoolText(const bool bValue)
+{
+	static const FText TrueText = FText::AsCultureInvariant(TEXT("true"));
+	static const FText FalseText = FText::AsCultureInvariant(TEXT("false"));
+	return bValue ? TrueText : FalseText;
+}
+
+void UGSCUserWidget::SetBoolText(UTextBlock* TextBlock, const bool bValue, const FLinearColor& TrueColor, const FLinearColor& FalseColor)
+{
+	if (TextBlock)
+	{
+		TextBlock->SetText(GetBoolText(bValue));
+		TextBlock->SetColorAndOpacity(FSlateColor(bValue ? TrueColor : FalseColor));
+	}
+}
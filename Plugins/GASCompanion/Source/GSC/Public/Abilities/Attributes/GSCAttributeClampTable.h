@@ -0,0 +1,110 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+
+/** Compact attribute IDs of the Gameplay Attributes declared by an Attribute Set class (including its parent classes) */
+struct GASCOMPANION_API FGSCAttributeClassIDs
+{
+	/** Class these IDs were resolved for, used to detect a stale entry (class garbage collected and address reused) */
+	TWeakObjectPtr<const UClass> Class;
+
+	/** Attribute property and its compact ID */
+	struct FSlot
+	{
+		const FProperty* Property = nullptr;
+		int32 ID = INDEX_NONE;
+	};
+
+	/**
+	 * Attributes of the class indexed by property offset (in 4 bytes units), so that getting the ID of an attribute is a
+	 * direct array index. Slots not at an attribute offset are left empty.
+	 */
+	TArray<FSlot> Slots;
+
+	/** Returns the compact ID of this attribute property, or INDEX_NONE if it is not declared by the class */
+	int32 Find(const FProperty* Property) const
+	{
+		if (!Property)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 SlotIndex = GetSlotIndex(Property);
+		return Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex].Property == Property ? Slots[SlotIndex].ID : INDEX_NONE;
+	}
+
+	static int32 GetSlotIndex(const FProperty* Property)
+	{
+		return Property->GetOffset_ForInternal() / sizeof(float);
+	}
+};
+
+/**
+ * Process-wide table of minimum clamp values configured for Gameplay Attributes in Developer Settings (MinimumValues).
+ *
+ * Each attribute property gets a compact ID, resolved once per Attribute Set class, and minimum values are stored in a
+ * flat array indexed by that ID. Attribute Sets only keep a pointer to the IDs of their class, and getting a clamp value
+ * is two array indexes.
+ *
+ * Minimum values are rebuilt on first access after Developer Settings changed (see Invalidate()). IDs are keyed by
+ * attribute properties, and are all resolved again when objects are reinstanced (Blueprint Attribute Set recompiled,
+ * hot reload), see InvalidateAttributeIDs().
+ *
+ * Game thread only.
+ */
+class GASCOMPANION_API FGSCAttributeClampTable
+{
+public:
+	static FGSCAttributeClampTable& Get();
+
+	/** Returns the attribute IDs for the given Attribute Set class, resolving them on first call for this class. Returned reference is stable. */
+	const FGSCAttributeClassIDs& GetClassAttributeIDs(const UClass* AttributeSetClass);
+
+	/** Returns the compact ID for the given attribute, assigning one if it didn't have any yet. INDEX_NONE for invalid attributes. */
+	int32 GetOrAddAttributeID(const FGameplayAttribute& Attribute);
+
+	/** Returns the minimum clamp value for the given attribute ID, 0 if none configured */
+	float GetMinimumValue(const int32 AttributeID)
+	{
+		if (bMinimumValuesDirty)
+		{
+			RebuildMinimumValues();
+		}
+
+		return MinimumValues.IsValidIndex(AttributeID) ? MinimumValues[AttributeID] : 0.f;
+	}
+
+	/** Flags minimum values as needing to be rebuilt from Developer Settings. To call whenever settings change. */
+	void Invalidate() { bMinimumValuesDirty = true; }
+
+	/**
+	 * Drops every attribute ID, resolved again on next use. Class IDs returned by GetClassAttributeIDs() stay allocated but
+	 * are emptied, Attribute Sets holding one must check GetGeneration() before using it.
+	 */
+	void InvalidateAttributeIDs();
+
+	/** Incremented every time attribute IDs are invalidated */
+	uint32 GetGeneration() const { return Generation; }
+
+private:
+	/** Compact ID assigned to each attribute property, in order of first use */
+	TMap<const FProperty*, int32> AttributeIDs;
+
+	/** Minimum clamp value for each attribute ID */
+	TArray<float> MinimumValues;
+
+	/** Resolved IDs for each Attribute Set class. Heap allocated so that Attribute Sets can keep a pointer to them */
+	TMap<const UClass*, TUniquePtr<FGSCAttributeClassIDs>> ClassAttributeIDs;
+
+	bool bMinimumValuesDirty = true;
+
+	uint32 Generation = 0;
+
+	FGSCAttributeClampTable();
+
+	int32 GetOrAddAttributeID(const FProperty* Property);
+	void RebuildMinimumValues();
+};
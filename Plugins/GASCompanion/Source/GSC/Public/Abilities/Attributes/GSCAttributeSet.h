@@ -39,6 +39,8 @@ public:
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual FGameplayAttribute GetMaxAttributeFor(const FGameplayAttribute& Attribute) const override;
+	virtual FGameplayAttribute GetAttributeCappedBy(const FGameplayAttribute& MaxAttribute) const override;
 
 	// Current Health, when 0 we expect owner to die unless prevented by an ability. Capped by MaxHealth.
 	// Positive changes can directly use this.
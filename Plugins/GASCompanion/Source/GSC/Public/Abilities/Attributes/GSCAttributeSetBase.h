@@ -13,6 +13,7 @@
 class UGSCCoreComponent;
 class AGSCCharacterBase;
 struct FGameplayTagContainer;
+struct FGSCAttributeClassIDs;
 
 /** Structure holding various information to deal with AttributeSet PostGameplayEffectExecute, extracting info from FGameplayEffectModCallbackData */
 USTRUCT()
@@ -104,7 +105,7 @@ public:
     virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-    /** Helper function to get the minimum clamp value for a given attribute, from developer settings if available */
+    /** Helper function to get the minimum clamp value for a given attribute, from developer settings if available (0 otherwise) */
     virtual float GetClampMinimumValueFor(const FGameplayAttribute& Attribute);
 
 	/**
@@ -170,12 +171,33 @@ public:
      */
     virtual void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty) const;
 
+    /** Returns the max attribute Attribute is clamped against (e.g. MaxHealth for Health), or an invalid attribute if it is not clamped */
+    virtual FGameplayAttribute GetMaxAttributeFor(const FGameplayAttribute& Attribute) const { return FGameplayAttribute(); }
+
+    /** Returns the attribute proportionally adjusted when MaxAttribute changes (e.g. Health for MaxHealth), or an invalid attribute if it is not a max attribute */
+    virtual FGameplayAttribute GetAttributeCappedBy(const FGameplayAttribute& MaxAttribute) const { return FGameplayAttribute(); }
+
 protected:
 
-    /** Cached map of minimum clamp values for each configured attributes*/
-    UPROPERTY(meta=(HideInDetailsView))
+    /**
+     * Map of minimum clamp values, taking precedence over Developer Settings for the attributes it contains.
+     *
+     * No longer filled from Developer Settings, which are now shared by all instances in FGSCAttributeClampTable. Only kept
+     * for subclasses and Blueprints still setting values in it.
+     */
+    UPROPERTY(meta=(HideInDetailsView, DeprecatedProperty, DeprecationMessage="Minimum values are read from Developer Settings, override GetClampMinimumValueFor() for per set values."))
     TMap<FGameplayAttribute, float> MinimumValues;
 
+    /**
+     * Compact IDs of this class attributes, used to look up minimum clamp values in the shared FGSCAttributeClampTable.
+     *
+     * Resolved on first GetClampMinimumValueFor(), and owned by the table.
+     */
+    const FGSCAttributeClassIDs* ClassAttributeIDs = nullptr;
+
+    /** Table generation ClassAttributeIDs was resolved for, resolved again when the table invalidated its IDs */
+    uint32 ClassAttributeIDsGeneration = 0;
+
 	/**
 	 * Fills out FGSCAttributeSetExecutionData structure based on provided data.
 	 *
@@ -34,18 +34,24 @@ public:
 
 	/**
 	* Tries to find a combo manager component on the actor
+	*
+	* Found component is cached per actor (see UGSCComponentCacheSubsystem) until a companion component is registered / unregistered
 	*/
 	UFUNCTION(BlueprintPure, Category = "GAS Companion|Components")
 	static UGSCComboManagerComponent* GetComboManagerComponent(const AActor* Actor);
 
 	/**
 	* Tries to find a companion core component on the actor
+	*
+	* Found component is cached per actor (see UGSCComponentCacheSubsystem) until a companion component is registered / unregistered
 	*/
 	UFUNCTION(BlueprintPure, Category = "GAS Companion|Components")
 	static UGSCCoreComponent* GetCompanionCoreComponent(const AActor* Actor);
 
 	/**
 	* Tries to find an ability queue core component on the actor
+	*
+	* Found component is cached per actor (see UGSCComponentCacheSubsystem) until a companion component is registered / unregistered
 	*/
 	UFUNCTION(BlueprintPure, Category = "GAS Companion|Components")
 	static UGSCAbilityQueueComponent* GetAbilityQueueComponent(const AActor* Actor);
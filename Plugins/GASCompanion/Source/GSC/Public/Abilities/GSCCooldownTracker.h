@@ -0,0 +1,98 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpec.h"
+#include "GameplayTagContainer.h"
+#include "Engine/EngineTypes.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+/**
+ * Tracks cooldowns of the abilities committed on an Ability System Component, and broadcasts their start, change and end.
+ *
+ * Instead of registering a new tag event delegate for each cooldown tag on every commit, the tracker keeps a single
+ * subscription per cooldown tag for its whole lifetime, and a small heap of tracked cooldowns ordered by expiration time.
+ *
+ * - OnCooldownStart is broadcast when an ability with a cooldown is committed
+ * - OnCooldownChanged is broadcast when a cooldown reaches its expected expiration time while its tags are still there (cooldown was extended)
+ * - OnCooldownEnd is broadcast for each cooldown tag removed from the ASC, for every tracked cooldown granting it
+ *
+ * One tracker is shared by every listener of an ASC, @see UGSCCooldownSubsystem::GetCooldownTracker()
+ */
+class GASCOMPANION_API FGSCCooldownTracker : public TSharedFromThis<FGSCCooldownTracker>
+{
+public:
+	DECLARE_MULTICAST_DELEGATE_FiveParams(FOnCooldownChanged, FGameplayAbilitySpecHandle /*AbilitySpecHandle*/, UGameplayAbility* /*Ability*/, const FGameplayTagContainer& /*CooldownTags*/, float /*TimeRemaining*/, float /*Duration*/);
+	DECLARE_MULTICAST_DELEGATE_FourParams(FOnCooldownEnd, FGameplayAbilitySpecHandle /*AbilitySpecHandle*/, UGameplayAbility* /*Ability*/, const FGameplayTag& /*CooldownTag*/, float /*Duration*/);
+
+	/** Broadcast when an ability with a valid cooldown is committed and cooldown is applied. Ability is the committed instance. */
+	FOnCooldownChanged OnCooldownStart;
+
+	/** Broadcast when a tracked cooldown time remaining changed (cooldown still active past its expected expiration) */
+	FOnCooldownChanged OnCooldownChanged;
+
+	/** Broadcast when a cooldown gameplay tag is removed, meaning cooldown expired. Ability is the one from the spec (CDO for non instanced abilities). */
+	FOnCooldownEnd OnCooldownEnd;
+
+	explicit FGSCCooldownTracker(UAbilitySystemComponent* InAbilitySystemComponent);
+	~FGSCCooldownTracker();
+
+	/** Starts listening to ability commits. Separate from constructor as it needs a shared reference to this tracker. */
+	void Initialize();
+
+	/** Stops listening to the ASC and forgets about any tracked cooldown, without broadcasting their end */
+	void Shutdown();
+
+	/** Returns the ASC this tracker is listening to */
+	UAbilitySystemComponent* GetAbilitySystemComponent() const { return AbilitySystemComponent.Get(); }
+
+	/** Number of cooldowns currently tracked (at most one per ability spec) */
+	int32 NumTrackedCooldowns() const { return CooldownHeap.Num(); }
+
+	/** Number of tag event delegates bound on the ASC. Only grows with the number of distinct cooldown tags, not with commits. */
+	int32 NumTagSubscriptions() const { return TagSubscriptions.Num(); }
+
+private:
+	struct FTrackedCooldown
+	{
+		/** World time at which the cooldown is expected to expire. MAX_dbl when unknown (waiting for tags removal). */
+		double ExpireTime = MAX_dbl;
+		FGameplayAbilitySpecHandle AbilitySpecHandle;
+		FGameplayTagContainer CooldownTags;
+
+		/** Cooldown tags not removed yet */
+		FGameplayTagContainer PendingTags;
+		float Duration = 0.f;
+	};
+
+	struct FExpireTimePredicate
+	{
+		bool operator()(const FTrackedCooldown& A, const FTrackedCooldown& B) const { return A.ExpireTime < B.ExpireTime; }
+	};
+
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	/** Min heap of tracked cooldowns on ExpireTime */
+	TArray<FTrackedCooldown> CooldownHeap;
+
+	/** Handle of the single tag event delegate bound on the ASC for each cooldown tag */
+	TMap<FGameplayTag, FDelegateHandle> TagSubscriptions;
+
+	FDelegateHandle AbilityCommittedHandle;
+
+	/** Timer firing at the earliest expected expiration */
+	FTimerHandle ExpirationTimerHandle;
+
+	void OnAbilityCommitted(UGameplayAbility* ActivatedAbility);
+	void OnCooldownTagChanged(FGameplayTag CooldownTag, int32 NewCount);
+	void OnExpirationTimer();
+
+	void TrackCooldown(FGameplayAbilitySpecHandle AbilitySpecHandle, const FGameplayTagContainer& CooldownTags, float TimeRemaining, float Duration);
+	void SubscribeToTag(const FGameplayTag& CooldownTag);
+	void ScheduleExpirationTimer();
+	UGameplayAbility* GetSpecAbility(FGameplayAbilitySpecHandle AbilitySpecHandle) const;
+	double GetWorldTime() const;
+};
@@ -142,4 +142,16 @@ private:
 
 	/** Returns spawned attribute set from passed in ASC based on provided AttributeClass (mainly because GetAttributeSuboject on AbilitySystemComponent is protected) */
     static const UAttributeSet* GetAttributeSubobjectForASC(UAbilitySystemComponent* AbilitySystemComponent, TSubclassOf<UAttributeSet> AttributeClass);
+
+	/**
+	 * Attributes of the additive modifiers of the Cost Gameplay Effect, the only thing loose cost checks look at.
+	 *
+	 * Only depends on the Cost Gameplay Effect definition (not on ability level or magnitudes), rebuilt when
+	 * GetCostGameplayEffect() returns a different effect. Mutable since cost checks are const (and often done on the CDO).
+	 */
+	mutable TWeakObjectPtr<const UGameplayEffect> CachedCostGameplayEffect;
+	mutable TArray<FGameplayAttribute, TInlineAllocator<2>> CachedCostAttributes;
+
+	/** Returns the additive cost attributes of the given effect, from cache unless the effect changed since last call */
+	const TArray<FGameplayAttribute, TInlineAllocator<2>>& GetCachedCostAttributes(const UGameplayEffect* CostGameplayEffect) const;
 };
@@ -7,6 +7,7 @@
 #include "GameplayTagContainer.h"
 #include "GSCTypes.generated.h"
 
+class UAbilitySystemComponent;
 class UGSCTargetType;
 class UGameplayEffect;
 
@@ -49,6 +50,80 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = GameplayEffectContainer)
 	float SetByCallerMagnitude = 1.0f;
+
+	/**
+	 * Store hit results of the target type together in FGSCGameplayAbilityTargetData_MultiHit target data, instead of one
+	 * single target hit target data per hit. Saves an allocation per hit for large AoE.
+	 *
+	 * Only enable it if nothing reads the container target data per entry (GetDataCountFromTargetData, GetHitResultFromTargetData,
+	 * etc.): these only see the first hit of each multi hit entry. Applied gameplay effects are the same either way.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = GameplayEffectContainer)
+	bool bPackHitResults = false;
+};
+
+/**
+ * Target data holding several hit results in a single contiguous array, instead of one heap allocated single target hit
+ * target data per hit. Only used by effect containers that opt in with bPackHitResults.
+ *
+ * Gameplay effects applied through it behave as with one FGameplayAbilityTargetData_SingleTargetHit per hit: each target
+ * gets its own effect context, with its own hit result and origin (trace start).
+ *
+ * Note that the per-entry hit result API (HasHitResult / GetHitResult, GetOrigin, GetEndPoint) only describes the first
+ * hit, as a single hit target data would. Use GetHitResults to access all of them.
+ *
+ * At most MaxHitResults hits are replicated per target data, FGSCGameplayEffectContainerSpec::AddTargets splits larger
+ * hit lists into several entries.
+ */
+USTRUCT(BlueprintType)
+struct GASCOMPANION_API FGSCGameplayAbilityTargetData_MultiHit : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+
+	FGSCGameplayAbilityTargetData_MultiHit() {}
+
+	explicit FGSCGameplayAbilityTargetData_MultiHit(const TArray<FHitResult>& InHitResults)
+		: HitResults(InHitResults)
+	{}
+
+	FGSCGameplayAbilityTargetData_MultiHit(const FHitResult* InHitResults, const int32 NumHitResults)
+		: HitResults(InHitResults, NumHitResults)
+	{}
+
+	/** Maximum number of hit results in a single target data, enforced when serializing */
+	static constexpr int32 MaxHitResults = 1024;
+
+	UPROPERTY()
+	TArray<FHitResult> HitResults;
+
+	const TArray<FHitResult>& GetHitResults() const { return HitResults; }
+
+	/** Adds what FGameplayAbilityTargetData_SingleTargetHit would add to an effect context for this hit (hit result and origin) */
+	static void AddHitToContext(FGameplayEffectContextHandle& EffectContext, const FHitResult& HitResult);
+
+	//~ Begin FGameplayAbilityTargetData interface
+	virtual TArray<TWeakObjectPtr<AActor>> GetActors() const override;
+	virtual bool HasHitResult() const override { return HitResults.Num() > 0; }
+	virtual const FHitResult* GetHitResult() const override { return HitResults.Num() > 0 ? &HitResults[0] : nullptr; }
+	virtual bool HasOrigin() const override { return HitResults.Num() > 0; }
+	virtual FTransform GetOrigin() const override;
+	virtual bool HasEndPoint() const override { return HitResults.Num() > 0; }
+	virtual FVector GetEndPoint() const override { return HitResults.Num() > 0 ? HitResults[0].Location : FVector::ZeroVector; }
+	virtual TArray<FActiveGameplayEffectHandle> ApplyGameplayEffectSpec(FGameplayEffectSpec& InSpec, FPredictionKey PredictionKey = FPredictionKey()) override;
+	virtual UScriptStruct* GetScriptStruct() const override { return FGSCGameplayAbilityTargetData_MultiHit::StaticStruct(); }
+	virtual FString ToString() const override { return TEXT("FGSCGameplayAbilityTargetData_MultiHit"); }
+	//~ End FGameplayAbilityTargetData interface
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSCGameplayAbilityTargetData_MultiHit> : public TStructOpsTypeTraitsBase2<FGSCGameplayAbilityTargetData_MultiHit>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
 
 /** A "processed" version of GSCGameplayEffectContainer that can be passed around and eventually applied */
@@ -74,6 +149,24 @@ public:
 	/** Returns true if this has any valid targets */
 	bool HasValidTargets() const;
 
-	/** Adds new targets to target data */
-	void AddTargets(const TArray<FHitResult>& HitResults, const TArray<AActor*>& TargetActors);
+	/**
+	 * Adds new targets to target data.
+	 *
+	 * Each hit result is added as a FGameplayAbilityTargetData_SingleTargetHit, and target actors in one FGameplayAbilityTargetData_ActorArray.
+	 *
+	 * @param bPackHitResults If true and there are several hit results, they are stored together in FGSCGameplayAbilityTargetData_MultiHit
+	 * instead (one per MaxHitResults hits), see FGSCGameplayEffectContainer::bPackHitResults
+	 */
+	void AddTargets(const TArray<FHitResult>& HitResults, const TArray<AActor*>& TargetActors, bool bPackHitResults = false);
+
+	/**
+	 * Applies every effect spec to every target, the same way (and in the same order) as applying each spec to the target
+	 * data in turn with UGameplayAbility::ApplyGameplayEffectSpecToTarget: each spec is applied by the instigator Ability
+	 * System Component of its effect context.
+	 *
+	 * Targets and their Ability System Component are resolved once for all specs rather than once per spec. Each target
+	 * still gets its own spec copy and effect context, modifier magnitudes are computed per target as usual. Gameplay cues
+	 * sent while applying are batched in a single FScopedGameplayCueSendContext flush.
+	 */
+	TArray<FActiveGameplayEffectHandle> ApplyToTargets(FPredictionKey PredictionKey) const;
 };
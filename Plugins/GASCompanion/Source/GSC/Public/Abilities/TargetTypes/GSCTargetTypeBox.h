@@ -0,0 +1,26 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/TargetTypes/GSCTargetTypeOverlap.h"
+#include "GSCTargetTypeBox.generated.h"
+
+/** Target type returning actors overlapping a box oriented like the targeting actor */
+UCLASS(Blueprintable)
+class GASCOMPANION_API UGSCTargetTypeBox : public UGSCTargetTypeOverlap
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTargetTypeBox() {}
+
+	/** Half size of the box, along the targeting actor forward, right and up axes */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	FVector HalfExtent = FVector(200.f, 100.f, 100.f);
+
+	virtual bool ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const override;
+
+protected:
+	virtual FCollisionShape GetCollisionShape() const override;
+};
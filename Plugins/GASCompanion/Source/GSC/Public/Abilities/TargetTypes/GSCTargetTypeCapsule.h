@@ -0,0 +1,30 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/TargetTypes/GSCTargetTypeOverlap.h"
+#include "GSCTargetTypeCapsule.generated.h"
+
+/** Target type returning actors overlapping a capsule oriented like the targeting actor (upright by default) */
+UCLASS(Blueprintable)
+class GASCOMPANION_API UGSCTargetTypeCapsule : public UGSCTargetTypeOverlap
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTargetTypeCapsule() {}
+
+	/** Radius of the capsule */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0))
+	float Radius = 200.f;
+
+	/** Half height of the capsule, including the hemispheres */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0))
+	float HalfHeight = 300.f;
+
+	virtual bool ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const override;
+
+protected:
+	virtual FCollisionShape GetCollisionShape() const override;
+};
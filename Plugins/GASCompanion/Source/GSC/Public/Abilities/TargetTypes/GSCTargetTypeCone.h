@@ -0,0 +1,36 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/TargetTypes/GSCTargetTypeOverlap.h"
+#include "GSCTargetTypeCone.generated.h"
+
+/**
+ * Target type returning actors within a cone in front of the targeting actor.
+ *
+ * Queried as a sphere of the cone length, then filtered on the angle between the targeting actor forward vector and
+ * the direction to each overlapped actor location.
+ */
+UCLASS(Blueprintable)
+class GASCOMPANION_API UGSCTargetTypeCone : public UGSCTargetTypeOverlap
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTargetTypeCone() {}
+
+	/** Length of the cone, from its apex */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0))
+	float Length = 500.f;
+
+	/** Half angle of the cone, in degrees */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0, ClampMax = 180))
+	float HalfAngleDegrees = 45.f;
+
+	virtual bool ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const override;
+
+protected:
+	virtual FCollisionShape GetCollisionShape() const override;
+	virtual bool NeedsContainsPointFilter() const override { return true; }
+};
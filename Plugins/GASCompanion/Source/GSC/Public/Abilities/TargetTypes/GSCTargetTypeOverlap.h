@@ -0,0 +1,72 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GSCTargetType.h"
+#include "CollisionShape.h"
+#include "Engine/EngineTypes.h"
+#include "GSCTargetTypeOverlap.generated.h"
+
+/**
+ * Base class for native target types gathering targets with a shape overlap around the targeting actor.
+ *
+ * Subclass one of the shapes (sphere, box, capsule, cone) in Blueprint to configure it, and use it as the Target Type of an
+ * effect container. Overlapped actors go straight to the container target data, sorted by distance and capped to
+ * MaxTargets, without any Blueprint overlap / loop on hits.
+ *
+ * Effect containers are made and applied within the same frame (eg. from montage events), so the overlap is a
+ * synchronous scene query.
+ */
+UCLASS(Abstract, Blueprintable)
+class GASCOMPANION_API UGSCTargetTypeOverlap : public UGSCTargetType
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTargetTypeOverlap() {}
+
+	/** Collision channel used for the overlap query */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_Pawn;
+
+	/** Offset of the shape center, relative to the targeting actor location and rotation */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	FVector Offset = FVector::ZeroVector;
+
+	/** Maximum number of targets returned, closest first. 0 for no limit */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0))
+	int32 MaxTargets = 0;
+
+	/** Whether targets are returned sorted by distance to the shape center (always the case with MaxTargets) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	bool bSortByDistance = true;
+
+	/** Whether the targeting actor itself is excluded from targets */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	bool bIgnoreTargetingActor = true;
+
+	/** Whether to draw the query shape (in builds with debug drawing) */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting")
+	bool bDrawDebug = false;
+
+	/** Overlaps the shape and returns the overlapped actors */
+	virtual void GetTargets_Implementation(AActor* TargetingActor, FGameplayEventData EventData, TArray<FHitResult>& OutHitResults, TArray<AActor*>& OutActors) const override;
+
+	/**
+	 * Returns whether the point lies within this target type shape, for a query centered on Origin with the given rotation.
+	 *
+	 * Used to refine the overlap for shapes that can't be queried directly (cone), and to validate overlap results.
+	 */
+	virtual bool ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const { return true; }
+
+	/** Returns the shape center and rotation for a query done by TargetingActor */
+	void GetQueryTransform(const AActor* TargetingActor, FVector& OutOrigin, FQuat& OutRotation) const;
+
+protected:
+	/** Shape used for the scene query */
+	virtual FCollisionShape GetCollisionShape() const { return FCollisionShape(); }
+
+	/** Whether overlapped actors must be filtered with ContainsPoint (for shapes that are approximated by the query shape) */
+	virtual bool NeedsContainsPointFilter() const { return false; }
+};
@@ -0,0 +1,26 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/TargetTypes/GSCTargetTypeOverlap.h"
+#include "GSCTargetTypeSphere.generated.h"
+
+/** Target type returning actors overlapping a sphere around the targeting actor */
+UCLASS(Blueprintable)
+class GASCOMPANION_API UGSCTargetTypeSphere : public UGSCTargetTypeOverlap
+{
+	GENERATED_BODY()
+
+public:
+	UGSCTargetTypeSphere() {}
+
+	/** Radius of the sphere */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = 0))
+	float Radius = 300.f;
+
+	virtual bool ContainsPoint(const FVector& Origin, const FQuat& Rotation, const FVector& Point) const override;
+
+protected:
+	virtual FCollisionShape GetCollisionShape() const override;
+};
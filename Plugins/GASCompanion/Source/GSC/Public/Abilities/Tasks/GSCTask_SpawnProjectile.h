@@ -12,6 +12,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSpawnActorDelegate, AActor*, Spawne
 
 /**
 *	Convenience task for spawning actor projectiles on the network authority.
+*
+*	Projectile classes with bPooled enabled are acquired from the world projectile pool instead (UGSCProjectilePoolSubsystem).
 */
 UCLASS()
 class GASCOMPANION_API UGSCTask_SpawnProjectile : public UAbilityTask
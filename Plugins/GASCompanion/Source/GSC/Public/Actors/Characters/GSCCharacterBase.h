@@ -80,5 +80,10 @@ public:
 
 protected:
 
+	//~ Begin AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~ End AActor interface
+
 	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
 };
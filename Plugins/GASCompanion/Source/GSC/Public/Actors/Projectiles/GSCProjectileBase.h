@@ -60,9 +60,68 @@ public:
 	UPROPERTY(BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category="GAS Companion|Projectile")
 	FGameplayEffectSpecHandle DamageEffectSpecHandle;
 
+	/**
+	 * Whether instances of this projectile are recycled through the world projectile pool (UGSCProjectilePoolSubsystem) when
+	 * spawned from UGSCTask_SpawnProjectile, instead of being spawned and destroyed for every shot.
+	 *
+	 * Pooled projectiles only go through BeginPlay (and construction script) once. Per shot setup must happen in
+	 * OnProjectileActivated, and ReleaseProjectile must be used in place of DestroyActor.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="GAS Companion|Projectile|Pooling")
+	bool bPooled = false;
+
+	/** Number of instances of this class spawned in the pool the first time it is requested */
+	UPROPERTY(EditDefaultsOnly, Category="GAS Companion|Projectile|Pooling", meta = (EditCondition = "bPooled", ClampMin = 0))
+	int32 PoolPrewarmCount = 16;
+
+	/** Maximum number of inactive instances of this class kept in the pool, released projectiles beyond that are destroyed */
+	UPROPERTY(EditDefaultsOnly, Category="GAS Companion|Projectile|Pooling", meta = (EditCondition = "bPooled", ClampMin = 0))
+	int32 MaxPoolSize = 128;
+
+	/**
+	 * Destroys this projectile, or returns it to the projectile pool if it was acquired from there.
+	 *
+	 * To call on impact (after DestroyDelay) in place of DestroyActor. Lifespan expiration goes through here as well.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GAS Companion|Projectile")
+	void ReleaseProjectile();
+
+	/** Returns true if this projectile is managed by the projectile pool */
+	UFUNCTION(BlueprintPure, Category="GAS Companion|Projectile")
+	bool IsPooledProjectile() const { return bManagedByPool; }
+
+	/**
+	 * Called when a pooled projectile is fired, once spawn properties have been set, movement and collision reset.
+	 *
+	 * Equivalent of BeginPlay for per shot setup (eg. adding the projectile gameplay cue).
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category="GAS Companion|Projectile")
+	void OnProjectileActivated();
+
+	/** Called when a pooled projectile goes back to the pool, before it is hidden (eg. to remove the projectile gameplay cue) */
+	UFUNCTION(BlueprintNativeEvent, Category="GAS Companion|Projectile")
+	void OnProjectileDeactivated();
+
+	//~ Begin AActor interface
+	virtual void LifeSpanExpired() override;
+	//~ End AActor interface
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+private:
+	friend class UGSCProjectilePoolSubsystem;
+
+	/** Set by the projectile pool for instances it spawned */
+	bool bManagedByPool = false;
+
+	/** Whether this instance is currently sitting inactive in the pool */
+	bool bInPool = false;
+
+	/** Resets transform, movement, collision and lifespan, and makes the projectile visible and relevant again */
+	void ActivatePooledProjectile(const FTransform& SpawnTransform);
+
+	/** Stops movement, disables collision and hides the projectile until it is acquired again */
+	void DeactivatePooledProjectile();
 };
@@ -12,6 +12,9 @@
  * Use this notify state to open a combo window during witch the player can queue up the next combo by activating the ability again.
  *
  * Don't forget to set the `bEndCombo` property to true on this notifier if the montage is the last one of your combo chain.
+ *
+ * The next combo is triggered by the Combo Manager Component as soon as the window is opened and triggered (see UGSCTriggerComboNotify),
+ * this notify state doesn't need to tick.
  */
 UCLASS()
 class GASCOMPANION_API UGSCComboWindowNotifyState : public UAnimNotifyState
@@ -25,7 +28,6 @@ public:
 
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration) override;
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation) override;
-	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime) override;
 
 	virtual FString GetEditorComment() override;
 	virtual FString GetNotifyName_Implementation() const override;
@@ -0,0 +1,68 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGameplayAbility;
+
+/**
+ * Fixed capacity ring buffer of timestamped ability activations, used by the Ability Queue Component to buffer inputs
+ * while the ability queue is opened.
+ *
+ * Activations are popped oldest first. When full, queuing a new activation drops the oldest one.
+ */
+struct GASCOMPANION_API FGSCAbilityQueueBuffer
+{
+	struct FEntry
+	{
+		TWeakObjectPtr<const UGameplayAbility> Ability;
+		double QueuedTime = 0.;
+	};
+
+	/** Resizes the buffer (at least 1 entry), keeping the most recent activations */
+	void SetCapacity(int32 InCapacity);
+
+	/** Queues an activation for Ability, dropping the oldest activation if the buffer is full */
+	void Enqueue(const UGameplayAbility* Ability, double Time);
+
+	/**
+	 * Pops activations until one is still valid, not expired and allowed, and returns its ability (nullptr if none).
+	 *
+	 * @param Now Current time, in the same time base used to queue activations
+	 * @param ExpiryTime Time after which a queued activation is discarded, 0 or below to never expire
+	 * @param IsAllowed Returns whether the ability of a queued activation can be activated, discarded otherwise
+	 */
+	const UGameplayAbility* Pop(double Now, float ExpiryTime, TFunctionRef<bool(const UGameplayAbility*)> IsAllowed);
+
+	/**
+	 * Drops expired activations and activations whose ability is no longer valid or allowed, keeping the others in order.
+	 *
+	 * @param Now Current time, in the same time base used to queue activations
+	 * @param ExpiryTime Time after which a queued activation is discarded, 0 or below to never expire
+	 * @param IsAllowed Returns whether the ability of a queued activation can be activated, discarded otherwise
+	 */
+	void RemoveInvalid(double Now, float ExpiryTime, TFunctionRef<bool(const UGameplayAbility*)> IsAllowed);
+
+	/** Returns the ability of the oldest valid and not expired activation, without popping anything */
+	const UGameplayAbility* Peek(double Now, float ExpiryTime) const;
+
+	/** Drops all queued activations */
+	void Reset();
+
+	int32 Num() const { return Count; }
+	int32 GetCapacity() const { return Entries.Num(); }
+	bool IsEmpty() const { return Count == 0; }
+
+private:
+	TArray<FEntry, TInlineAllocator<4>> Entries;
+
+	/** Position of the oldest activation in Entries */
+	int32 Head = 0;
+	int32 Count = 0;
+
+	static bool IsExpired(const FEntry& Entry, const double Now, const float ExpiryTime)
+	{
+		return ExpiryTime > 0.f && Now - Entry.QueuedTime > ExpiryTime;
+	}
+};
@@ -6,6 +6,7 @@
 
 #include "GameplayTagContainer.h"
 #include "Components/ActorComponent.h"
+#include "Components/GSCAbilityQueueBuffer.h"
 #include "GSCAbilityQueueComponent.generated.h"
 
 class UGSCUWDebugAbilityQueue;
@@ -30,6 +31,18 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GAS Companion|Ability Queue System")
 	bool bAbilityQueueEnabled = true;
 
+	/**
+	 * Maximum number of ability activations buffered while the ability queue is opened. When full, the oldest one is
+	 * dropped to make room for the new input. The next ability end activates the oldest one still allowed, the others are
+	 * kept for the following ability ends unless expired or not allowed.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GAS Companion|Ability Queue System", meta = (ClampMin = 1))
+	int32 AbilityQueueCapacity = 4;
+
+	/** Time in seconds after which a buffered ability activation is discarded. 0 to keep them until the next ability end */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GAS Companion|Ability Queue System", meta = (ClampMin = 0, Units = "s"))
+	float AbilityQueueExpiryTime = 0.f;
+
 	/** Setup GetOwner to character and sets references for ability system component and the owner itself. */
 	void SetupOwner();
 
@@ -57,14 +70,23 @@ public:
 
 	bool IsAllAbilitiesAllowedForAbilityQueue() const;
 
+	/** Returns whether the given ability can be queued / activated from the queue, with the current allowed abilities */
+	bool IsAbilityAllowedForAbilityQueue(const UGameplayAbility* Ability) const;
+
+	/** Returns the ability of the next buffered activation (the oldest one) */
     const UGameplayAbility* GetCurrentQueuedAbility() const;
 
+	/** Returns the number of buffered ability activations */
+	int32 GetNumQueuedAbilities() const;
+
     TArray<TSubclassOf<UGameplayAbility>> GetQueuedAllowedAbilities() const;
 
 	/**
 	* Called when an ability is ended for the owner actor.
 	*
-	* The native implementation handles the ability queuing system, and invoke related BP event.
+	* The native implementation handles the ability queuing system, and invoke related BP event: activates the oldest
+	* buffered ability activation that is still allowed and not expired. Remaining activations are kept for the next
+	* ability end, except expired ones and those not allowed by the ability queue window that just ended.
 	*/
 	void OnAbilityEnded(const UGameplayAbility* InAbility);
 
@@ -72,7 +94,8 @@ public:
 	* Called when an ability failed to activated for the owner actor, passes along the failed ability
 	* and a tag explaining why.
 	*
-	* The native implementation handles the ability queuing system, and invoke related BP event.
+	* The native implementation handles the ability queuing system, and invoke related BP event: buffers the activation
+	* if the ability queue is opened and the ability allowed.
 	*/
 	void OnAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& ReasonTags);
 
@@ -81,24 +104,45 @@ public:
 	 */
 	virtual UGSCUWDebugAbilityQueue* GetDebugWidgetFromHUD();
 
+	/**
+	 * Registers the Debug Widget displaying this component state (nullptr to unregister), notified when allowed abilities change.
+	 */
+	void SetDebugWidget(UGSCUWDebugAbilityQueue* InDebugWidget);
+
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	/** Debug Widget currently displaying this component state */
+	TWeakObjectPtr<UGSCUWDebugAbilityQueue> DebugWidget;
 
 	/** Ability Queue System */
 
 	bool bAbilityQueueOpened = false;
 	bool bAllowAllAbilitiesForAbilityQueue = false;
 
-	UPROPERTY()
-	const UGameplayAbility* QueuedAbility = nullptr;
+	/** Buffered ability activations, oldest first */
+	FGSCAbilityQueueBuffer QueuedAbilities;
+
+	/** Allowed abilities, in the order they were set (for display) and hashed for lookups */
 	TArray<TSubclassOf<UGameplayAbility>> QueuedAllowedAbilities;
+	TSet<const UClass*> QueuedAllowedAbilityClasses;
+
+	/** Current time used to timestamp buffered ability activations */
+	double GetAbilityQueueTime() const;
 
 	/**
 	* Reset all variables involved in the Ability Queue System to their original default values.
 	*/
 	virtual void ResetAbilityQueueState();
 
+	/**
+	* Reset allowed abilities, leaving buffered ability activations to the next ability end.
+	*/
+	virtual void ResetAllowedAbilities();
+
 	/**
 	* Notify Debug Ability Queue Widget by updating its allowed abilities
 	*/
@@ -12,6 +12,59 @@ class UAbilitySystemComponent;
 class UGSCGameplayAbility;
 class ACharacter;
 
+/**
+ * Replicated state of the combo system, packed in a single byte on the wire (combo flags in the low bits, combo index
+ * in the high bits, with an extra packed int for the rare combo chains longer than what fits in there).
+ *
+ * Filled from UGSCComboManagerComponent properties right before replication and copied back into them on clients.
+ */
+USTRUCT(BlueprintType)
+struct GASCOMPANION_API FGSCComboState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
+	int32 ComboIndex = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
+	bool bComboWindowOpened = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
+	bool bShouldTriggerCombo = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
+	bool bRequestTriggerCombo = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
+	bool bNextComboAbilityActivated = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGSCComboState& Other) const
+	{
+		return ComboIndex == Other.ComboIndex
+			&& bComboWindowOpened == Other.bComboWindowOpened
+			&& bShouldTriggerCombo == Other.bShouldTriggerCombo
+			&& bRequestTriggerCombo == Other.bRequestTriggerCombo
+			&& bNextComboAbilityActivated == Other.bNextComboAbilityActivated;
+	}
+
+	bool operator!=(const FGSCComboState& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSCComboState> : public TStructOpsTypeTraitsBase2<FGSCComboState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 UCLASS(BlueprintType, Blueprintable, ClassGroup=("GAS Companion"), meta=(BlueprintSpawnableComponent))
 class GASCOMPANION_API UGSCComboManagerComponent : public UActorComponent
 {
@@ -34,27 +87,31 @@ public:
 	/** Reference to GA_GSC_Melee_Base */
 	TSubclassOf<UGSCGameplayAbility> MeleeBaseAbility;
 
-	/** The combo index for the currently active combo */
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GAS Companion|Combo")
+	/** The combo index for the currently active combo (replicated via ReplicatedComboState) */
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
 	int32 ComboIndex = 0;
 
-	/** Whether or not the combo window is opened (eg. player can queue next combo within this window) */
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GAS Companion|Combo")
+	/** Whether or not the combo window is opened (eg. player can queue next combo within this window) (replicated via ReplicatedComboState) */
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
 	bool bComboWindowOpened = false;
 
-	/** Should we queue the next combo montage for the currently active combo */
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GAS Companion|Combo")
+	/** Should we queue the next combo montage for the currently active combo (replicated via ReplicatedComboState) */
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
 	bool bShouldTriggerCombo = false;
 
-	/** Should we trigger the next combo montage */
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GAS Companion|Combo")
+	/** Should we trigger the next combo montage (replicated via ReplicatedComboState) */
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
 	bool bRequestTriggerCombo = false;
 
-	/** Should we trigger the next combo montage */
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GAS Companion|Combo")
+	/** Should we trigger the next combo montage (replicated via ReplicatedComboState) */
+	UPROPERTY(BlueprintReadOnly, Category = "GAS Companion|Combo")
 	bool bNextComboAbilityActivated = false;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/** Returns the current combo state, as it is replicated */
+	FGSCComboState GetComboState() const;
 
 	/** Setup GetOwner to character and sets references for ability system component and the owner itself. */
 	void SetupOwner();
@@ -76,6 +133,23 @@ public:
 
 	void SetComboIndex(int32 InComboIndex);
 
+	/**
+	 * Part of the combo system, opens the combo window (authority only, from UGSCComboWindowNotifyState begin).
+	 *
+	 * @param bInEndCombo Whether the montage opening this window is the last one of the combo chain
+	 */
+	void OpenComboWindow(bool bInEndCombo);
+
+	/**
+	 * Part of the combo system, closes the combo window and resets the combo state (authority only, from UGSCComboWindowNotifyState end).
+	 *
+	 * @param bInEndCombo Whether the montage closing this window is the last one of the combo chain
+	 */
+	void CloseComboWindow(bool bInEndCombo);
+
+	/** Part of the combo system, requests the next combo to be triggered (authority only, from UGSCTriggerComboNotify) */
+	void RequestTriggerCombo();
+
 	/** Returns true if this component's actor has authority */
 	virtual bool IsOwnerActorAuthoritative() const;
 
@@ -87,22 +161,40 @@ protected:
 	//~Begin UActorComponent interface
 	virtual void BeginPlay() override;
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	//~End UActorComponent interface
 
+	/** Combo state sent to clients, packed from the properties above in PreReplication */
+	UPROPERTY(ReplicatedUsing=OnRep_ComboState)
+	FGSCComboState ReplicatedComboState;
+
+	UFUNCTION()
+	virtual void OnRep_ComboState();
+
+	/** Combo input from the owning client. Resulting combo state reaches every client through ReplicatedComboState */
 	UFUNCTION(Server, Reliable)
 	void ServerActivateComboAbility(TSubclassOf<UGSCGameplayAbility> AbilityClass, bool bAllowRemoteActivation = true);
 
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastActivateComboAbility(TSubclassOf<UGSCGameplayAbility> AbilityClass, bool bAllowRemoteActivation = true);
-
 	void ActivateComboAbilityInternal(TSubclassOf<UGSCGameplayAbility> AbilityClass, bool bAllowRemoteActivation = true);
 
+	/** Whether the currently opened combo window was opened by the last montage of the combo chain */
+	bool bComboWindowEnding = false;
+
+	/** Pending retry of TryTriggerCombo() when the next combo ability failed to activate */
+	FTimerHandle TriggerComboRetryTimerHandle;
+
+	/**
+	 * Activates the next combo ability once the combo window is opened, the player queued up the next combo and the
+	 * trigger was requested. Called whenever one of these changes, the combo system doesn't poll for it.
+	 *
+	 * If activation fails, it is retried on next frame for as long as the window stays opened.
+	 */
+	void TryTriggerCombo();
+
+	/** Combo index set by the owning client */
 	UFUNCTION(Server, Reliable)
 	void ServerSetComboIndex(int32 InComboIndex);
 
-	UFUNCTION(NetMulticast, Reliable)
-	void MulticastSetComboIndex(int32 InComboIndex);
-
 private:
 	/** Caches the flags that indicate whether this component has network authority. */
 	void CacheIsNetSimulated();
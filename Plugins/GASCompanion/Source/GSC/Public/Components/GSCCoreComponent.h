@@ -10,12 +10,14 @@
 #include "UI/GSCUWHud.h"
 #include "GSCCoreComponent.generated.h"
 
+class FGSCCooldownTracker;
 class UGSCGameplayAbility;
 class UGameplayAbility;
 class UGameplayEffect;
 class UAbilitySystemComponent;
 class UGSCAttributeSetBase;
 struct FGameplayAbilitySpecHandle;
+struct FGameplayAbilitySpec;
 
 /** Structure passed down to Actors Blueprint with PostGameplayEffectExecute Event */
 USTRUCT(BlueprintType)
@@ -297,6 +299,10 @@ public:
 	UFUNCTION(BlueprintPure, Category="GAS Companion|Abilities")
     bool IsUsingAbilityByTags(FGameplayTagContainer AbilityTags);
 
+	/** Returns whether one of the actor's active abilities is matching the provided Ability Class, stopping at the first match */
+	UFUNCTION(BlueprintPure, Category="GAS Companion|Abilities")
+	bool HasActiveAbilityOfClass(TSubclassOf<UGameplayAbility> AbilityClass) const;
+
 	/**
 	* Returns a list of currently active ability instances that match the given class
 	*
@@ -305,6 +311,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category="GAS Companion|Abilities")
 	TArray<UGameplayAbility*> GetActiveAbilitiesByClass(TSubclassOf<UGameplayAbility> AbilityToSearch) const;
 
+	/**
+	* Invokes Visitor for every currently active ability instance that match the given class.
+	*
+	* Walks the ASC ability specs in place, without copying them or allocating any temporary array.
+	*
+	* @param AbilityToSearch The Gameplay Ability Class to search for
+	* @param Visitor Called with each active instance, return false to stop iterating
+	*/
+	void ForEachActiveAbilityByClass(TSubclassOf<UGameplayAbility> AbilityToSearch, TFunctionRef<bool(UGameplayAbility*)> Visitor) const;
+
+	/**
+	* Invokes Visitor for every currently active ability instance that match all of the given tags. An empty container matches nothing.
+	*
+	* Walks the ASC ability specs in place, without copying them or allocating any temporary array.
+	*
+	* @param GameplayTagContainer The Ability Tags to search for
+	* @param Visitor Called with each active instance, return false to stop iterating
+	*/
+	void ForEachActiveAbilityByTags(const FGameplayTagContainer& GameplayTagContainer, TFunctionRef<bool(UGameplayAbility*)> Visitor) const;
+
+	/** Returns the first currently active ability instance that match the given class, or nullptr if there is none */
+	UGameplayAbility* FindFirstActiveAbilityByClass(TSubclassOf<UGameplayAbility> AbilityToSearch) const;
+
+	/** Returns the first currently active ability instance that match all of the given tags, or nullptr if there is none */
+	UGameplayAbility* FindFirstActiveAbilityByTags(const FGameplayTagContainer& GameplayTagContainer) const;
+
 	/**
 	* Returns a list of currently active ability instances that match the given tags
 	*
@@ -469,6 +501,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="GAS Companion|Ability")
 	FGSCOnCooldownChanged OnCooldownStart;
 
+	/** Called when a cooldown is still active past its expected expiration (cooldown was extended), with updated time remaining and duration */
+	UPROPERTY(BlueprintAssignable, Category="GAS Companion|Ability")
+	FGSCOnCooldownChanged OnCooldownChanged;
+
 	/** Called when a cooldown gameplay tag is removed, meaning cooldown expired */
 	UPROPERTY(BlueprintAssignable, Category="GAS Companion|Ability")
 	FGSCOnCooldownEnd OnCooldownEnd;
@@ -476,6 +512,8 @@ public:
 protected:
 	//~ Begin UActorComponent interface
 	virtual void BeginPlay() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	//~ End UActorComponent interface
 
 	//~ Begin UObject interface
@@ -511,10 +549,20 @@ protected:
 	/** Trigger by ASC when an ability is committed (cost / cooldown are applied)  */
 	void OnAbilityCommitted(UGameplayAbility *ActivatedAbility);
 
-	/** Trigger by ASC when a cooldown tag is changed (new or removed)  */
+	/** Triggered by ASC cooldown tracker when an ability with a valid cooldown is committed */
+	virtual void OnTrackedCooldownStart(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, float TimeRemaining, float Duration);
+
+	/** Triggered by ASC cooldown tracker when a cooldown time remaining changed */
+	virtual void OnTrackedCooldownChanged(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, float TimeRemaining, float Duration);
+
+	/** Triggered by ASC cooldown tracker when a cooldown tag is removed, forwards to OnCooldownGameplayTagChanged() */
+	virtual void OnTrackedCooldownEnd(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTag& CooldownTag, float Duration);
+
+	/** Triggered by ASC cooldown tracker when a cooldown tag is removed (NewCount is always 0), broadcasts OnCooldownEnd */
 	virtual void OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, int32 NewCount, FGameplayAbilitySpecHandle AbilitySpecHandle, float Duration);
 
 	/** Manage cooldown events trigger when an ability is committed */
+	UE_DEPRECATED(4.27, "Cooldowns are tracked by the ASC cooldown tracker (see UGSCCooldownSubsystem), which triggers OnTrackedCooldownStart(). This only broadcasts OnCooldownStart.")
 	void HandleCooldownOnAbilityCommit(UGameplayAbility* ActivatedAbility);
 
 	/** Helper to get HUD UserWidget from player controller (if any) */
@@ -522,9 +570,15 @@ protected:
 	UGSCUWHud* GetHUDWidget() const;
 
 private:
+	/** Walks ASC ability specs in place and invokes Visitor for each active instance of the specs accepted by SpecFilter */
+	void ForEachActiveAbility(TFunctionRef<bool(const FGameplayAbilitySpec&)> SpecFilter, TFunctionRef<bool(UGameplayAbility*)> Visitor) const;
+
+	/** Invokes Visitor for each active instance of the spec. Returns false if Visitor requested to stop iterating */
+	static bool VisitActiveAbilityInstances(const FGameplayAbilitySpec& Spec, TFunctionRef<bool(UGameplayAbility*)> Visitor);
+
 	/** Array of active GE handle bound to delegates that will be fired when the count for the key tag changes to or away from zero */
 	TArray<FActiveGameplayEffectHandle> GameplayEffectAddedHandles;
 
-	/** Array of tags bound to delegates that will be fired when the count for the key tag changes to or away from zero */
-	TArray<FGameplayTag> GameplayTagBoundToDelegates;
+	/** Cooldown tracker of the owner ASC, shared with other listeners and bound to cooldown tags in our stead */
+	TSharedPtr<FGSCCooldownTracker> CooldownTracker;
 };
@@ -44,6 +44,72 @@ public:
 	UFUNCTION(exec)
 	void GSC_OpenComboDebug();
 
+	/**
+	 * Replays the combo state changes of a NumSwings combo chain and logs the replicated bytes per swing, comparing the
+	 * packed FGSCComboState with the previous layout (one replicated property per combo flag, plus the multicast RPC
+	 * pairs sent to NumConnections relevant connections).
+	 *
+	 * Only measures the combo payload, use "stat net" or the Network Profiler for the full picture in a PIE session.
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkComboReplication(int32 NumSwings = 3, int32 NumConnections = 16) const;
+
+	/**
+	 * Fires NumProjectiles base projectiles, InFlight at a time, once with spawn / destroy and once through the projectile pool,
+	 * and logs the time spent spawning (or acquiring), destroying (or releasing) and in the following garbage collection.
+	 * Pooled base projectiles are destroyed afterwards.
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkProjectilePool(int32 NumProjectiles = 10000, int32 InFlight = 100) const;
+
+	/**
+	 * Spawns NumCandidates collision actors around a targeting actor and runs the native overlap target types (sphere, box,
+	 * capsule, cone) against them. Logs the average cost of a query, and checks the returned targets against the shape
+	 * (missing targets, targets outside of it and distance ordering).
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkTargetTypes(int32 NumCandidates = 1000, int32 Iterations = 100) const;
+
+	/**
+	 * Builds effect container target data for NumHits hit results, once with a single target hit target data per hit and
+	 * once with FGSCGameplayEffectContainerSpec::AddTargets packing hit results, and logs the number of target data entries,
+	 * heap allocations and build time of both. Logs an error if packing doesn't allocate less.
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkTargetData(int32 NumHits = 500, int32 Iterations = 100) const;
+
+	/**
+	 * Applies an effect container of NumEffects instant effects to NumTargets transient actors with the default GAS Companion
+	 * AttributeSet, once spec by spec through target data built with one single target hit per hit (as AddTargets used to),
+	 * and once with FGSCGameplayEffectContainerSpec::ApplyToTargets. Logs effects applied per millisecond for both, and checks
+	 * resulting attribute values are identical (batched application checked with and without packed hit results).
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkEffectContainer(int32 NumTargets = 300, int32 NumEffects = 3, int32 Iterations = 20) const;
+
+	/**
+	 * Calls CanActivateAbility NumChecks times for each ability granted to the player pawn with bLooselyCheckAbilityCost,
+	 * once with GSC.CacheLooseCostChecks enabled and once disabled, and logs checks per millisecond for both.
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkCostChecks(int32 NumChecks = 10000) const;
+
+	/**
+	 * Logs tracked cooldowns and cooldown tag subscriptions of every Ability System Component.
+	 *
+	 * Tag subscriptions only grow with the number of distinct cooldown tags (asserted by the GASCompanion.Cooldowns.TrackerSoak automation test).
+	 */
+	UFUNCTION(exec)
+	void GSC_DumpCooldownTrackers() const;
+
+	/**
+	 * Crowd benchmark for character significance: spawns NumCharacters characters of the player pawn class on a ring of the
+	 * given Radius around the player, forces each significance bucket (High, Medium, Low) in turn for FramesPerBucket frames
+	 * and logs average game thread and frame times per bucket. Spawned characters are destroyed once done.
+	 */
+	UFUNCTION(exec)
+	void GSC_BenchmarkCrowdSignificance(int32 NumCharacters = 100, int32 FramesPerBucket = 120, float Radius = 3000.f) const;
+
 protected:
 	// Little helper to execute command via PlayerController
 	void ExecuteConsoleCommand(FString Command) const;
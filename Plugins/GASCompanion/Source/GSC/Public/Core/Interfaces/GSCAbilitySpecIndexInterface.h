@@ -0,0 +1,62 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpec.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/Interface.h"
+#include "GSCAbilitySpecIndexInterface.generated.h"
+
+class UGameplayAbility;
+struct FGameplayTagContainer;
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, meta=(CannotImplementInterfaceInBlueprint))
+class UGSCAbilitySpecIndexInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Interface for Ability System Components that maintain a lookup index of their granted ability specs.
+ *
+ * Allows companion components to query specs by class, tags or InputID without walking the whole list of activatable
+ * abilities. Implemented by MGCAbilitySystemComponent, components fall back to a linear scan for any other ASC.
+ */
+class GASCOMPANION_API IGSCAbilitySpecIndexInterface
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the ability spec for the given handle, or nullptr if it is not (or no longer) granted */
+	virtual FGameplayAbilitySpec* FindIndexedAbilitySpecFromHandle(FGameplayAbilitySpecHandle Handle) = 0;
+
+	/** Returns the first ability spec whose Ability is exactly of the given class (same semantic as ASC FindAbilitySpecFromClass) */
+	virtual FGameplayAbilitySpec* FindIndexedAbilitySpecFromClass(TSubclassOf<UGameplayAbility> AbilityClass) = 0;
+
+	/**
+	 * Invokes Visitor for every ability spec whose Ability is of the given class, or a child of it.
+	 *
+	 * @param AbilityClass The Gameplay Ability Class to search for
+	 * @param Visitor Called with each matching spec, return false to stop iterating
+	 */
+	virtual void ForEachIndexedAbilitySpecByClass(TSubclassOf<UGameplayAbility> AbilityClass, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) = 0;
+
+	/**
+	 * Invokes Visitor for every ability spec whose Ability Tags match all of the given tags (same semantic as ASC
+	 * GetActivatableGameplayAbilitySpecsByAllMatchingTags, without checking tag requirements). An empty container matches nothing.
+	 *
+	 * @param GameplayTagContainer The Ability Tags to search for
+	 * @param Visitor Called with each matching spec, return false to stop iterating
+	 */
+	virtual void ForEachIndexedAbilitySpecByTags(const FGameplayTagContainer& GameplayTagContainer, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) = 0;
+
+	/**
+	 * Invokes Visitor for every ability spec currently bound to the given InputID.
+	 *
+	 * @param InputID The InputID to search for
+	 * @param Visitor Called with each matching spec, return false to stop iterating
+	 */
+	virtual void ForEachIndexedAbilitySpecByInputID(int32 InputID, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) = 0;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Abilities/Attributes/GSCAttributeSetBase.h"
 #include "UI/GSCUWHud.h"
+#include "Components/SkinnedMeshComponent.h"
 
 #include "GSCDeveloperSettings.generated.h"
 
@@ -25,6 +26,57 @@ struct GASCOMPANION_API FGSCAttributeSetMinimumValues
 	float MinimumValue = 0.f;
 };
 
+/** Significance buckets of characters, used to scale down their tick and animation update costs */
+UENUM(BlueprintType)
+enum class EGSCCharacterSignificance : uint8
+{
+	/** Locally controlled, or close and visible */
+	High,
+
+	/** Visible at mid range, or close but not rendered */
+	Medium,
+
+	/** Far away, or not rendered at mid range */
+	Low,
+
+	MAX UMETA(Hidden)
+};
+
+/**
+ * Tick and animation settings applied to characters of a given significance
+ */
+USTRUCT(BlueprintType)
+struct GASCOMPANION_API FGSCCharacterSignificanceSettings
+{
+	GENERATED_BODY()
+
+	FGSCCharacterSignificanceSettings() = default;
+
+	FGSCCharacterSignificanceSettings(const float InActorTickInterval, const float InMeshTickInterval, const int32 InNonRenderedAnimUpdateRate, const EVisibilityBasedAnimTickOption InVisibilityBasedAnimTickOption)
+		: ActorTickInterval(InActorTickInterval)
+		, MeshTickInterval(InMeshTickInterval)
+		, NonRenderedAnimUpdateRate(InNonRenderedAnimUpdateRate)
+		, VisibilityBasedAnimTickOption(InVisibilityBasedAnimTickOption)
+	{
+	}
+
+	/** Tick interval of the character actor, in seconds (0 to tick every frame) */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Significance", meta=(ClampMin = 0))
+	float ActorTickInterval = 0.f;
+
+	/** Tick interval of the character mesh, in seconds (0 to update animation every frame) */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Significance", meta=(ClampMin = 0))
+	float MeshTickInterval = 0.f;
+
+	/** Animation Update Rate Optimization (URO) rate, in frames, used by the mesh while it is not rendered */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Significance", meta=(ClampMin = 1))
+	int32 NonRenderedAnimUpdateRate = 4;
+
+	/** How the mesh ticks its pose and refreshes its bones when it is not rendered */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Significance")
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+};
+
 /**
  * General Settings for GAS Companion Plugin.
  *
@@ -48,6 +100,14 @@ public:
 
 	UGSCDeveloperSettings(const FObjectInitializer& ObjectInitializer);
 
+	//~ Begin UObject interface
+	virtual void PostInitProperties() override;
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject interface
+
 	/**
 	 * Turn this on to prevent GAS Companion module to initialize UAbilitySystemGlobals (InitGlobalData) in the plugin StartupModule method.
 	 *
@@ -69,10 +129,54 @@ public:
 	 * even if the applied cost would go into negative values, and only prevented if the attribute is 0 or below.
 	 *
 	 * (ex. If you have a regeneration effect on an attribute, it would then take longer for the attribute to go positive again)
+	 *
+	 * Values are shared by all Attribute Sets through FGSCAttributeClampTable, rebuilt whenever this setting changes.
 	 */
 	UPROPERTY(Config, EditAnywhere, Category = "Attribute Sets")
 	TArray<FGSCAttributeSetMinimumValues> MinimumValues;
 
+	/**
+	 * Turn this on to have GAS Companion characters (GSCCharacterBase, GSCALSModCharacter) registered with the Significance Manager.
+	 *
+	 * Their actor tick interval, animation update rate and visibility based anim tick option are then scaled down based on
+	 * their distance to the closest player viewpoint and whether they were recently rendered (see UGSCSignificanceSubsystem).
+	 *
+	 * Locally controlled characters always use High significance settings. On authority, characters playing a montage always tick
+	 * their pose and refresh bones from the moment a montage starts, to keep montage notifies, root motion and combo windows
+	 * correct when off screen.
+	 *
+	 * Disabled by default, characters keep their own tick settings unless this is turned on.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	bool bEnableCharacterSignificance = false;
+
+	/** How often, in seconds, significance of registered characters is re-evaluated */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(ClampMin = 0.01, EditCondition = "bEnableCharacterSignificance"))
+	float SignificanceUpdateInterval = 0.25f;
+
+	/** Characters closer than this distance to a player viewpoint are High significance when rendered, Medium otherwise */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(ClampMin = 0, EditCondition = "bEnableCharacterSignificance"))
+	float HighSignificanceDistance = 1500.f;
+
+	/** Characters closer than this distance to a player viewpoint are Medium significance when rendered, Low otherwise */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(ClampMin = 0, EditCondition = "bEnableCharacterSignificance"))
+	float MediumSignificanceDistance = 4000.f;
+
+	/** Settings for High significance characters. Defaults match what characters used before significance was introduced */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(EditCondition = "bEnableCharacterSignificance"))
+	FGSCCharacterSignificanceSettings HighSignificanceSettings = FGSCCharacterSignificanceSettings(0.f, 0.f, 4, EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones);
+
+	/** Settings for Medium significance characters */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(EditCondition = "bEnableCharacterSignificance"))
+	FGSCCharacterSignificanceSettings MediumSignificanceSettings = FGSCCharacterSignificanceSettings(0.f, 0.f, 8, EVisibilityBasedAnimTickOption::AlwaysTickPose);
+
+	/** Settings for Low significance characters */
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta=(EditCondition = "bEnableCharacterSignificance"))
+	FGSCCharacterSignificanceSettings LowSignificanceSettings = FGSCCharacterSignificanceSettings(0.1f, 0.066f, 16, EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered);
+
+	/** Returns the settings to apply to characters of the given significance */
+	const FGSCCharacterSignificanceSettings& GetSignificanceSettings(EGSCCharacterSignificance Significance) const;
+
 	/**
 	 * List of AttributeSet to create and attach to PlayerStates (for PlayerCharacter or Pawns with a PlayerState
 	 * where the Ability System Component is registered - GSCPlayerCharacter)
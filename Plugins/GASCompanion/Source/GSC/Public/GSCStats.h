@@ -0,0 +1,17 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Stats for GAS Companion runtime, use "stat GASCompanion" to display them
+DECLARE_STATS_GROUP(TEXT("GASCompanion"), STATGROUP_GASCompanion, STATCAT_Advanced);
+
+// Shared across companion components (ability queue, combo manager). They never tick, tick functions should stay at 0
+// unless a subclass enables ticking
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Companion Components"), STAT_GSC_CompanionComponents, STATGROUP_GASCompanion, GASCOMPANION_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Companion Component Tick Functions"), STAT_GSC_CompanionComponentTickFunctions, STATGROUP_GASCompanion, GASCOMPANION_API);
+
+// Companion debug widgets refresh from their own tick while displayed
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debug Widget Refreshes"), STAT_GSC_DebugWidgetRefreshes, STATGROUP_GASCompanion, GASCOMPANION_API);
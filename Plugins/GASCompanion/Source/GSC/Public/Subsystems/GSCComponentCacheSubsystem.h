@@ -0,0 +1,84 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSCComponentCacheSubsystem.generated.h"
+
+class UActorComponent;
+class UGSCAbilityQueueComponent;
+class UGSCComboManagerComponent;
+class UGSCCoreComponent;
+
+/**
+ * Per world cache of companion components resolved for an actor (Core, Combo Manager and Ability Queue components).
+ *
+ * Resolving a companion component goes through IGSCCompanionInterface and falls back to a component search for BP-only
+ * actors, which is a linear scan of the actor components. This is done from attribute sets, ability system component
+ * callbacks and anim notifies (some of them every frame), so found components are cached here.
+ *
+ * Null results are not cached: interface getters (BP ones in particular) may return null until the actor is fully set up.
+ * Entries are invalidated whenever a companion component is registered or unregistered for the actor.
+ *
+ * Use "stat GASCompanion" to display cache hits / misses.
+ */
+UCLASS()
+class GASCOMPANION_API UGSCComponentCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the cache subsystem for the world of the passed in actor, or nullptr if the actor is not in a world */
+	static UGSCComponentCacheSubsystem* Get(const AActor* Actor);
+
+	/** Invalidates cached components for the owner of the passed in component. To call whenever a companion component is registered / unregistered. */
+	static void InvalidateComponentOwner(const UActorComponent* Component);
+
+	//~ Begin USubsystem interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem interface
+
+	/** Returns cached Core Component for this actor, or resolves and caches it using Resolver */
+	UGSCCoreComponent* FindOrResolveCoreComponent(const AActor* Actor, TFunctionRef<UGSCCoreComponent*(const AActor*)> Resolver);
+
+	/** Returns cached Combo Manager Component for this actor, or resolves and caches it using Resolver */
+	UGSCComboManagerComponent* FindOrResolveComboManagerComponent(const AActor* Actor, TFunctionRef<UGSCComboManagerComponent*(const AActor*)> Resolver);
+
+	/** Returns cached Ability Queue Component for this actor, or resolves and caches it using Resolver */
+	UGSCAbilityQueueComponent* FindOrResolveAbilityQueueComponent(const AActor* Actor, TFunctionRef<UGSCAbilityQueueComponent*(const AActor*)> Resolver);
+
+	/** Drops any cached component for this actor */
+	void Invalidate(const AActor* Actor);
+
+	/** Number of actors with cached components */
+	int32 Num() const { return CachedActors.Num(); }
+
+private:
+	/** A cached component. Only non null results are cached, a component that got garbage collected since is a miss. */
+	template<typename ComponentType>
+	struct TCachedComponent
+	{
+		TWeakObjectPtr<ComponentType> Component;
+
+		bool IsUsable() const { return Component.IsValid(); }
+	};
+
+	struct FCachedComponents
+	{
+		TCachedComponent<UGSCCoreComponent> CoreComponent;
+		TCachedComponent<UGSCComboManagerComponent> ComboManagerComponent;
+		TCachedComponent<UGSCAbilityQueueComponent> AbilityQueueComponent;
+	};
+
+	TMap<TWeakObjectPtr<const AActor>, FCachedComponents> CachedActors;
+
+	/** Size from which entries for actors that went away (without unregistering their companion components) are purged */
+	int32 PurgeThreshold = 64;
+
+	FCachedComponents& FindOrAddEntry(const AActor* Actor);
+	void PurgeStaleEntries();
+
+	template<typename ComponentType>
+	ComponentType* FindOrResolve(const AActor* Actor, TCachedComponent<ComponentType> FCachedComponents::* Member, TFunctionRef<ComponentType*(const AActor*)> Resolver);
+};
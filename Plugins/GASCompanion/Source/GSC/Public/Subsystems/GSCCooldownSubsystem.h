@@ -0,0 +1,41 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSCCooldownSubsystem.generated.h"
+
+class FGSCCooldownTracker;
+class UAbilitySystemComponent;
+
+/**
+ * Per world registry of cooldown trackers, one per Ability System Component.
+ *
+ * Companion components and widgets listening to cooldowns of the same ASC share its tracker, so that the ASC only ever
+ * has one tag event delegate bound per cooldown tag. @see FGSCCooldownTracker
+ */
+UCLASS()
+class GASCOMPANION_API UGSCCooldownSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the cooldown tracker for this ASC, creating it if needed. Null if the ASC is not in a world. */
+	static TSharedPtr<FGSCCooldownTracker> GetCooldownTracker(UAbilitySystemComponent* AbilitySystemComponent);
+
+	//~ Begin USubsystem interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem interface
+
+	/** Logs tracked cooldowns and tag subscriptions for every tracker (see GSC_DumpCooldownTrackers cheat) */
+	void DumpTrackers() const;
+
+private:
+	TMap<TWeakObjectPtr<UAbilitySystemComponent>, TSharedPtr<FGSCCooldownTracker>> Trackers;
+
+	TSharedPtr<FGSCCooldownTracker> FindOrAddTracker(UAbilitySystemComponent* AbilitySystemComponent);
+
+	/** Drops trackers whose ASC went away */
+	void PurgeStaleTrackers();
+};
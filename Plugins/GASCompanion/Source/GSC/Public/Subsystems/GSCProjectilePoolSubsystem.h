@@ -0,0 +1,83 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSCProjectilePoolSubsystem.generated.h"
+
+class AGSCProjectileBase;
+
+/**
+ * Per world pool of projectile actors, for projectile classes with bPooled enabled.
+ *
+ * Firing a pooled projectile hands out an inactive instance of the class (prewarmed with PoolPrewarmCount instances the
+ * first time the class is requested), and falls back to spawning a new one when the pool is empty. Released projectiles
+ * are deactivated (hidden, no collision, no movement, dormant) and kept around for the next shot, instead of going
+ * through actor destruction and garbage collection. Reused instances go through the same spawn collision handling as
+ * a new spawn (see AcquireProjectile and FinishProjectile).
+ *
+ * Used by UGSCTask_SpawnProjectile. Use "stat GASCompanion" to display spawned / reused projectile counts.
+ */
+UCLASS()
+class GASCOMPANION_API UGSCProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the projectile pool for the world of the passed in object, or nullptr if it is not in a world */
+	static UGSCProjectilePoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem interface
+
+	/**
+	 * Returns a projectile of the given class to fire, either an inactive instance from the pool or a new deferred spawned one.
+	 *
+	 * Either way, spawn properties can be set on the returned projectile before calling FinishProjectile.
+	 *
+	 * Like UWorld::SpawnActor(), returns nullptr if the collision handling (CollisionHandlingOverride, or the class
+	 * SpawnCollisionHandlingMethod if Undefined) is DontSpawnIfColliding and the spawn transform is blocked.
+	 */
+	AGSCProjectileBase* AcquireProjectile(TSubclassOf<AGSCProjectileBase> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, ESpawnActorCollisionHandlingMethod CollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::Undefined);
+
+	/**
+	 * Fires a projectile returned by AcquireProjectile, finishing its spawn if it is a new one.
+	 *
+	 * Reused projectiles are moved to a free spot with the AdjustIfPossible collision handling methods, like a new spawn.
+	 *
+	 * @return False if the projectile did not spawn (spawn destroyed it, or no free spot with AdjustIfPossibleButDontSpawnIfColliding),
+	 * a reused projectile is put back into the pool in that case
+	 */
+	bool FinishProjectile(AGSCProjectileBase* Projectile, const FTransform& SpawnTransform);
+
+	/** Deactivates the projectile and puts it back into the pool, or destroys it if the pool for its class is full */
+	void ReleaseProjectile(AGSCProjectileBase* Projectile);
+
+	/** Spawns inactive instances of the given class in the pool, up to Count (and within the class MaxPoolSize) */
+	UFUNCTION(BlueprintCallable, Category = "GAS Companion|Projectile")
+	void PrewarmProjectiles(TSubclassOf<AGSCProjectileBase> Class, int32 Count);
+
+	/** Number of inactive instances of the given class currently in the pool */
+	int32 NumAvailable(TSubclassOf<AGSCProjectileBase> Class) const;
+
+	/**
+	 * Destroys every inactive instance of the given class in the pool. The next acquire for this class prewarms the pool again.
+	 *
+	 * @return Number of destroyed projectiles
+	 */
+	int32 DrainProjectiles(TSubclassOf<AGSCProjectileBase> Class);
+
+private:
+	typedef TArray<TWeakObjectPtr<AGSCProjectileBase>> FProjectileList;
+
+	/** Inactive projectiles, per class */
+	TMap<TWeakObjectPtr<UClass>, FProjectileList> AvailableProjectiles;
+
+	/** Classes that already went through their initial prewarm */
+	TSet<TWeakObjectPtr<UClass>> PrewarmedClasses;
+
+	AGSCProjectileBase* SpawnPooledProjectile(TSubclassOf<AGSCProjectileBase> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, ESpawnActorCollisionHandlingMethod CollisionHandlingOverride) const;
+};
@@ -0,0 +1,129 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Settings/GSCDeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/StrongObjectPtr.h"
+#include "GSCSignificanceSubsystem.generated.h"
+
+class ACharacter;
+class UAnimInstance;
+class UAnimMontage;
+
+/** Forwards montage starts of a registered character anim instance to the significance subsystem */
+UCLASS(Transient)
+class GASCOMPANION_API UGSCSignificanceMontageListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	TWeakObjectPtr<ACharacter> Character;
+	TWeakObjectPtr<UAnimInstance> AnimInstance;
+
+	UFUNCTION()
+	void OnMontageStarted(UAnimMontage* Montage);
+};
+
+/**
+ * Per world registry of GAS Companion characters with the Significance Manager, when bEnableCharacterSignificance is
+ * enabled in GAS Companion settings.
+ *
+ * Every SignificanceUpdateInterval, registered characters are sorted into High / Medium / Low significance based on their
+ * distance to the closest player viewpoint and whether their mesh was recently rendered. Each bucket scales down actor
+ * tick interval, mesh tick interval, URO non rendered update rate and visibility based anim tick option (see
+ * FGSCCharacterSignificanceSettings).
+ *
+ * Locally controlled characters are always High significance. On authority, characters playing a montage always tick their
+ * pose and refresh bones every frame, so that montage notifies, root motion and combo windows stay correct off screen. This
+ * is applied as soon as the montage starts, without waiting for the next update.
+ *
+ * Use "stat GASCompanion" to display the number of characters per significance bucket.
+ */
+UCLASS()
+class GASCOMPANION_API UGSCSignificanceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the significance subsystem for the world of the passed in object, or nullptr if it is not in a world */
+	static UGSCSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem interface
+
+	/** Registers the character with the Significance Manager (no-op if character significance is disabled in settings) */
+	void RegisterCharacter(ACharacter* Character);
+
+	/** Unregisters the character from the Significance Manager */
+	void UnregisterCharacter(ACharacter* Character);
+
+	/** Returns the current significance of a registered character (High if not registered) */
+	UFUNCTION(BlueprintPure, Category = "GAS Companion|Significance")
+	EGSCCharacterSignificance GetCharacterSignificance(const ACharacter* Character) const;
+
+	/** Forces all registered characters (except locally controlled ones) into the given significance, mainly for profiling */
+	void SetForcedSignificance(EGSCCharacterSignificance Significance);
+
+	/** Clears significance forced with SetForcedSignificance */
+	void ClearForcedSignificance();
+
+	/** Re-evaluates significance of all registered characters and applies their tick / animation settings */
+	void UpdateSignificance();
+
+	/** Re-applies the tick / animation settings of a registered character that just started a montage, so it ticks at full rate right away on authority */
+	void OnCharacterMontageStarted(ACharacter* Character);
+
+	/** Number of characters currently registered */
+	int32 NumRegisteredCharacters() const { return RegisteredCharacters.Num(); }
+
+	/**
+	 * Runs a crowd benchmark over the passed in characters: forces each significance bucket in turn for FramesPerBucket frames
+	 * and logs the average game thread and frame times of each bucket. Characters are destroyed once done.
+	 */
+	void RunCrowdBenchmark(const TArray<ACharacter*>& Characters, int32 FramesPerBucket);
+
+private:
+	/** Characters registered with the significance manager */
+	TSet<TWeakObjectPtr<ACharacter>> RegisteredCharacters;
+
+	/** Montage start listeners of registered characters, on authority only */
+	TMap<TWeakObjectPtr<ACharacter>, TStrongObjectPtr<UGSCSignificanceMontageListener>> MontageListeners;
+
+	/** Binds / unbinds montage start of the character anim instance */
+	void AddMontageListener(ACharacter* Character);
+	void RemoveMontageListener(ACharacter* Character);
+
+	/** Significance all characters are forced into, if any */
+	TOptional<EGSCCharacterSignificance> ForcedSignificance;
+
+	FTimerHandle UpdateTimerHandle;
+
+	/** Crowd benchmark state */
+	struct FCrowdBenchmark
+	{
+		TArray<TWeakObjectPtr<ACharacter>> Characters;
+		int32 FramesPerBucket = 0;
+		int32 Bucket = 0;
+		int32 Frame = 0;
+		double GameThreadMs[(int32)EGSCCharacterSignificance::MAX] = {};
+		double FrameMs[(int32)EGSCCharacterSignificance::MAX] = {};
+	};
+
+	TOptional<FCrowdBenchmark> CrowdBenchmark;
+
+	/** Steps the crowd benchmark by one frame */
+	void TickCrowdBenchmark();
+
+	/** Significance of the character for a single viewpoint, as a float for the significance manager (higher is more significant) */
+	float CalculateSignificance(const ACharacter* Character, const FTransform& Viewpoint) const;
+
+	/** Applies the tick / animation settings of the character significance */
+	void ApplySignificance(ACharacter* Character, EGSCCharacterSignificance Significance) const;
+
+	static EGSCCharacterSignificance ToSignificance(float SignificanceValue);
+	static float ToSignificanceValue(EGSCCharacterSignificance Significance);
+};
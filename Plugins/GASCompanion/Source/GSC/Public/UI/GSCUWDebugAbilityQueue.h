@@ -43,7 +43,8 @@ public:
 	/**
 	 * Adds a new Anim montage into the AbilityQueueFromMontage Panel.
 	 *
-	 * The entry can be eventually cleared and remove from the screen after a set amount of time (ClearFromMontageDelay)
+	 * The entry can be eventually cleared and remove from the screen after a set amount of time (ClearFromMontageDelay).
+	 * Past MaxFromMontageRows, the oldest row is removed right away and its text block reused for the new one.
 	 *
 	 * @param Anim The Animation from which the ability queue has been opened
 	 * @param bStartClearTimer Start the clear timer immediately if true (defaults: true)
@@ -51,20 +52,52 @@ public:
 	virtual void AddAbilityQueueFromMontageRow(UAnimSequenceBase* Anim, bool bStartClearTimer = true);
 
 	/**
-	 * Start the clear timer for Montage rows
+	 * Start the clear timer for the oldest Montage row without one
 	 */
 	virtual void StartClearFromMontageRowTimer();
 
+	/**
+	 * Refresh the Ability Queue state texts from the Owner Ability Queue Component.
+	 *
+	 * Called from the widget tick, only while it is displayed, the component itself never ticks. Texts are only updated
+	 * for the parts of the queue state that changed since last refresh.
+	 */
+	virtual void RefreshDebugState();
+
+	/** Returns the number of "From Montage" rows currently on screen */
+	int32 GetNumFromMontageRows() const;
+
+	/** Returns the number of "From Montage" rows waiting for their clear timer */
+	int32 GetNumPendingFromMontageRowClears() const { return ClearFromMontageTimes.Num(); }
+
 protected:
 
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	virtual void ClearFromMontageRow();
 
+	/** Sets the clear timer for the oldest "From Montage" row with a started clear timer, or clears it if there is none */
+	void ScheduleClearFromMontageRow();
+
+	/** Returns the text block at Index in Box if any, or a new one duplicated from Template */
+	UTextBlock* GetOrDuplicateTextBlock(UVerticalBox* Box, int32 Index, UTextBlock* Template);
+
 	TWeakObjectPtr<AActor> OwnerActor;
 	TWeakObjectPtr<UGSCAbilityQueueComponent> OwnerAbilityQueueComponent;
 
-	TArray<FTimerHandle> ClearFromMontageTimerHandles;
+	/** Single timer, set for the next "From Montage" row to clear */
+	FTimerHandle ClearFromMontageTimerHandle;
+
+	/** World time at which each "From Montage" row with a started clear timer is due to be removed, oldest row first */
+	TArray<float> ClearFromMontageTimes;
+
+	/** Queue state currently displayed, valid only if bHasDisplayedState is true */
+	bool bHasDisplayedState = false;
+	bool bDisplayedAbilityQueueEnabled = false;
+	bool bDisplayedAbilityQueueOpened = false;
+	bool bDisplayedAllowAllAbilities = false;
+	TWeakObjectPtr<const UGameplayAbility> DisplayedQueuedAbility;
 
 	FLinearColor WhiteColor = FLinearColor(1.f, 1.f, 1.f, 1.f);
 	FLinearColor GreenColor = FLinearColor(0.729412f, 0.854902f, 0.333333f, 1.f);
@@ -76,6 +109,12 @@ protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GAS Companion|UserWidget")
 	float ClearFromMontageDelay = 8.f;
 
+	/**
+	 * Maximum number of "From Montage" rows on screen, oldest rows are removed first
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GAS Companion|UserWidget", meta = (ClampMin = 1))
+	int32 MaxFromMontageRows = 10;
+
 	UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "GAS Companion|UI")
 	UTextBlock* AbilityQueueEnabledText = nullptr;
 
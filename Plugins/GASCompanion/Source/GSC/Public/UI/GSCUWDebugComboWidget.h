@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UI/GSCUserWidget.h"
+#include "Components/GSCComboManagerComponent.h"
 #include "GSCUWDebugComboWidget.generated.h"
 
 class UGSCComboManagerComponent;
@@ -45,7 +46,21 @@ public:
 	*/
 	virtual void SetOwnerActor(AActor* Actor) override;
 
+	/**
+	 * Refresh the Combo state texts from the Owner Combo Manager Component.
+	 *
+	 * Called from the widget tick, only while it is displayed, the component itself never ticks. Texts are only updated
+	 * for the parts of the combo state that changed since last refresh.
+	 */
+	virtual void RefreshDebugState();
+
 protected:
 
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	/** Combo state currently displayed, valid only if bHasDisplayedComboState is true */
+	FGSCComboState DisplayedComboState;
+	bool bHasDisplayedComboState = false;
 };
@@ -9,6 +9,7 @@
 #include "GSCUWHud.generated.h"
 
 struct FGameplayAbilitySpecHandle;
+class FGSCCooldownTracker;
 class UProgressBar;
 class UTextBlock;
 class UGSCCoreComponent;
@@ -48,6 +49,25 @@ struct FGSCGameplayEffectUIData
 	}
 };
 
+/** Attribute change waiting for the next HUD flush. Old value is the one before the first change since last flush */
+struct FGSCHUDPendingAttributeChange
+{
+	float NewValue = 0.f;
+	float OldValue = 0.f;
+};
+
+/** Gameplay Effect stack / time change waiting for the next HUD flush */
+struct FGSCHUDPendingEffectChange
+{
+	bool bStackChanged = false;
+	int32 NewStackCount = 0;
+	int32 OldStackCount = 0;
+
+	bool bTimeChanged = false;
+	float NewStartTime = 0.f;
+	float NewDuration = 0.f;
+};
+
 
 UCLASS(Abstract, Blueprintable)
 class GASCOMPANION_API UGSCUWHud : public UGSCUserWidget
@@ -56,6 +76,23 @@ class GASCOMPANION_API UGSCUWHud : public UGSCUserWidget
 
 public:
 
+	/**
+	 * If true, attribute and Gameplay Effect stack / time changes are collected and pushed to the HUD once per flush
+	 * (see HUDUpdateInterval) instead of right away, so that several changes to the same bar in a frame only update it once.
+	 *
+	 * Gameplay Effects added / removed, tags and cooldowns events are always handled right away.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GAS Companion|UI")
+	bool bCoalesceHUDUpdates = true;
+
+	/** Time in seconds between two flushes of coalesced HUD updates. 0 to flush them on next tick */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GAS Companion|UI", meta = (ClampMin = 0, Units = "s", EditCondition = "bCoalesceHUDUpdates"))
+	float HUDUpdateInterval = 0.f;
+
+	/** Pushes coalesced attribute and Gameplay Effect changes to the HUD now */
+	UFUNCTION(BlueprintCallable, Category = "GAS Companion|UI")
+	void FlushPendingHUDUpdates();
+
 	/**
 	 * Runs initialization logic for this UserWidget related to HUD and interaction with Ability System Component.
 	 *
@@ -119,16 +156,16 @@ public:
 	virtual void HandleAttributeChange(FGameplayAttribute Attribute, float NewValue, float OldValue);
 
 	// called by CCC whenever a gameplay effect is added or removed
-	virtual void HandleGameplayEffectStackChange(FGameplayTagContainer AssetTags, FGameplayTagContainer GrantedTags, FActiveGameplayEffectHandle ActiveHandle, int32 NewStackCount, int32 OldStackCount);
+	virtual void HandleGameplayEffectStackChange(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, FActiveGameplayEffectHandle ActiveHandle, int32 NewStackCount, int32 OldStackCount);
 
 	// called by CCC whenever a gameplay effect time is changed
-	virtual void HandleGameplayEffectTimeChange(FGameplayTagContainer AssetTags, FGameplayTagContainer GrantedTags, FActiveGameplayEffectHandle ActiveHandle, float NewStartTime, float NewDuration);
+	virtual void HandleGameplayEffectTimeChange(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, FActiveGameplayEffectHandle ActiveHandle, float NewStartTime, float NewDuration);
 
 	// called by CCC whenever a gameplay effect is added
-	virtual void HandleGameplayEffectAdded(FGameplayTagContainer AssetTags, FGameplayTagContainer GrantedTags, FActiveGameplayEffectHandle ActiveHandle);
+	virtual void HandleGameplayEffectAdded(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, FActiveGameplayEffectHandle ActiveHandle);
 
 	// called by CCC whenever a gameplay effect is removed
-	virtual void HandleGameplayEffectRemoved(FGameplayTagContainer AssetTags, FGameplayTagContainer GrantedTags, FActiveGameplayEffectHandle ActiveHandle);
+	virtual void HandleGameplayEffectRemoved(const FGameplayTagContainer& AssetTags, const FGameplayTagContainer& GrantedTags, FActiveGameplayEffectHandle ActiveHandle);
 
 	// called by CCC whenever a gameplay tag is added or removed
 	virtual void HandleGameplayTagChange(FGameplayTag GameplayTag, int32 NewTagCount);
@@ -229,18 +266,37 @@ protected:
 	/** Trigger by ASC when any gameplay tag is added or removed (but not if just count is increased. Only for 'new' and 'removed' events) */
 	virtual void OnAnyGameplayTagChanged(FGameplayTag GameplayTag, int32 NewCount);
 
-	/** Trigger by ASC when an ability is committed (cost / cooldown are applied)  */
+	/** Trigger by ASC when an ability is committed (cost / cooldown are applied). Cooldown display is started from OnTrackedCooldownStart() */
 	virtual void OnAbilityCommitted(UGameplayAbility *ActivatedAbility);
 
-	/** Trigger by ASC when a cooldown tag is changed (new or removed)  */
+	/** Triggered by ASC cooldown tracker when a cooldown tag is removed (NewCount is always 0), calls HandleCooldownEnd */
 	virtual void OnCooldownGameplayTagChanged(const FGameplayTag GameplayTag, int32 NewCount, FGameplayAbilitySpecHandle AbilitySpecHandle, float Duration);
 
+	/** Triggered by ASC cooldown tracker when an ability with a valid cooldown is committed */
+	virtual void OnTrackedCooldownStart(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, float TimeRemaining, float Duration);
+
+	/** Triggered by ASC cooldown tracker when a cooldown time remaining changed */
+	virtual void OnTrackedCooldownChanged(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTagContainer& CooldownTags, float TimeRemaining, float Duration);
+
+	/** Triggered by ASC cooldown tracker when a cooldown tag is removed, forwards to OnCooldownGameplayTagChanged() */
+	virtual void OnTrackedCooldownEnd(FGameplayAbilitySpecHandle AbilitySpecHandle, UGameplayAbility* Ability, const FGameplayTag& CooldownTag, float Duration);
+
 private:
-	/** Array of active GE handle bound to delegates that will be fired when the count for the key tag changes to or away from zero */
-	TArray<FActiveGameplayEffectHandle> GameplayEffectAddedHandles;
+	/** Active GE handles bound to stack / time change delegates, removed along with their effect */
+	TSet<FActiveGameplayEffectHandle> GameplayEffectAddedHandles;
+
+	/** Coalesced changes waiting for the next flush */
+	TMap<FGameplayAttribute, FGSCHUDPendingAttributeChange> PendingAttributeChanges;
+	TMap<FActiveGameplayEffectHandle, FGSCHUDPendingEffectChange> PendingEffectChanges;
+
+	FTimerHandle FlushHUDUpdatesTimerHandle;
+	bool bHUDUpdateScheduled = false;
+
+	/** Schedules a flush of pending HUD updates, if not already scheduled */
+	void ScheduleHUDUpdate();
 
-	/** Array of tags bound to delegates that will be fired when the count for the key tag changes to or away from zero */
-	TArray<FGameplayTag> GameplayTagBoundToDelegates;
+	/** Cooldown tracker of the owning ASC, shared with other listeners and bound to cooldown tags in our stead */
+	TSharedPtr<FGSCCooldownTracker> CooldownTracker;
 
 	static FString GetAttributeFormatString(float BaseValue, float MaxValue);
 	static FGSCGameplayEffectUIData GetGameplayEffectUIData(FActiveGameplayEffectHandle ActiveHandle);
@@ -7,6 +7,7 @@
 #include "GSCUserWidget.generated.h"
 
 class UGSCCoreComponent;
+class UTextBlock;
 struct FGameplayAttribute;
 
 UCLASS()
@@ -27,4 +28,11 @@ public:
 	/** Helper function to return percentage from Attribute / MaxAttribute */
 	UFUNCTION(BlueprintPure, Category="GAS Companion|UI")
 	float GetPercentForAttributes(FGameplayAttribute Attribute, FGameplayAttribute MaxAttribute);
+
+protected:
+	/** Returns a shared "true" / "false" text, so that debug widgets don't build a new FText for each update */
+	static const FText& GetBoolText(bool bValue);
+
+	/** Sets TextBlock (if any) to the shared "true" / "false" text, colored with TrueColor / FalseColor */
+	static void SetBoolText(UTextBlock* TextBlock, bool bValue, const FLinearColor& TrueColor, const FLinearColor& FalseColor);
 };
@@ -38,6 +38,7 @@ public class ModularGASCompanion : ModuleRules
 				"GameFeatures",
 				"Json",
 				 "ALSV4_CPP",
+				"GASCompanion",
 				// ... add other public dependencies that you statically link with here ...
 			}
 		);
@@ -47,7 +48,6 @@ public class ModularGASCompanion : ModuleRules
 			new string[]
 			{
 				// ... add private dependencies that you statically link with here ...
-				"GASCompanion", 
 			}
 		);
 
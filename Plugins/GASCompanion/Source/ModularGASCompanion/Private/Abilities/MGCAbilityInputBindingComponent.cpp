@@ -6,6 +6,13 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "ModularGASCompanionLog.h"
+#include "ModularGASCompanionStats.h"
+#include "Abilities/MGCAbilitySystemComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Update Ability System Bindings"), STAT_MGC_UpdateAbilitySystemBindings, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Bindings Resyncs"), STAT_MGC_InputBindingsResyncs, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Bindings Resyncs Skipped"), STAT_MGC_InputBindingsResyncsSkipped, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Bindings Spec Lookups Skipped"), STAT_MGC_InputBindingsSpecLookupsSkipped, STATGROUP_ModularGASCompanion);
 
 namespace MGCAbilityInputBindingComponent_Impl
 {
@@ -16,6 +23,32 @@ namespace MGCAbilityInputBindingComponent_Impl
 	{
 		return ++IncrementingInputID;
 	}
+
+	/** Looks up the spec through the ASC spec index when available, instead of scanning all activatable abilities */
+	static FGameplayAbilitySpec* FindAbilitySpecFromHandle(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayAbilitySpecHandle Handle)
+	{
+		if (IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(AbilitySystemComponent))
+		{
+			return SpecIndex->FindIndexedAbilitySpecFromHandle(Handle);
+		}
+
+		return AbilitySystemComponent ? AbilitySystemComponent->FindAbilitySpecFromHandle(Handle) : nullptr;
+	}
+
+	/** Updates spec InputID and notifies the ASC so that its InputID index stays in sync */
+	static void SetAbilitySpecInputID(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAbilitySpec& AbilitySpec, const int32 InputID)
+	{
+		if (AbilitySpec.InputID == InputID)
+		{
+			return;
+		}
+
+		AbilitySpec.InputID = InputID;
+		if (UMGCAbilitySystemComponent* MGCAbilitySystemComponent = Cast<UMGCAbilitySystemComponent>(AbilitySystemComponent))
+		{
+			MGCAbilitySystemComponent->NotifyAbilitySpecInputIDChanged(AbilitySpec);
+		}
+	}
 }
 
 void UMGCAbilityInputBindingComponent::SetupPlayerControls_Implementation(UEnhancedInputComponent* PlayerInputComponent)
@@ -63,7 +96,7 @@ void UMGCAbilityInputBindingComponent::SetInputBinding(UInputAction* InputAction
 		FGameplayAbilitySpec* OldBoundAbility = FindAbilitySpec(AbilityInputBinding->BoundAbilitiesStack.Top());
 		if (OldBoundAbility && OldBoundAbility->InputID == AbilityInputBinding->InputID)
 		{
-			OldBoundAbility->InputID = InvalidInputID;
+			SetAbilitySpecInputID(AbilityComponent, *OldBoundAbility, InvalidInputID);
 		}
 	}
 	else
@@ -75,11 +108,14 @@ void UMGCAbilityInputBindingComponent::SetInputBinding(UInputAction* InputAction
 
 	if (BindingAbility)
 	{
-		BindingAbility->InputID = AbilityInputBinding->InputID;
+		SetAbilitySpecInputID(AbilityComponent, *BindingAbility, AbilityInputBinding->InputID);
 	}
 
 	AbilityInputBinding->BoundAbilitiesStack.Push(AbilityHandle);
 	TryBindAbilityInput(InputAction, *AbilityInputBinding);
+
+	// Spec might not be available yet (clients), make sure InputID is set on next input
+	MarkAbilitySystemBindingsDirty();
 }
 
 void UMGCAbilityInputBindingComponent::ClearInputBinding(const FGameplayAbilitySpecHandle AbilityHandle)
@@ -115,7 +151,7 @@ void UMGCAbilityInputBindingComponent::ClearInputBinding(const FGameplayAbilityS
 				FGameplayAbilitySpec* StackedAbility = FindAbilitySpec(AbilityInputBinding.BoundAbilitiesStack.Top());
 				if (StackedAbility && StackedAbility->InputID == 0)
 				{
-					StackedAbility->InputID = AbilityInputBinding.InputID;
+					SetAbilitySpecInputID(AbilityComponent, *StackedAbility, AbilityInputBinding.InputID);
 				}
 			}
 			else
@@ -126,7 +162,8 @@ void UMGCAbilityInputBindingComponent::ClearInputBinding(const FGameplayAbilityS
 			// DO NOT act on `AbilityInputBinding` after here (it could have been removed)
 
 
-			FoundAbility->InputID = InvalidInputID;
+			SetAbilitySpecInputID(AbilityComponent, *FoundAbility, InvalidInputID);
+			MarkAbilitySystemBindingsDirty();
 		}
 	}
 }
@@ -152,9 +189,12 @@ UInputAction* UMGCAbilityInputBindingComponent::GetBoundInputActionForAbility(co
 	}
 
 	// Ensure and update inputs ID for specs based on mapped abilities.
-	UpdateAbilitySystemBindings(AbilitySystemComponent);
+	UpdateAbilitySystemBindingsIfDirty(AbilitySystemComponent);
 
-	FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(Ability->GetClass());
+	IGSCAbilitySpecIndexInterface* SpecIndex = Cast<IGSCAbilitySpecIndexInterface>(AbilitySystemComponent);
+	FGameplayAbilitySpec* AbilitySpec = SpecIndex ?
+		SpecIndex->FindIndexedAbilitySpecFromClass(Ability->GetClass()) :
+		AbilitySystemComponent->FindAbilitySpecFromClass(Ability->GetClass());
 	if (!AbilitySpec)
 	{
 		MGC_LOG(Error, TEXT("GetBoundInputActionForAbility - AbilitySystemComponent could not return Ability Spec for %s."), *GetNameSafe(Ability->GetClass()))
@@ -199,16 +239,18 @@ void UMGCAbilityInputBindingComponent::ResetBindings()
 
 			for (const FGameplayAbilitySpecHandle AbilityHandle : InputBinding.Value.BoundAbilitiesStack)
 			{
-				FGameplayAbilitySpec* FoundAbility = AbilityComponent->FindAbilitySpecFromHandle(AbilityHandle);
+				FGameplayAbilitySpec* FoundAbility = MGCAbilityInputBindingComponent_Impl::FindAbilitySpecFromHandle(AbilityComponent, AbilityHandle);
 				if (FoundAbility && FoundAbility->InputID == ExpectedInputID)
 				{
-					FoundAbility->InputID = MGCAbilityInputBindingComponent_Impl::InvalidInputID;
+					MGCAbilityInputBindingComponent_Impl::SetAbilitySpecInputID(AbilityComponent, *FoundAbility, MGCAbilityInputBindingComponent_Impl::InvalidInputID);
 				}
 			}
 		}
 	}
 
+	UnbindAbilitySpecsChangedDelegate();
 	AbilityComponent = nullptr;
+	MarkAbilitySystemBindingsDirty();
 }
 
 void UMGCAbilityInputBindingComponent::RunAbilitySystemSetup()
@@ -216,6 +258,9 @@ void UMGCAbilityInputBindingComponent::RunAbilitySystemSetup()
 	AActor* MyOwner = GetOwner();
 	check(MyOwner);
 
+	// Stop listening to the previous ASC (if any) before it is replaced
+	UnbindAbilitySpecsChangedDelegate();
+
 	AbilityComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(MyOwner);
 	if (AbilityComponent)
 	{
@@ -226,13 +271,17 @@ void UMGCAbilityInputBindingComponent::RunAbilitySystemSetup()
 
 			for (const FGameplayAbilitySpecHandle AbilityHandle : InputBinding.Value.BoundAbilitiesStack)
 			{
-				FGameplayAbilitySpec* FoundAbility = AbilityComponent->FindAbilitySpecFromHandle(AbilityHandle);
+				FGameplayAbilitySpec* FoundAbility = MGCAbilityInputBindingComponent_Impl::FindAbilitySpecFromHandle(AbilityComponent, AbilityHandle);
 				if (FoundAbility != nullptr)
 				{
-					FoundAbility->InputID = NewInputID;
+					MGCAbilityInputBindingComponent_Impl::SetAbilitySpecInputID(AbilityComponent, *FoundAbility, NewInputID);
 				}
 			}
 		}
+
+		// Only specs available at this point got their InputID, keep the others for the next input
+		MarkAbilitySystemBindingsDirty();
+		BindAbilitySpecsChangedDelegate();
 	}
 }
 
@@ -244,6 +293,12 @@ void UMGCAbilityInputBindingComponent::UpdateAbilitySystemBindings(UAbilitySyste
 		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_MGC_UpdateAbilitySystemBindings);
+	INC_DWORD_STAT(STAT_MGC_InputBindingsResyncs);
+
+	// Specs changes from now on will flag bindings dirty again
+	bAbilitySystemBindingsDirty = !bListeningToAbilitySpecChanges || AbilitySystemComponent != AbilityComponent;
+
 	for (auto& InputBinding : MappedAbilities)
 	{
 		const int32 InputID = InputBinding.Value.InputID;
@@ -254,21 +309,66 @@ void UMGCAbilityInputBindingComponent::UpdateAbilitySystemBindings(UAbilitySyste
 
 		for (const FGameplayAbilitySpecHandle AbilityHandle : InputBinding.Value.BoundAbilitiesStack)
 		{
-			FGameplayAbilitySpec* FoundAbility = AbilitySystemComponent->FindAbilitySpecFromHandle(AbilityHandle);
+			FGameplayAbilitySpec* FoundAbility = MGCAbilityInputBindingComponent_Impl::FindAbilitySpecFromHandle(AbilitySystemComponent, AbilityHandle);
 			if (FoundAbility != nullptr)
 			{
-				FoundAbility->InputID = InputID;
+				MGCAbilityInputBindingComponent_Impl::SetAbilitySpecInputID(AbilitySystemComponent, *FoundAbility, InputID);
 			}
 		}
 	}
 }
 
+void UMGCAbilityInputBindingComponent::UpdateAbilitySystemBindingsIfDirty(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	if (!bAbilitySystemBindingsDirty && AbilitySystemComponent == AbilityComponent)
+	{
+		// Nothing changed since last update, every mapped ability spec would have been looked up for nothing
+		INC_DWORD_STAT(STAT_MGC_InputBindingsResyncsSkipped);
+#if STATS
+		for (const auto& InputBinding : MappedAbilities)
+		{
+			INC_DWORD_STAT_BY(STAT_MGC_InputBindingsSpecLookupsSkipped, InputBinding.Value.BoundAbilitiesStack.Num());
+		}
+#endif
+		return;
+	}
+
+	UpdateAbilitySystemBindings(AbilitySystemComponent);
+}
+
+void UMGCAbilityInputBindingComponent::MarkAbilitySystemBindingsDirty()
+{
+	bAbilitySystemBindingsDirty = true;
+}
+
+void UMGCAbilityInputBindingComponent::BindAbilitySpecsChangedDelegate()
+{
+	UMGCAbilitySystemComponent* MGCAbilitySystemComponent = Cast<UMGCAbilitySystemComponent>(AbilityComponent);
+	if (MGCAbilitySystemComponent && !AbilitySpecsChangedHandle.IsValid())
+	{
+		AbilitySpecsChangedHandle = MGCAbilitySystemComponent->OnAbilitySpecsChangedDelegate.AddUObject(this, &UMGCAbilityInputBindingComponent::MarkAbilitySystemBindingsDirty);
+		bListeningToAbilitySpecChanges = true;
+	}
+}
+
+void UMGCAbilityInputBindingComponent::UnbindAbilitySpecsChangedDelegate()
+{
+	UMGCAbilitySystemComponent* MGCAbilitySystemComponent = Cast<UMGCAbilitySystemComponent>(AbilityComponent);
+	if (MGCAbilitySystemComponent && AbilitySpecsChangedHandle.IsValid())
+	{
+		MGCAbilitySystemComponent->OnAbilitySpecsChangedDelegate.Remove(AbilitySpecsChangedHandle);
+	}
+
+	AbilitySpecsChangedHandle.Reset();
+	bListeningToAbilitySpecChanges = false;
+}
+
 void UMGCAbilityInputBindingComponent::OnAbilityInputPressed(UInputAction* InputAction)
 {
 	// The AbilitySystemComponent may not have been valid when we first bound input... try again.
 	if (AbilityComponent)
 	{
-		UpdateAbilitySystemBindings(AbilityComponent);
+		UpdateAbilitySystemBindingsIfDirty(AbilityComponent);
 	}
 	else
 	{
@@ -290,7 +390,10 @@ void UMGCAbilityInputBindingComponent::OnAbilityInputPressed(UInputAction* Input
 void UMGCAbilityInputBindingComponent::OnAbilityInputReleased(UInputAction* InputAction)
 {
 	// The AbilitySystemComponent may need to have specs inputID updated here for clients... try again.
-	UpdateAbilitySystemBindings(AbilityComponent);
+	if (AbilityComponent)
+	{
+		UpdateAbilitySystemBindingsIfDirty(AbilityComponent);
+	}
 
 	if (AbilityComponent)
 	{
@@ -321,22 +424,18 @@ void UMGCAbilityInputBindingComponent::RemoveEntry(UInputAction* InputAction)
 			FGameplayAbilitySpec* AbilitySpec = FindAbilitySpec(AbilityHandle);
 			if (AbilitySpec && AbilitySpec->InputID == Bindings->InputID)
 			{
-				AbilitySpec->InputID = InvalidInputID;
+				SetAbilitySpecInputID(AbilityComponent, *AbilitySpec, InvalidInputID);
 			}
 		}
 
 		MappedAbilities.Remove(InputAction);
+		MarkAbilitySystemBindingsDirty();
 	}
 }
 
 FGameplayAbilitySpec* UMGCAbilityInputBindingComponent::FindAbilitySpec(const FGameplayAbilitySpecHandle Handle) const
 {
-	FGameplayAbilitySpec* FoundAbility = nullptr;
-	if (AbilityComponent)
-	{
-		FoundAbility = AbilityComponent->FindAbilitySpecFromHandle(Handle);
-	}
-	return FoundAbility;
+	return MGCAbilityInputBindingComponent_Impl::FindAbilitySpecFromHandle(AbilityComponent, Handle);
 }
 
 void UMGCAbilityInputBindingComponent::TryBindAbilityInput(UInputAction* InputAction, FMGCAbilityInputBinding& AbilityInputBinding)
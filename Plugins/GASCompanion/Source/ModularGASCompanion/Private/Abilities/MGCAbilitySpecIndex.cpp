@@ -0,0 +1,159 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Abilities/MGCAbilitySpecIndex.h"
+
+#include "Abilities/GameplayAbility.h"
+
+void FMGCAbilitySpecIndex::AddSpec(const FGameplayAbilitySpec& Spec, const TArray<FGameplayAbilitySpec>& Specs)
+{
+	if (!Spec.Ability || !Spec.Handle.IsValid())
+	{
+		return;
+	}
+
+	const FGameplayAbilitySpecHandle Handle = Spec.Handle;
+
+	// Index under the ability class and all of its parents, so that "is child of" queries are a single lookup
+	for (const UClass* Class = Spec.Ability->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		AddHandle(ByClass, Class, Handle);
+		if (Class == UGameplayAbility::StaticClass())
+		{
+			break;
+		}
+	}
+
+	// Index under ability tags and their parents, to match FGameplayTagContainer::HasAll() semantic
+	for (const FGameplayTag& Tag : Spec.Ability->AbilityTags.GetGameplayTagParents())
+	{
+		AddHandle(ByTag, Tag, Handle);
+	}
+
+	AddHandle(ByInputID, Spec.InputID, Handle);
+	InputIDByHandle.Add(Handle, Spec.InputID);
+
+	// Spec is usually a reference to an element of the owning list, figure out its position from there
+	const int32 Position = Specs.Num() > 0 ? &Spec - Specs.GetData() : INDEX_NONE;
+	PositionByHandle.Add(Handle, Specs.IsValidIndex(Position) ? Position : INDEX_NONE);
+}
+
+void FMGCAbilitySpecIndex::RemoveSpec(const FGameplayAbilitySpec& Spec)
+{
+	const FGameplayAbilitySpecHandle Handle = Spec.Handle;
+
+	int32 IndexedInputID;
+	if (!InputIDByHandle.RemoveAndCopyValue(Handle, IndexedInputID))
+	{
+		return;
+	}
+
+	RemoveHandle(ByInputID, IndexedInputID, Handle);
+	PositionByHandle.Remove(Handle);
+
+	if (!Spec.Ability)
+	{
+		// Should not happen, but make sure we don't keep a dangling handle around if the ability went away
+		RemoveHandleFromAllKeys(ByClass, Handle);
+		RemoveHandleFromAllKeys(ByTag, Handle);
+		return;
+	}
+
+	for (const UClass* Class = Spec.Ability->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		RemoveHandle(ByClass, Class, Handle);
+		if (Class == UGameplayAbility::StaticClass())
+		{
+			break;
+		}
+	}
+
+	for (const FGameplayTag& Tag : Spec.Ability->AbilityTags.GetGameplayTagParents())
+	{
+		RemoveHandle(ByTag, Tag, Handle);
+	}
+}
+
+void FMGCAbilitySpecIndex::UpdateInputID(const FGameplayAbilitySpec& Spec)
+{
+	int32* IndexedInputID = InputIDByHandle.Find(Spec.Handle);
+	if (!IndexedInputID || *IndexedInputID == Spec.InputID)
+	{
+		return;
+	}
+
+	RemoveHandle(ByInputID, *IndexedInputID, Spec.Handle);
+	AddHandle(ByInputID, Spec.InputID, Spec.Handle);
+	*IndexedInputID = Spec.InputID;
+}
+
+void FMGCAbilitySpecIndex::SyncWith(const TArray<FGameplayAbilitySpec>& Specs)
+{
+	if (Specs.Num() != InputIDByHandle.Num())
+	{
+		// Replicated adds / removes are routed through OnGiveAbility / OnRemoveAbility, this is just a safety net
+		Rebuild(Specs);
+		return;
+	}
+
+	for (const FGameplayAbilitySpec& Spec : Specs)
+	{
+		UpdateInputID(Spec);
+	}
+
+	RefreshPositions(Specs);
+}
+
+void FMGCAbilitySpecIndex::Rebuild(const TArray<FGameplayAbilitySpec>& Specs)
+{
+	Reset();
+	for (const FGameplayAbilitySpec& Spec : Specs)
+	{
+		AddSpec(Spec, Specs);
+	}
+}
+
+void FMGCAbilitySpecIndex::Reset()
+{
+	ByClass.Reset();
+	ByTag.Reset();
+	ByInputID.Reset();
+	InputIDByHandle.Reset();
+	PositionByHandle.Reset();
+}
+
+FGameplayAbilitySpec* FMGCAbilitySpecIndex::Resolve(TArray<FGameplayAbilitySpec>& Specs, const FGameplayAbilitySpecHandle Handle)
+{
+	const int32* Position = PositionByHandle.Find(Handle);
+	if (!Position)
+	{
+		return nullptr;
+	}
+
+	if (Specs.IsValidIndex(*Position) && Specs[*Position].Handle == Handle)
+	{
+		return &Specs[*Position];
+	}
+
+	// Cached position is stale (list was reordered or reallocated since), refresh all of them at once
+	RefreshPositions(Specs);
+
+	Position = PositionByHandle.Find(Handle);
+	return Position && Specs.IsValidIndex(*Position) ? &Specs[*Position] : nullptr;
+}
+
+void FMGCAbilitySpecIndex::RefreshPositions(const TArray<FGameplayAbilitySpec>& Specs)
+{
+	for (TPair<FGameplayAbilitySpecHandle, int32>& Pair : PositionByHandle)
+	{
+		Pair.Value = INDEX_NONE;
+	}
+
+	for (int32 Position = 0; Position < Specs.Num(); ++Position)
+	{
+		if (int32* CachedPosition = PositionByHandle.Find(Specs[Position].Handle))
+		{
+			*CachedPosition = Position;
+		}
+	}
+}
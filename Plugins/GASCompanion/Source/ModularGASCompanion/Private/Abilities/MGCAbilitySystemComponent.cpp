@@ -38,6 +38,7 @@ void UMGCAbilitySystemComponent::BeginDestroy()
 	}
 
 	OnGiveAbilityDelegate.RemoveAll(this);
+	OnAbilitySpecsChangedDelegate.Clear();
 
 	// Remove any added attributes
 	for (UAttributeSet* AttribSetInstance : AddedAttributes)
@@ -132,63 +133,188 @@ void UMGCAbilitySystemComponent::AbilityLocalInputPressed(const int32 InputID)
 
 	// ---------------------------------------------------------
 
-	ABILITYLIST_SCOPE_LOCK();
-	for (FGameplayAbilitySpec& Spec : ActivatableAbilities.Items)
+	ForEachIndexedAbilitySpecByInputID(InputID, [this](FGameplayAbilitySpec& Spec)
 	{
-		if (Spec.InputID == InputID && Spec.Ability)
+		if (!Spec.Ability)
 		{
-			Spec.InputPressed = true;
+			return true;
+		}
 
-			if (Spec.Ability->IsA(UGSCGameplayAbility_MeleeBase::StaticClass()))
+		Spec.InputPressed = true;
+
+		if (Spec.Ability->IsA(UGSCGameplayAbility_MeleeBase::StaticClass()))
+		{
+			// Ability is a combo ability, try to activate via Combo Component
+			if (!IsValid(ComboComponent))
 			{
-				// Ability is a combo ability, try to activate via Combo Component
-				if (!IsValid(ComboComponent))
+				// Combo Component ref is not set yet, set it once
+				ComboComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(GetAvatarActor());
+				if (ComboComponent)
 				{
-					// Combo Component ref is not set yet, set it once
-					ComboComponent = UGSCBlueprintFunctionLibrary::GetComboManagerComponent(GetAvatarActor());
-					if (ComboComponent)
-					{
-						ComboComponent->SetupOwner();
-					}
+					ComboComponent->SetupOwner();
 				}
+			}
 
-				// Regardless of active or not active, always try to activate the combo. Combo Component will take care of gating activation or queuing next combo
-				if (IsValid(ComboComponent))
-				{
-					// We have a valid combo component, active combo
-					ComboComponent->ActivateComboAbility(Spec.Ability->GetClass());
-				}
-				else
+			// Regardless of active or not active, always try to activate the combo. Combo Component will take care of gating activation or queuing next combo
+			if (IsValid(ComboComponent))
+			{
+				// We have a valid combo component, active combo
+				ComboComponent->ActivateComboAbility(Spec.Ability->GetClass());
+			}
+			else
+			{
+				MGC_LOG(Error, TEXT("UMGCAbilitySystemComponent::AbilityLocalInputPressed - Trying to activate combo without a Combo Manager Component on the Avatar Actor. Make sure to add the component in Blueprint."))
+			}
+		}
+		else
+		{
+			// Ability is not a combo ability, go through normal workflow
+			if (Spec.IsActive())
+			{
+				if (Spec.Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
 				{
-					MGC_LOG(Error, TEXT("UMGCAbilitySystemComponent::AbilityLocalInputPressed - Trying to activate combo without a Combo Manager Component on the Avatar Actor. Make sure to add the component in Blueprint."))
+					ServerSetInputPressed(Spec.Handle);
 				}
 
+				AbilitySpecInputPressed(Spec);
 
+				// Invoke the InputPressed event. This is not replicated here. If someone is listening, they may replicate the InputPressed event to the server.
+				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec.Handle, Spec.ActivationInfo.GetActivationPredictionKey());
 			}
 			else
 			{
-				// Ability is not a combo ability, go through normal workflow
-				if (Spec.IsActive())
-				{
-					if (Spec.Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
-					{
-						ServerSetInputPressed(Spec.Handle);
-					}
+				TryActivateAbility(Spec.Handle);
+			}
+		}
 
-					AbilitySpecInputPressed(Spec);
+		return true;
+	});
+}
 
-					// Invoke the InputPressed event. This is not replicated here. If someone is listening, they may replicate the InputPressed event to the server.
-					InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec.Handle, Spec.ActivationInfo.GetActivationPredictionKey());
-				}
-				else
-				{
-					TryActivateAbility(Spec.Handle);
-				}
-			}
+FGameplayAbilitySpec* UMGCAbilitySystemComponent::FindIndexedAbilitySpecFromHandle(const FGameplayAbilitySpecHandle Handle)
+{
+	return AbilitySpecIndex.Resolve(ActivatableAbilities.Items, Handle);
+}
+
+FGameplayAbilitySpec* UMGCAbilitySystemComponent::FindIndexedAbilitySpecFromClass(const TSubclassOf<UGameplayAbility> AbilityClass)
+{
+	FGameplayAbilitySpec* FoundSpec = nullptr;
+	ForEachIndexedAbilitySpecByClass(AbilityClass, [&FoundSpec, AbilityClass](FGameplayAbilitySpec& Spec)
+	{
+		// Class index includes child classes, FindAbilitySpecFromClass is looking for an exact match
+		if (Spec.Ability->GetClass() == AbilityClass)
+		{
+			FoundSpec = &Spec;
+			return false;
+		}
+
+		return true;
+	});
+
+	return FoundSpec;
+}
+
+void UMGCAbilitySystemComponent::ForEachIndexedAbilitySpecByClass(const TSubclassOf<UGameplayAbility> AbilityClass, const TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor)
+{
+	const FMGCAbilitySpecIndex::FHandleList* FoundHandles = AbilitySpecIndex.FindByClass(AbilityClass);
+	if (!FoundHandles)
+	{
+		return;
+	}
+
+	ABILITYLIST_SCOPE_LOCK();
+
+	// Copy (inline storage) in case visitor ends up updating the index
+	const FMGCAbilitySpecIndex::FHandleList Handles = *FoundHandles;
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
+	{
+		FGameplayAbilitySpec* Spec = AbilitySpecIndex.Resolve(ActivatableAbilities.Items, Handle);
+		if (Spec && Spec->Ability && !Visitor(*Spec))
+		{
+			return;
 		}
 	}
 }
 
+void UMGCAbilitySystemComponent::ForEachIndexedAbilitySpecByTags(const FGameplayTagContainer& GameplayTagContainer, const TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor)
+{
+	// Like GetActivatableGameplayAbilitySpecsByAllMatchingTags(), an empty container matches nothing
+	if (GameplayTagContainer.IsEmpty())
+	{
+		return;
+	}
+
+	ABILITYLIST_SCOPE_LOCK();
+
+	// Narrow down candidates to the smallest list of specs having one of the searched tags
+	const FMGCAbilitySpecIndex::FHandleList* Candidates = nullptr;
+	for (const FGameplayTag& Tag : GameplayTagContainer)
+	{
+		const FMGCAbilitySpecIndex::FHandleList* FoundHandles = AbilitySpecIndex.FindByTag(Tag);
+		if (!FoundHandles)
+		{
+			// No ability has this tag, no ability can have them all
+			return;
+		}
+
+		if (!Candidates || FoundHandles->Num() < Candidates->Num())
+		{
+			Candidates = FoundHandles;
+		}
+	}
+
+	const FMGCAbilitySpecIndex::FHandleList Handles = *Candidates;
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
+	{
+		FGameplayAbilitySpec* Spec = AbilitySpecIndex.Resolve(ActivatableAbilities.Items, Handle);
+		if (Spec && Spec->Ability && Spec->Ability->AbilityTags.HasAll(GameplayTagContainer) && !Visitor(*Spec))
+		{
+			return;
+		}
+	}
+}
+
+void UMGCAbilitySystemComponent::ForEachIndexedAbilitySpecByInputID(const int32 InputID, const TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor)
+{
+	const FMGCAbilitySpecIndex::FHandleList* FoundHandles = AbilitySpecIndex.FindByInputID(InputID);
+	if (!FoundHandles)
+	{
+		return;
+	}
+
+	ABILITYLIST_SCOPE_LOCK();
+
+	const FMGCAbilitySpecIndex::FHandleList Handles = *FoundHandles;
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
+	{
+		FGameplayAbilitySpec* Spec = AbilitySpecIndex.Resolve(ActivatableAbilities.Items, Handle);
+
+		// Double check InputID in case it was changed without notifying the index
+		if (Spec && Spec->InputID == InputID && !Visitor(*Spec))
+		{
+			return;
+		}
+	}
+}
+
+void UMGCAbilitySystemComponent::GetIndexedAbilitySpecsByAllMatchingTags(const FGameplayTagContainer& GameplayTagContainer, TArray<FGameplayAbilitySpec*>& MatchingGameplayAbilities, const bool bOnlyAbilitiesThatSatisfyTagRequirements)
+{
+	ForEachIndexedAbilitySpecByTags(GameplayTagContainer, [this, &MatchingGameplayAbilities, bOnlyAbilitiesThatSatisfyTagRequirements](FGameplayAbilitySpec& Spec)
+	{
+		if (!bOnlyAbilitiesThatSatisfyTagRequirements || Spec.Ability->DoesAbilitySatisfyTagRequirements(*this))
+		{
+			MatchingGameplayAbilities.Add(&Spec);
+		}
+
+		return true;
+	});
+}
+
+void UMGCAbilitySystemComponent::NotifyAbilitySpecInputIDChanged(const FGameplayAbilitySpec& AbilitySpec)
+{
+	AbilitySpecIndex.UpdateInputID(AbilitySpec);
+}
+
 FGameplayAbilitySpecHandle UMGCAbilitySystemComponent::GrantAbility(const TSubclassOf<UGameplayAbility> Ability, const bool bRemoveAfterActivation)
 {
 	FGameplayAbilitySpecHandle AbilityHandle;
@@ -329,7 +455,7 @@ void UMGCAbilitySystemComponent::GrantDefaultAbilitiesAndAttributes(AActor* InOw
 			// Handle clients, we don't grant here but try to get the spec already granted or register delegate to handle input binding
 			if (InputComponent && InputAction && !IsOwnerActorAuthoritative())
 			{
-				FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromClass(Ability);
+				FGameplayAbilitySpec* AbilitySpec = FindIndexedAbilitySpecFromClass(Ability);
 				if (AbilitySpec)
 				{
 					InputComponent->SetInputBinding(InputAction, GrantedAbility.TriggerEvent, AbilitySpec->Handle);
@@ -363,9 +489,30 @@ void UMGCAbilitySystemComponent::GrantDefaultAbilitiesAndAttributes(AActor* InOw
 
 void UMGCAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
 {
+	// Index the spec first, so that delegates bound below can already look it up
+	AbilitySpecIndex.AddSpec(AbilitySpec, ActivatableAbilities.Items);
+
 	Super::OnGiveAbility(AbilitySpec);
 	MGC_LOG(Log, TEXT("UMGCAbilitySystemComponent::OnGiveAbility %s"), *AbilitySpec.Ability->GetName());
 	OnGiveAbilityDelegate.Broadcast(AbilitySpec);
+	OnAbilitySpecsChangedDelegate.Broadcast();
+}
+
+void UMGCAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	AbilitySpecIndex.RemoveSpec(AbilitySpec);
+
+	Super::OnRemoveAbility(AbilitySpec);
+	OnAbilitySpecsChangedDelegate.Broadcast();
+}
+
+void UMGCAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	// Pick up replicated InputID changes and positions of specs that moved in the list
+	AbilitySpecIndex.SyncWith(ActivatableAbilities.Items);
+
+	Super::OnRep_ActivateAbilities();
+	OnAbilitySpecsChangedDelegate.Broadcast();
 }
 
 void UMGCAbilitySystemComponent::GrantStartupEffects()
@@ -0,0 +1,726 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+
+#include "Commandlets/MGCStressTestCommandlet.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
+#include "GameplayTagsManager.h"
+#include "ModularGASCompanionLog.h"
+#include "Abilities/GSCGameplayAbility_MeleeBase.h"
+#include "Abilities/MGCAbilitySystemComponent.h"
+#include "Abilities/Attributes/GSCAttributeSet.h"
+#include "Actors/Projectiles/GSCProjectileBase.h"
+#include "Components/GSCComboManagerComponent.h"
+#include "Components/GSCCoreComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ModularGameplayActors/ModularCharacter.h"
+#include "Serialization/BitWriter.h"
+#include "Subsystems/GSCProjectilePoolSubsystem.h"
+
+/** Cooldown tags of the stress test abilities, only added when running the commandlet so that projects don't get them */
+struct FMGCStressTestTags : public FGameplayTagNativeAdder
+{
+	FGameplayTag CooldownTags[UMGCStressTestCooldownAbility::NumSlots];
+
+	virtual void AddTags() override
+	{
+		FString Commandlet;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("run="), Commandlet) || !Commandlet.StartsWith(TEXT("MGCStressTest")))
+		{
+			return;
+		}
+
+		UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+		for (int32 Slot = 0; Slot < UMGCStressTestCooldownAbility::NumSlots; ++Slot)
+		{
+			CooldownTags[Slot] = Manager.AddNativeGameplayTag(*FString::Printf(TEXT("MGC.StressTest.Cooldown.%d"), Slot + 1), TEXT("Modular GAS Companion stress test commandlet"));
+		}
+	}
+
+	static FMGCStressTestTags Tags;
+};
+
+FMGCStressTestTags FMGCStressTestTags::Tags;
+
+UMGCStressTestCooldownEffect::UMGCStressTestCooldownEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(1.f));
+}
+
+UMGCStressTestCooldownAbility::UMGCStressTestCooldownAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::NonInstanced;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+	CooldownGameplayEffectClass = UMGCStressTestCooldownEffect::StaticClass();
+}
+
+FGameplayTag UMGCStressTestCooldownAbility::GetCooldownTag(const int32 Level)
+{
+	return FMGCStressTestTags::Tags.CooldownTags[FMath::Clamp(Level - 1, 0, NumSlots - 1)];
+}
+
+bool UMGCStressTestCooldownAbility::CheckCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	// Same as the base implementation, with the cooldown tag of the ability level instead of the cooldown effect granted tags
+	const FGameplayTag CooldownTag = GetCooldownTag(GetAbilityLevel(Handle, ActorInfo));
+	UAbilitySystemComponent* const AbilitySystemComponent = ActorInfo->AbilitySystemComponent.Get();
+	if (AbilitySystemComponent && AbilitySystemComponent->HasMatchingGameplayTag(CooldownTag))
+	{
+		if (OptionalRelevantTags)
+		{
+			OptionalRelevantTags->AddTag(UAbilitySystemGlobals::Get().ActivateFailCooldownTag);
+			OptionalRelevantTags->AddTag(CooldownTag);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void UMGCStressTestCooldownAbility::ApplyCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const
+{
+	const UGameplayEffect* CooldownEffect = GetCooldownGameplayEffect();
+	if (!CooldownEffect)
+	{
+		return;
+	}
+
+	const int32 Level = GetAbilityLevel(Handle, ActorInfo);
+	const FGameplayEffectSpecHandle SpecHandle = MakeOutgoingGameplayEffectSpec(Handle, ActorInfo, ActivationInfo, CooldownEffect->GetClass(), Level);
+	if (SpecHandle.IsValid())
+	{
+		SpecHandle.Data->DynamicGrantedTags.AddTag(GetCooldownTag(Level));
+		SpecHandle.Data->SetDuration((float)Level, true);
+		ApplyGameplayEffectSpecToOwner(Handle, ActorInfo, ActivationInfo, SpecHandle);
+	}
+}
+
+void UMGCStressTestCooldownAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	const bool bCommitted = CommitAbility(Handle, ActorInfo, ActivationInfo);
+	EndAbility(Handle, ActorInfo, ActivationInfo, true, !bCommitted);
+}
+
+UMGCStressTestCommandlet::UMGCStressTestCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMGCStressTestCommandlet::Main(const FString& Params)
+{
+	TArray<EScenario> Scenarios;
+	FString CsvFile;
+	float MaxP99Ms = 0.f;
+	if (!ParseOptions(Params, Scenarios, CsvFile, MaxP99Ms))
+	{
+		return 1;
+	}
+
+	MGC_LOG(
+		Display,
+		TEXT("UMGCStressTestCommandlet::Main() %d agents of %s, %d ticks at %.0f Hz, %d abilities, %d attribute sets"),
+		NumAgents,
+		*GetNameSafe(CharacterClass),
+		NumTicks,
+		TickRate,
+		AbilityClasses.Num(),
+		AttributeSetClasses.Num()
+	)
+
+	if (Scenarios.Contains(EScenario::Cooldown) && !UMGCStressTestCooldownAbility::GetCooldownTag(1).IsValid())
+	{
+		MGC_LOG(Error, TEXT("UMGCStressTestCommandlet::Main() Cooldown tags were not registered, run the commandlet as -run=MGCStressTest"))
+		return 1;
+	}
+
+	TArray<TPair<EScenario, FScenarioResult>> Results;
+	for (const EScenario Scenario : Scenarios)
+	{
+		MGC_LOG(Display, TEXT("UMGCStressTestCommandlet::Main() Running %s scenario"), GetScenarioName(Scenario))
+		Results.Emplace(Scenario, RunScenario(Scenario));
+	}
+
+	if (!WriteCsv(CsvFile, Results, NumAgents, NumTicks))
+	{
+		MGC_LOG(Error, TEXT("UMGCStressTestCommandlet::Main() Failed to write %s"), *CsvFile)
+		return 1;
+	}
+
+	MGC_LOG(Display, TEXT("UMGCStressTestCommandlet::Main() Results written to %s"), *CsvFile)
+
+	int32 ReturnCode = 0;
+	for (TPair<EScenario, FScenarioResult>& Result : Results)
+	{
+		const double FrameP99Ms = GetPercentile(Result.Value.SamplesMs[(int32)ESystem::Frame], 0.99f);
+		MGC_LOG(Display, TEXT("\t%s - Frame p99: %.3f ms, Replicated (estimate): %lld bytes"), GetScenarioName(Result.Key), FrameP99Ms, Result.Value.ReplicatedBytesEstimate)
+
+		if (MaxP99Ms > 0.f && FrameP99Ms > MaxP99Ms)
+		{
+			MGC_LOG(Error, TEXT("UMGCStressTestCommandlet::Main() %s frame p99 (%.3f ms) is above MaxP99Ms (%.3f ms)"), GetScenarioName(Result.Key), FrameP99Ms, MaxP99Ms)
+			ReturnCode = 1;
+		}
+	}
+
+	return ReturnCode;
+}
+
+bool UMGCStressTestCommandlet::ParseOptions(const FString& Params, TArray<EScenario>& OutScenarios, FString& OutCsvFile, float& OutMaxP99Ms)
+{
+	FParse::Value(*Params, TEXT("Agents="), NumAgents);
+	FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("MaxP99Ms="), OutMaxP99Ms);
+	NumAgents = FMath::Max(NumAgents, 2);
+	NumTicks = FMath::Max(NumTicks, 1);
+	TickRate = FMath::Max(TickRate, 1.f);
+
+	if (!FParse::Value(*Params, TEXT("Csv="), OutCsvFile))
+	{
+		OutCsvFile = FPaths::ProfilingDir() / TEXT("MGCStressTest.csv");
+	}
+
+	// Lists are "+" separated, commas are eaten by the command line parser
+	auto ParseList = [&Params](const TCHAR* Option, const TCHAR* Default)
+	{
+		FString Value = Default;
+		FParse::Value(*Params, Option, Value, false);
+
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT("+"));
+		return Items;
+	};
+
+	OutScenarios.Reset();
+	for (const FString& Name : ParseList(TEXT("Scenarios="), TEXT("Melee+Projectile+DoT+Cooldown")))
+	{
+		bool bFound = false;
+		for (int32 Index = 0; Index < (int32)EScenario::MAX; ++Index)
+		{
+			if (Name.Equals(GetScenarioName((EScenario)Index), ESearchCase::IgnoreCase))
+			{
+				OutScenarios.AddUnique((EScenario)Index);
+				bFound = true;
+			}
+		}
+
+		if (!bFound)
+		{
+			MGC_LOG(Error, TEXT("UMGCStressTestCommandlet::ParseOptions() Unknown scenario %s"), *Name)
+			return false;
+		}
+	}
+
+	bool bSuccess = true;
+	auto LoadClassOption = [&bSuccess](const FString& Path, UClass* BaseClass)
+	{
+		UClass* Class = StaticLoadClass(BaseClass, nullptr, *Path);
+		if (!Class)
+		{
+			MGC_LOG(Error, TEXT("UMGCStressTestCommandlet::ParseOptions() Unable to load %s class %s"), *BaseClass->GetName(), *Path)
+			bSuccess = false;
+		}
+		return Class;
+	};
+
+	FString CharacterPath;
+	CharacterClass = FParse::Value(*Params, TEXT("Character="), CharacterPath) ? LoadClassOption(CharacterPath, AModularCharacter::StaticClass()) : AModularCharacter::StaticClass();
+
+	FString ProjectilePath;
+	ProjectileClass = FParse::Value(*Params, TEXT("Projectile="), ProjectilePath) ? LoadClassOption(ProjectilePath, AGSCProjectileBase::StaticClass()) : AGSCProjectileBase::StaticClass();
+
+	AbilityClasses.Reset();
+	for (const FString& Path : ParseList(TEXT("Abilities="), TEXT("")))
+	{
+		AbilityClasses.Add(LoadClassOption(Path, UGameplayAbility::StaticClass()));
+	}
+
+	FString ComboAbilityPath;
+	ComboAbilityClass = FParse::Value(*Params, TEXT("ComboAbility="), ComboAbilityPath) ? LoadClassOption(ComboAbilityPath, UGSCGameplayAbility::StaticClass()) : UGSCGameplayAbility_MeleeBase::StaticClass();
+
+	AttributeSetClasses.Reset();
+	for (const FString& Path : ParseList(TEXT("AttributeSets="), *UGSCAttributeSet::StaticClass()->GetPathName()))
+	{
+		AttributeSetClasses.Add(LoadClassOption(Path, UAttributeSet::StaticClass()));
+	}
+
+	return bSuccess;
+}
+
+UMGCStressTestCommandlet::FScenarioResult UMGCStressTestCommandlet::RunScenario(const EScenario Scenario)
+{
+	FScenarioResult Result;
+	for (TArray<double>& Samples : Result.SamplesMs)
+	{
+		Samples.Reserve(NumTicks);
+	}
+
+	// Empty standalone game world, with the project game mode
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone(TEXT("MGCStressTest"));
+
+	UWorld* World = GameInstance->GetWorld();
+	World->SetGameMode(FURL());
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Effects used by the scenarios, rooted since nothing references them before they get applied
+	TArray<UGameplayEffect*> Effects;
+	auto MakeEffect = [&Effects](const EGameplayEffectDurationType DurationPolicy, const float Duration, const float Period, const float HealthMagnitude, const EGameplayModOp::Type ModifierOp = EGameplayModOp::Additive)
+	{
+		UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), NAME_None, RF_Transient);
+		Effect->AddToRoot();
+		Effects.Add(Effect);
+		Effect->DurationPolicy = DurationPolicy;
+		Effect->DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Duration));
+		Effect->Period = FScalableFloat(Period);
+
+		if (HealthMagnitude != 0.f)
+		{
+			FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+			Modifier.Attribute = UGSCAttributeSet::GetHealthAttribute();
+			Modifier.ModifierOp = ModifierOp;
+			Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(HealthMagnitude));
+		}
+
+		return Effect;
+	};
+
+	UGameplayEffect* HealEffect = MakeEffect(EGameplayEffectDurationType::Instant, 0.f, 0.f, 1000.f, EGameplayModOp::Override);
+	for (const FGameplayAttribute& Attribute : { UGSCAttributeSet::GetMaxHealthAttribute(), UGSCAttributeSet::GetStaminaAttribute(), UGSCAttributeSet::GetMaxStaminaAttribute() })
+	{
+		FGameplayModifierInfo& Modifier = HealEffect->Modifiers.AddDefaulted_GetRef();
+		Modifier.Attribute = Attribute;
+		Modifier.ModifierOp = EGameplayModOp::Override;
+		Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(1000.f));
+	}
+
+	UGameplayEffect* HitEffect = MakeEffect(EGameplayEffectDurationType::Instant, 0.f, 0.f, -5.f);
+	UGameplayEffect* DoTEffect = MakeEffect(EGameplayEffectDurationType::HasDuration, 4.f, 0.5f, -1.f);
+
+	// Agents, on a grid and flying so that they don't fall out of the (empty) world
+	TArray<AModularCharacter*> Agents;
+	TArray<UAbilitySystemComponent*> AbilitySystems;
+	TArray<UGSCComboManagerComponent*> ComboManagers;
+	TArray<FGameplayAbilitySpecHandle> CooldownAbilities;
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumAgents));
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		const FTransform Transform(FVector((Index % GridSize) * 200.f, (Index / GridSize) * 200.f, 1000.f));
+		AModularCharacter* Agent = World->SpawnActorDeferred<AModularCharacter>(CharacterClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Agent || !Agent->AbilitySystemComponent)
+		{
+			continue;
+		}
+
+		for (const TSubclassOf<UGameplayAbility>& AbilityClass : AbilityClasses)
+		{
+			Agent->AbilitySystemComponent->GrantedAbilities.AddDefaulted_GetRef().Ability = AbilityClass;
+		}
+
+		for (const TSubclassOf<UAttributeSet>& AttributeSetClass : AttributeSetClasses)
+		{
+			Agent->AbilitySystemComponent->GrantedAttributes.AddDefaulted_GetRef().AttributeSet = AttributeSetClass;
+		}
+
+		// Combo manager and the core component it goes through to activate abilities, unless the agent class has them already
+		UGSCComboManagerComponent* ComboManager = nullptr;
+		if (Scenario == EScenario::Melee)
+		{
+			Agent->AbilitySystemComponent->GrantedAbilities.AddDefaulted_GetRef().Ability = ComboAbilityClass;
+
+			if (!Agent->FindComponentByClass<UGSCCoreComponent>())
+			{
+				NewObject<UGSCCoreComponent>(Agent)->RegisterComponent();
+			}
+
+			ComboManager = Agent->FindComponentByClass<UGSCComboManagerComponent>();
+			if (!ComboManager)
+			{
+				ComboManager = NewObject<UGSCComboManagerComponent>(Agent);
+				ComboManager->RegisterComponent();
+			}
+			ComboManager->MeleeBaseAbility = ComboAbilityClass;
+		}
+
+		Agent->FinishSpawning(Transform);
+		Agent->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+
+		if (Scenario == EScenario::Cooldown)
+		{
+			for (int32 Slot = 0; Slot < UMGCStressTestCooldownAbility::NumSlots; ++Slot)
+			{
+				CooldownAbilities.Add(Agent->AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(UMGCStressTestCooldownAbility::StaticClass(), Slot + 1)));
+			}
+		}
+
+		Agent->AbilitySystemComponent->ApplyGameplayEffectToSelf(HealEffect, 1.f, Agent->AbilitySystemComponent->MakeEffectContext());
+		Agents.Add(Agent);
+		AbilitySystems.Add(Agent->AbilitySystemComponent);
+		ComboManagers.Add(ComboManager);
+	}
+
+	// Replicated attribute values of every agent, to estimate what would be sent over the wire on each tick
+	struct FReplicatedAttribute
+	{
+		const FGameplayAttributeData* Data;
+		float BaseValue;
+		float CurrentValue;
+	};
+
+	TArray<FReplicatedAttribute> ReplicatedAttributes;
+	for (const UAbilitySystemComponent* ASC : AbilitySystems)
+	{
+		for (const UAttributeSet* AttributeSet : ASC->GetSpawnedAttributes())
+		{
+			for (TFieldIterator<FProperty> It(AttributeSet->GetClass()); It; ++It)
+			{
+				if (It->HasAnyPropertyFlags(CPF_Net) && FGameplayAttribute::IsGameplayAttributeDataProperty(*It))
+				{
+					const FGameplayAttributeData* Data = It->ContainerPtrToValuePtr<FGameplayAttributeData>(AttributeSet);
+					ReplicatedAttributes.Add({ Data, Data->GetBaseValue(), Data->GetCurrentValue() });
+				}
+			}
+		}
+	}
+
+	TArray<FActiveGameplayEffectHandle> DoTHandles;
+	DoTHandles.SetNum(Agents.Num());
+	TArray<FGSCComboState> ReplicatedComboStates;
+	ReplicatedComboStates.SetNum(Agents.Num());
+	TArray<TPair<int32, AGSCProjectileBase*>> ProjectilesInFlight;
+	UGSCProjectilePoolSubsystem* ProjectilePool = UGSCProjectilePoolSubsystem::Get(World);
+	const bool bPooledProjectiles = ProjectilePool && ProjectileClass->GetDefaultObject<AGSCProjectileBase>()->bPooled;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const uint64 StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	const int32 StartUObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	uint64 SystemCycles[(int32)ESystem::MAX];
+	auto Measure = [&SystemCycles](const ESystem System, TFunctionRef<void()> Function)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Function();
+		SystemCycles[(int32)System] += FPlatformTime::Cycles64() - StartCycles;
+	};
+
+	auto ApplyHit = [&AbilitySystems, HitEffect](const int32 Source, const int32 Target)
+	{
+		UAbilitySystemComponent* SourceASC = AbilitySystems[Source];
+		SourceASC->ApplyGameplayEffectToTarget(HitEffect, AbilitySystems[Target], 1.f, SourceASC->MakeEffectContext());
+	};
+
+	const float DeltaSeconds = 1.f / TickRate;
+	const int32 NumValidAgents = Agents.Num();
+	for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+	{
+		FMemory::Memzero(SystemCycles);
+		const uint64 FrameStartCycles = FPlatformTime::Cycles64();
+
+		for (int32 Agent = 0; Agent < NumValidAgents; ++Agent)
+		{
+			const int32 Target = (Agent + 1) % NumValidAgents;
+
+			switch (Scenario)
+			{
+			case EScenario::Melee:
+				// One combo hit every 10 ticks, staggered between agents, three hits per combo. Each hit is an input, then the
+				// combo window and trigger combo notifies its montage would fire, with another input within the window to chain
+				// into the next hit. The combo ability increments the combo index itself when chained.
+				if (UGSCComboManagerComponent* ComboManager = ComboManagers[Agent])
+				{
+					const int32 Step = (Tick + Agent) % 10;
+					const bool bEndCombo = ((Tick + Agent) / 10) % 3 == 2;
+					Measure(ESystem::Abilities, [&]()
+					{
+						switch (Step)
+						{
+						case 0: ComboManager->ActivateComboAbility(ComboAbilityClass); break;
+						case 3: ComboManager->OpenComboWindow(bEndCombo); break;
+						case 4: ComboManager->ActivateComboAbility(ComboAbilityClass); break;
+						case 5: ComboManager->RequestTriggerCombo(); break;
+						case 7: ComboManager->CloseComboWindow(bEndCombo); break;
+						default: break;
+						}
+					});
+
+					if (Step == 0 || Step == 5)
+					{
+						Measure(ESystem::Effects, [&]() { ApplyHit(Agent, Target); });
+					}
+				}
+				break;
+
+			case EScenario::Projectile:
+				// Volley of three projectiles every 15 ticks, each hitting the target when released 20 ticks later
+				if ((Tick + Agent) % 15 == 0)
+				{
+					Measure(ESystem::Projectiles, [&]()
+					{
+						for (int32 Shot = 0; Shot < 3; ++Shot)
+						{
+							const FTransform SpawnTransform(Agents[Agent]->GetActorLocation() + FVector(0.f, 0.f, 200.f + Shot * 50.f));
+							if (bPooledProjectiles)
+							{
+								AGSCProjectileBase* Projectile = ProjectilePool->AcquireProjectile(ProjectileClass, SpawnTransform, Agents[Agent], Agents[Agent], ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+								if (Projectile)
+								{
+									ProjectilePool->FinishProjectile(Projectile, SpawnTransform);
+									ProjectilesInFlight.Emplace(Tick + 20, Projectile);
+								}
+							}
+							else if (AGSCProjectileBase* Projectile = World->SpawnActorDeferred<AGSCProjectileBase>(ProjectileClass, SpawnTransform, Agents[Agent], Agents[Agent], ESpawnActorCollisionHandlingMethod::AlwaysSpawn))
+							{
+								Projectile->FinishSpawning(SpawnTransform);
+								ProjectilesInFlight.Emplace(Tick + 20, Projectile);
+							}
+						}
+					});
+				}
+				break;
+
+			case EScenario::DoT:
+				Measure(ESystem::Effects, [&]()
+				{
+					if (!AbilitySystems[Target]->GetActiveGameplayEffect(DoTHandles[Target]))
+					{
+						UAbilitySystemComponent* SourceASC = AbilitySystems[Agent];
+						DoTHandles[Target] = SourceASC->ApplyGameplayEffectToTarget(DoTEffect, AbilitySystems[Target], 1.f, SourceASC->MakeEffectContext());
+					}
+				});
+				break;
+
+			case EScenario::Cooldown:
+				// Rotation of three abilities, each one tried every tick: CanActivateAbility checks its cooldown tag, and
+				// CommitAbility applies its cooldown effect once activated
+				for (int32 Slot = 0; Slot < UMGCStressTestCooldownAbility::NumSlots; ++Slot)
+				{
+					bool bActivated = false;
+					Measure(ESystem::Abilities, [&]()
+					{
+						bActivated = AbilitySystems[Agent]->TryActivateAbility(CooldownAbilities[Agent * UMGCStressTestCooldownAbility::NumSlots + Slot]);
+					});
+
+					if (bActivated)
+					{
+						Measure(ESystem::Effects, [&]() { ApplyHit(Agent, Target); });
+					}
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		// Projectiles impacts
+		TArray<int32, TInlineAllocator<64>> ImpactSources;
+		Measure(ESystem::Projectiles, [&]()
+		{
+			for (int32 Index = ProjectilesInFlight.Num() - 1; Index >= 0; --Index)
+			{
+				if (ProjectilesInFlight[Index].Key <= Tick)
+				{
+					AGSCProjectileBase* Projectile = ProjectilesInFlight[Index].Value;
+					if (IsValid(Projectile))
+					{
+						ImpactSources.Add(Agents.IndexOfByKey(Projectile->GetOwner()));
+						Projectile->ReleaseProjectile();
+					}
+					ProjectilesInFlight.RemoveAtSwap(Index, 1, false);
+				}
+			}
+		});
+
+		Measure(ESystem::Effects, [&]()
+		{
+			for (const int32 Source : ImpactSources)
+			{
+				if (Source != INDEX_NONE)
+				{
+					ApplyHit(Source, (Source + 1) % NumValidAgents);
+				}
+			}
+		});
+
+		// Keep agents alive, damage would otherwise stop at 0 health
+		Measure(ESystem::Effects, [&]()
+		{
+			for (UAbilitySystemComponent* ASC : AbilitySystems)
+			{
+				if (ASC->HasAttributeSetForAttribute(UGSCAttributeSet::GetHealthAttribute()) && ASC->GetNumericAttribute(UGSCAttributeSet::GetHealthAttribute()) < 250.f)
+				{
+					ASC->ApplyGameplayEffectToSelf(HealEffect, 1.f, ASC->MakeEffectContext());
+				}
+			}
+		});
+
+		// World tick, periodic effects, effects expiration, ability tasks, movement and animation
+		Measure(ESystem::World, [&]()
+		{
+			FApp::SetDeltaTime(DeltaSeconds);
+			FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaSeconds);
+			World->Tick(LEVELTICK_All, DeltaSeconds);
+			GFrameCounter++;
+		});
+
+		// Estimated attribute replication, property handle and value for every changed replicated attribute value
+		Measure(ESystem::Replication, [&]()
+		{
+			FBitWriter Writer(0, true);
+			for (FReplicatedAttribute& Attribute : ReplicatedAttributes)
+			{
+				uint32 PropertyHandle = 1;
+				if (Attribute.BaseValue != Attribute.Data->GetBaseValue())
+				{
+					Attribute.BaseValue = Attribute.Data->GetBaseValue();
+					Writer.SerializeIntPacked(PropertyHandle);
+					Writer << Attribute.BaseValue;
+				}
+
+				if (Attribute.CurrentValue != Attribute.Data->GetCurrentValue())
+				{
+					Attribute.CurrentValue = Attribute.Data->GetCurrentValue();
+					Writer.SerializeIntPacked(PropertyHandle);
+					Writer << Attribute.CurrentValue;
+				}
+			}
+
+			// Combo state, sent whenever it differs from the last one replicated
+			for (int32 Agent = 0; Agent < NumValidAgents; ++Agent)
+			{
+				if (ComboManagers[Agent])
+				{
+					FGSCComboState ComboState = ComboManagers[Agent]->GetComboState();
+					if (ComboState != ReplicatedComboStates[Agent])
+					{
+						bool bSuccess = true;
+						ComboState.NetSerialize(Writer, nullptr, bSuccess);
+						ReplicatedComboStates[Agent] = ComboState;
+					}
+				}
+			}
+			Result.ReplicatedBytesEstimate += Writer.GetNumBytes();
+		});
+
+		SystemCycles[(int32)ESystem::Frame] = FPlatformTime::Cycles64() - FrameStartCycles;
+		for (int32 System = 0; System < (int32)ESystem::MAX; ++System)
+		{
+			Result.SamplesMs[System].Add(FPlatformTime::ToMilliseconds64(SystemCycles[System]));
+		}
+	}
+
+	Result.UsedPhysicalDeltaMB = ((double)FPlatformMemory::GetStats().UsedPhysical - (double)StartUsedPhysical) / (1024. * 1024.);
+	Result.UObjectCountDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartUObjects;
+
+	// Tear down the world and everything spawned in it
+	World->DestroyWorld(true);
+	GEngine->DestroyWorldContext(World);
+	GameInstance->Shutdown();
+	GameInstance->RemoveFromRoot();
+	for (UGameplayEffect* Effect : Effects)
+	{
+		Effect->RemoveFromRoot();
+	}
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	for (TArray<double>& Samples : Result.SamplesMs)
+	{
+		Samples.Sort();
+	}
+
+	return Result;
+}
+
+bool UMGCStressTestCommandlet::WriteCsv(const FString& CsvFile, const TArray<TPair<EScenario, FScenarioResult>>& Results, const int32 InNumAgents, const int32 InNumTicks)
+{
+	FString Csv = TEXT("Scenario,System,Agents,Ticks,AvgMs,P50Ms,P90Ms,P99Ms,MaxMs,UsedPhysicalDeltaMB,UObjectCountDelta,ReplicatedBytesEstimate\n");
+	for (const TPair<EScenario, FScenarioResult>& Result : Results)
+	{
+		for (int32 System = 0; System < (int32)ESystem::MAX; ++System)
+		{
+			const TArray<double>& Samples = Result.Value.SamplesMs[System];
+
+			double TotalMs = 0.;
+			for (const double Sample : Samples)
+			{
+				TotalMs += Sample;
+			}
+
+			// Memory and UObject count deltas are for the whole scenario, replicated bytes estimate only for the replication system
+			const bool bFrame = System == (int32)ESystem::Frame;
+			const bool bReplication = System == (int32)ESystem::Replication;
+			Csv += FString::Printf(
+				TEXT("%s,%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,%d,%lld\n"),
+				GetScenarioName(Result.Key),
+				GetSystemName((ESystem)System),
+				InNumAgents,
+				InNumTicks,
+				Samples.Num() > 0 ? TotalMs / Samples.Num() : 0.,
+				GetPercentile(Samples, 0.5f),
+				GetPercentile(Samples, 0.9f),
+				GetPercentile(Samples, 0.99f),
+				Samples.Num() > 0 ? Samples.Last() : 0.,
+				bFrame ? Result.Value.UsedPhysicalDeltaMB : 0.,
+				bFrame ? Result.Value.UObjectCountDelta : 0,
+				bReplication ? Result.Value.ReplicatedBytesEstimate : 0ll
+			);
+		}
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(CsvFile), true);
+	return FFileHelper::SaveStringToFile(Csv, *CsvFile);
+}
+
+double UMGCStressTestCommandlet::GetPercentile(const TArray<double>& SortedSamples, const float Percentile)
+{
+	if (SortedSamples.Num() == 0)
+	{
+		return 0.;
+	}
+
+	const int32 Index = FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1;
+	return SortedSamples[FMath::Clamp(Index, 0, SortedSamples.Num() - 1)];
+}
+
+const TCHAR* UMGCStressTestCommandlet::GetScenarioName(const EScenario Scenario)
+{
+	switch (Scenario)
+	{
+	case EScenario::Melee: return TEXT("Melee");
+	case EScenario::Projectile: return TEXT("Projectile");
+	case EScenario::DoT: return TEXT("DoT");
+	case EScenario::Cooldown: return TEXT("Cooldown");
+	default: return TEXT("Unknown");
+	}
+}
+
+const TCHAR* UMGCStressTestCommandlet::GetSystemName(const ESystem System)
+{
+	switch (System)
+	{
+	case ESystem::Abilities: return TEXT("Abilities");
+	case ESystem::Effects: return TEXT("Effects");
+	case ESystem::Projectiles: return TEXT("Projectiles");
+	case ESystem::World: return TEXT("World");
+	case ESystem::Replication: return TEXT("Replication");
+	case ESystem::Frame: return TEXT("Frame");
+	default: return TEXT("Unknown");
+	}
+}
@@ -7,20 +7,68 @@
 #include "EngineUtils.h"
 #include "GameFeaturesSubsystemSettings.h"
 #include "ModularGASCompanionLog.h"
+#include "ModularGASCompanionStats.h"
 #include "Abilities/MGCAbilityInputBindingComponent.h"
 #include "Abilities/MGCAbilitySystemComponent.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "Components/GSCCoreComponent.h"
+#include "Containers/Ticker.h"
 #include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h" // for FWorldDelegates::OnStartGameInstance
 #include "Engine/Engine.h" // for FWorldContext
+#include "HAL/IConsoleManager.h"
 #include "ModularGameplayActors/MGCGameFrameworkExtensionManager.h"
 
 #define LOCTEXT_NAMESPACE "ModularGASCompanion"
 
+DECLARE_CYCLE_STAT(TEXT("Add Actor Abilities"), STAT_MGC_AddActorAbilities, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Add Abilities Synchronous Loads"), STAT_MGC_AddAbilitiesSynchronousLoads, STATGROUP_ModularGASCompanion);
+DECLARE_CYCLE_STAT(TEXT("Remove Actor Abilities"), STAT_MGC_RemoveActorAbilities, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Abilities Removals"), STAT_MGC_PendingAbilitiesRemovals, STATGROUP_ModularGASCompanion);
+DECLARE_CYCLE_STAT(TEXT("Init Attribute Set"), STAT_MGC_InitAttributeSet, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Sets Created"), STAT_MGC_AttributeSetsCreated, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Sets Reused"), STAT_MGC_AttributeSetsReused, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Recycled Attribute Sets"), STAT_MGC_RecycledAttributeSets, STATGROUP_ModularGASCompanion);
+
+static bool GMGCCacheAttributeDefaults = true;
+static FAutoConsoleVariableRef CVarMGCCacheAttributeDefaults(
+	TEXT("MGC.CacheAttributeDefaults"),
+	GMGCCacheAttributeDefaults,
+	TEXT("If true, Game Feature granted attribute sets are initialized from default values read once per attribute set class and DataTable, instead of reading DataTable rows for every instance")
+);
+
+static int32 GMGCRecycleAttributeSetsOverride = -1;
+static FAutoConsoleVariableRef CVarMGCRecycleAttributeSetsOverride(
+	TEXT("MGC.RecycleAttributeSetsOverride"),
+	GMGCRecycleAttributeSetsOverride,
+	TEXT("Overrides Recycle Attribute Sets of every Add Abilities action. -1 uses each action setting, 0 disables recycling, 1 enables it")
+);
+
+static float GMGCAbilitiesRemovalBudgetMs = 2.f;
+static FAutoConsoleVariableRef CVarMGCAbilitiesRemovalBudgetMs(
+	TEXT("MGC.AbilitiesRemovalBudgetMs"),
+	GMGCAbilitiesRemovalBudgetMs,
+	TEXT("Time per frame (in ms) spent removing Game Feature granted abilities and attributes once a feature deactivates, remaining actors are handled on the next frames. 0 removes everything in the deactivation frame")
+);
+
+/** Returns the asset if it is already loaded (usually by the batched load on activation), or loads it synchronously */
+template<typename SoftPtrType>
+static auto GetOrLoadSynchronous(const SoftPtrType& SoftPtr) -> decltype(SoftPtr.Get())
+{
+	if (auto* LoadedAsset = SoftPtr.Get())
+	{
+		return LoadedAsset;
+	}
+
+	INC_DWORD_STAT(STAT_MGC_AddAbilitiesSynchronousLoads);
+	return SoftPtr.LoadSynchronous();
+}
+
 void UMGCGameFeatureAction_AddAbilities::OnGameFeatureActivating()
 {
-	if (!ensureAlways(ActiveExtensions.Num() == 0) || !ensureAlways(ComponentRequests.Num() == 0) || !ensureAlways(ExtensionsRequests.Num() == 0))
+	if (!ensureAlways(ActiveExtensions.Num() == 0) || !ensureAlways(ComponentRequests.Num() == 0) || !ensureAlways(ExtensionsRequests.Num() == 0) || !ensureAlways(ExtensionHandlerRequests.Num() == 0))
 	{
 		Reset();
 	}
@@ -29,6 +77,25 @@ void UMGCGameFeatureAction_AddAbilities::OnGameFeatureActivating()
 
 	check(ComponentRequests.Num() == 0);
 	check(ExtensionsRequests.Num() == 0);
+	check(ExtensionHandlerRequests.Num() == 0);
+
+	// Request every asset as a single batch, actors receiving the extension until it completes are queued
+	TArray<FSoftObjectPath> AssetsToLoad;
+	GetAssetsToLoad(AssetsToLoad);
+	if (AssetsToLoad.Num() > 0 && UAssetManager::IsValid())
+	{
+		AssetsLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			AssetsToLoad,
+			FStreamableDelegate::CreateUObject(this, &UMGCGameFeatureAction_AddAbilities::HandleAssetsLoaded),
+			FStreamableManager::AsyncLoadHighPriority
+		);
+	}
+
+	// Nothing to wait for (or no asset manager, assets are then loaded synchronously when granting)
+	if (!AssetsLoadHandle.IsValid() || AssetsLoadHandle->HasLoadCompleted())
+	{
+		bAssetsLoaded = true;
+	}
 
 	// Add to any worlds with associated game instances that have already been initialized
 	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
@@ -45,6 +112,27 @@ void UMGCGameFeatureAction_AddAbilities::OnGameFeatureDeactivating(FGameFeatureD
 
 	FWorldDelegates::OnStartGameInstance.Remove(GameInstanceStartHandle);
 
+	// Removal of what was granted goes through pending removals, no longer tracked by extension events
+	PendingRemovals.Reserve(PendingRemovals.Num() + ActiveExtensions.Num());
+	for (TPair<AActor*, FActorExtensions>& Pair : ActiveExtensions)
+	{
+		PendingRemovals.Emplace(Pair.Key, MoveTemp(Pair.Value));
+	}
+	ActiveExtensions.Empty();
+	SET_DWORD_STAT(STAT_MGC_PendingAbilitiesRemovals, PendingRemovals.Num());
+
+	// Actors won't be granted anything more
+	ReleaseExtensionHandlers();
+	PendingActors.Empty();
+
+	if (GMGCAbilitiesRemovalBudgetMs > 0.f && PendingRemovals.Num() > 0)
+	{
+		// Spread removal over the next frames, component requests are kept until then (removal needs the ability system component)
+		DeactivationCompleteDelegate = Context.PauseDeactivationUntilComplete();
+		PendingRemovalsTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMGCGameFeatureAction_AddAbilities::TickPendingRemovals));
+		return;
+	}
+
 	Reset();
 }
 
@@ -56,31 +144,13 @@ void UMGCGameFeatureAction_AddAbilities::AddAdditionalAssetBundleData(FAssetBund
 		return;
 	}
 
-	auto AddBundleAsset = [&AssetBundleData](const FSoftObjectPath& SoftObjectPath)
+	// Same assets as the ones loaded in a batch on activation
+	TArray<FSoftObjectPath> BundleAssets;
+	GetAssetsToLoad(BundleAssets);
+	for (const FSoftObjectPath& SoftObjectPath : BundleAssets)
 	{
 		AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateClient, SoftObjectPath);
 		AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateServer, SoftObjectPath);
-	};
-
-	for (const FMGCGameFeatureAbilitiesEntry& Entry : AbilitiesList)
-	{
-		for (const FMGCGameFeatureAbilityMapping& Ability : Entry.GrantedAbilities)
-		{
-			AddBundleAsset(Ability.AbilityType.ToSoftObjectPath());
-			if (!Ability.InputAction.IsNull())
-			{
-				AddBundleAsset(Ability.InputAction.ToSoftObjectPath());
-			}
-		}
-
-		for (const FMGCGameFeatureAttributeSetMapping& Attributes : Entry.GrantedAttributes)
-		{
-			AddBundleAsset(Attributes.AttributeSet.ToSoftObjectPath());
-			if (!Attributes.InitializationData.IsNull())
-			{
-				AddBundleAsset(Attributes.InitializationData.ToSoftObjectPath());
-			}
-		}
 	}
 }
 #endif
@@ -136,14 +206,130 @@ EDataValidationResult UMGCGameFeatureAction_AddAbilities::IsDataValid(TArray<FTe
 
 void UMGCGameFeatureAction_AddAbilities::Reset()
 {
+	ReleaseExtensionHandlers();
+	FlushPendingRemovals();
+
 	while (ActiveExtensions.Num() != 0)
 	{
 		const auto ExtensionIt = ActiveExtensions.CreateIterator();
 		RemoveActorAbilities(ExtensionIt->Key);
 	}
 
-	ExtensionsRequests.Empty();
+	// Only once everything was removed, removal needs the ability system component
 	ComponentRequests.Empty();
+
+	if (AssetsLoadHandle.IsValid())
+	{
+		AssetsLoadHandle->CancelHandle();
+		AssetsLoadHandle.Reset();
+	}
+
+	PendingActors.Empty();
+	bAssetsLoaded = false;
+
+	DEC_DWORD_STAT_BY(STAT_MGC_RecycledAttributeSets, RecycledAttributeSets.Num());
+	RecycledAttributeSets.Empty();
+	AttributeDefaultsCache.Empty();
+
+	// Everything is released, deactivation can go on
+	CompleteDeactivation();
+}
+
+void UMGCGameFeatureAction_AddAbilities::ReleaseExtensionHandlers()
+{
+	ExtensionsRequests.Empty();
+	ExtensionHandlerRequests.Empty();
+}
+
+bool UMGCGameFeatureAction_AddAbilities::TickPendingRemovals(float DeltaTime)
+{
+	const double ElapsedMs = RemovePendingExtensions(GMGCAbilitiesRemovalBudgetMs / 1000.);
+	PendingRemovalsMaxFrameMs = FMath::Max(PendingRemovalsMaxFrameMs, ElapsedMs);
+	PendingRemovalsNumFrames++;
+
+	if (PendingRemovals.Num() > 0)
+	{
+		return true;
+	}
+
+	// Done, release component requests and the rest, then complete deactivation
+	PendingRemovalsTickerHandle.Reset();
+	Reset();
+	return false;
+}
+
+void UMGCGameFeatureAction_AddAbilities::FlushPendingRemovals()
+{
+	if (PendingRemovalsTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(PendingRemovalsTickerHandle);
+		PendingRemovalsTickerHandle.Reset();
+	}
+
+	if (PendingRemovals.Num() > 0)
+	{
+		PendingRemovalsMaxFrameMs = FMath::Max(PendingRemovalsMaxFrameMs, RemovePendingExtensions(0.));
+		PendingRemovalsNumFrames++;
+	}
+
+	if (PendingRemovalsNumActors > 0)
+	{
+		MGC_LOG(
+			Log,
+			TEXT("UMGCGameFeatureAction_AddAbilities::FlushPendingRemovals %s. Removed abilities from %d actor(s) in %.2f ms over %d frame(s) (%.2f us per actor, max %.2f ms per frame)"),
+			*GetPathNameSafe(this),
+			PendingRemovalsNumActors,
+			PendingRemovalsTotalMs,
+			PendingRemovalsNumFrames,
+			PendingRemovalsTotalMs * 1000. / PendingRemovalsNumActors,
+			PendingRemovalsMaxFrameMs
+		);
+	}
+
+	PendingRemovalsTotalMs = 0.;
+	PendingRemovalsMaxFrameMs = 0.;
+	PendingRemovalsNumActors = 0;
+	PendingRemovalsNumFrames = 0;
+}
+
+void UMGCGameFeatureAction_AddAbilities::CompleteDeactivation()
+{
+	if (DeactivationCompleteDelegate.IsBound())
+	{
+		// Copy first, completing deactivation might end up calling back into this action
+		const FSimpleDelegate CompleteDelegate = DeactivationCompleteDelegate;
+		DeactivationCompleteDelegate.Unbind();
+		CompleteDelegate.Execute();
+	}
+}
+
+double UMGCGameFeatureAction_AddAbilities::RemovePendingExtensions(const double TimeLimit)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	double ElapsedSeconds = 0.;
+
+	// Processed from the end to remove entries without shifting the array, always at least one actor per call
+	while (PendingRemovals.Num() > 0)
+	{
+		TPair<TWeakObjectPtr<AActor>, FActorExtensions> PendingRemoval = PendingRemovals.Pop(false);
+		if (AActor* Actor = PendingRemoval.Key.Get())
+		{
+			RemoveActorExtensions(Actor, PendingRemoval.Value);
+			PendingRemovalsNumActors++;
+		}
+
+		ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		if (TimeLimit > 0. && ElapsedSeconds >= TimeLimit)
+		{
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_MGC_PendingAbilitiesRemovals, PendingRemovals.Num());
+
+	const double ElapsedMs = ElapsedSeconds * 1000.;
+	PendingRemovalsTotalMs += ElapsedMs;
+	return ElapsedMs;
 }
 
 void UMGCGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, const FName EventName, const int32 EntryIndex)
@@ -152,32 +338,32 @@ void UMGCGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, con
 	if (AbilitiesList.IsValidIndex(EntryIndex))
 	{
 		MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension '%s'. EventName: %s"), *Actor->GetPathName(), *EventName.ToString());
-		const FMGCGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if (EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved || EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved)
 		{
 			MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension remove '%s'. Abilities will be removed."), *Actor->GetPathName());
+			PendingActors.RemoveAll([Actor](const TPair<TWeakObjectPtr<AActor>, int32>& Pending) { return Pending.Key == Actor; });
 			RemoveActorAbilities(Actor);
 		}
 		else if (EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded || EventName == UGameFrameworkComponentManager::NAME_GameActorReady)
 		{
 			MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension add '%s'. Abilities will be granted."), *Actor->GetPathName());
-			AddActorAbilities(Actor, Entry);
+			AddOrQueueActorAbilities(Actor, EntryIndex);
 		}
 	}
 #else
 	if (AbilitiesList.IsValidIndex(EntryIndex))
 	{
 		MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension '%s'. EventName: %s"), *Actor->GetPathName(), *EventName.ToString());
-		const FMGCGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if (EventName == UMGCGameFrameworkExtensionManager::MGC_NAME_ExtensionRemoved || EventName == UMGCGameFrameworkExtensionManager::MGC_NAME_ReceiverRemoved)
 		{
 			MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension remove '%s'. Abilities will be removed."), *Actor->GetPathName());
+			PendingActors.RemoveAll([Actor](const TPair<TWeakObjectPtr<AActor>, int32>& Pending) { return Pending.Key == Actor; });
 			RemoveActorAbilities(Actor);
 		}
 		else if (EventName == UMGCGameFrameworkExtensionManager::MGC_NAME_ExtensionAdded || EventName == UMGCGameFrameworkExtensionManager::MGC_NAME_GameActorReady)
 		{
 			MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleActorExtension add '%s'. Abilities will be granted."), *Actor->GetPathName());
-			AddActorAbilities(Actor, Entry);
+			AddOrQueueActorAbilities(Actor, EntryIndex);
 		}
 	}
 #endif
@@ -185,8 +371,71 @@ void UMGCGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, con
 	// TODO: Handle 4.27
 }
 
+void UMGCGameFeatureAction_AddAbilities::AddOrQueueActorAbilities(AActor* Actor, const int32 EntryIndex)
+{
+	if (bAssetsLoaded)
+	{
+		AddActorAbilities(Actor, AbilitiesList[EntryIndex]);
+		return;
+	}
+
+	MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::AddOrQueueActorAbilities '%s'. Assets are still loading, abilities will be granted once loaded."), *Actor->GetPathName());
+	PendingActors.AddUnique(TPair<TWeakObjectPtr<AActor>, int32>(Actor, EntryIndex));
+}
+
+void UMGCGameFeatureAction_AddAbilities::HandleAssetsLoaded()
+{
+	bAssetsLoaded = true;
+
+	TArray<TPair<TWeakObjectPtr<AActor>, int32>> ActorsToGrant = MoveTemp(PendingActors);
+	MGC_LOG(Verbose, TEXT("UMGCGameFeatureAction_AddAbilities::HandleAssetsLoaded %s. Granting abilities to %d queued actor(s)"), *GetPathNameSafe(this), ActorsToGrant.Num());
+
+	for (const TPair<TWeakObjectPtr<AActor>, int32>& Pending : ActorsToGrant)
+	{
+		AActor* Actor = Pending.Key.Get();
+		if (IsValid(Actor) && AbilitiesList.IsValidIndex(Pending.Value))
+		{
+			AddActorAbilities(Actor, AbilitiesList[Pending.Value]);
+		}
+	}
+}
+
+void UMGCGameFeatureAction_AddAbilities::GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for (const FMGCGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		for (const FMGCGameFeatureAbilityMapping& Ability : Entry.GrantedAbilities)
+		{
+			if (!Ability.AbilityType.IsNull())
+			{
+				OutAssets.AddUnique(Ability.AbilityType.ToSoftObjectPath());
+			}
+
+			if (!Ability.InputAction.IsNull())
+			{
+				OutAssets.AddUnique(Ability.InputAction.ToSoftObjectPath());
+			}
+		}
+
+		for (const FMGCGameFeatureAttributeSetMapping& Attributes : Entry.GrantedAttributes)
+		{
+			if (!Attributes.AttributeSet.IsNull())
+			{
+				OutAssets.AddUnique(Attributes.AttributeSet.ToSoftObjectPath());
+			}
+
+			if (!Attributes.InitializationData.IsNull())
+			{
+				OutAssets.AddUnique(Attributes.InitializationData.ToSoftObjectPath());
+			}
+		}
+	}
+}
+
 void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FMGCGameFeatureAbilitiesEntry& AbilitiesEntry)
 {
+	SCOPE_CYCLE_COUNTER(STAT_MGC_AddActorAbilities);
+
 	UMGCAbilitySystemComponent* AbilitySystemComponent = FindOrAddComponentForActor<UMGCAbilitySystemComponent>(Actor, AbilitiesEntry);
 	if (!AbilitySystemComponent)
 	{
@@ -197,13 +446,18 @@ void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 	FActorExtensions AddedExtensions;
 	AddedExtensions.Abilities.Reserve(AbilitiesEntry.GrantedAbilities.Num());
 	AddedExtensions.Attributes.Reserve(AbilitiesEntry.GrantedAttributes.Num());
+	AddedExtensions.AbilitySystemComponent = AbilitySystemComponent;
+
+	// Found (or added) on first ability with an input action
+	UMGCAbilityInputBindingComponent* InputComponent = nullptr;
 
 	for (const FMGCGameFeatureAbilityMapping& Ability : AbilitiesEntry.GrantedAbilities)
 	{
-		if (!Ability.AbilityType.IsNull())
+		UClass* AbilityClass = Ability.AbilityType.IsNull() ? nullptr : GetOrLoadSynchronous(Ability.AbilityType);
+		if (AbilityClass)
 		{
 			FGameplayAbilitySpecHandle AbilityHandle;
-			FGameplayAbilitySpec NewAbilitySpec(Ability.AbilityType.LoadSynchronous());
+			FGameplayAbilitySpec NewAbilitySpec(AbilityClass);
 
 			// Try to grant the ability first
 			if (AbilitySystemComponent->IsOwnerActorAuthoritative())
@@ -215,7 +469,7 @@ void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 			else
 			{
 				// For clients, try to get ability spec and update handle used later on for input binding
-				const FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(Ability.AbilityType.LoadSynchronous());
+				const FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(AbilityClass);
 				if (AbilitySpec)
 				{
 					AbilityHandle = AbilitySpec->Handle;
@@ -226,19 +480,24 @@ void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 			// Handle Input Mapping now
 			if (!Ability.InputAction.IsNull())
 			{
-				UMGCAbilityInputBindingComponent* InputComponent = FindOrAddComponentForActor<UMGCAbilityInputBindingComponent>(Actor, AbilitiesEntry);
+				if (!InputComponent)
+				{
+					InputComponent = FindOrAddComponentForActor<UMGCAbilityInputBindingComponent>(Actor, AbilitiesEntry);
+					AddedExtensions.InputComponent = InputComponent;
+				}
+
 				if (InputComponent)
 				{
 					MGC_LOG(Verbose, TEXT("AddActorAbilities: Try to setup input binding for '%s': '%s' (%s)"), *Ability.InputAction.ToString(), *AbilityHandle.ToString(), *NewAbilitySpec.Handle.ToString())
 					if (AbilityHandle.IsValid())
 					{
 						// Setup input binding if AbilityHandle is valid and already granted (on authority, or when Game Features is active by default)
-						InputComponent->SetInputBinding(Ability.InputAction.LoadSynchronous(), Ability.TriggerEvent, AbilityHandle);
+						InputComponent->SetInputBinding(GetOrLoadSynchronous(Ability.InputAction), Ability.TriggerEvent, AbilityHandle);
 					}
 					else
 					{
 						// Register a delegate triggered when ability is granted and available on clients (needed when Game Features are made active during play)
-						UInputAction* InputAction = Ability.InputAction.LoadSynchronous();
+						UInputAction* InputAction = GetOrLoadSynchronous(Ability.InputAction);
 						FDelegateHandle DelegateHandle = AbilitySystemComponent->OnGiveAbilityDelegate.AddUObject(this, &UMGCGameFeatureAction_AddAbilities::HandleOnGiveAbility, InputComponent, InputAction, Ability.TriggerEvent, NewAbilitySpec);
 						AddedExtensions.InputBindingDelegateHandles.Add(DelegateHandle);
 					}
@@ -257,7 +516,7 @@ void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 	{
 		if (!Attributes.AttributeSet.IsNull() && AbilitySystemComponent->IsOwnerActorAuthoritative())
 		{
-			TSubclassOf<UAttributeSet> AttributeSetType = Attributes.AttributeSet.LoadSynchronous();
+			TSubclassOf<UAttributeSet> AttributeSetType = GetOrLoadSynchronous(Attributes.AttributeSet);
 			if (!AttributeSetType)
 			{
 				continue;
@@ -270,15 +529,8 @@ void UMGCGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 				continue;
 			}
 
-			UAttributeSet* AttributeSet = NewObject<UAttributeSet>(Actor, AttributeSetType);
-			if (!Attributes.InitializationData.IsNull())
-			{
-				UDataTable* InitData = Attributes.InitializationData.LoadSynchronous();
-				if (InitData)
-				{
-					AttributeSet->InitFromMetaDataTable(InitData);
-				}
-			}
+			const UDataTable* InitData = Attributes.InitializationData.IsNull() ? nullptr : GetOrLoadSynchronous(Attributes.InitializationData);
+			UAttributeSet* AttributeSet = CreateAttributeSet(Actor, AttributeSetType, InitData);
 
 			AddedExtensions.Attributes.Add(AttributeSet);
 			AbilitySystemComponent->AddAttributeSetSubobject(AttributeSet);
@@ -305,49 +557,203 @@ void UMGCGameFeatureAction_AddAbilities::RemoveActorAbilities(const AActor* Acto
 	}
 
 	if (FActorExtensions* ActorExtensions = ActiveExtensions.Find(Actor))
+	{
+		RemoveActorExtensions(Actor, *ActorExtensions);
+		ActiveExtensions.Remove(Actor);
+	}
+}
+
+void UMGCGameFeatureAction_AddAbilities::RemoveActorExtensions(const AActor* Actor, FActorExtensions& ActorExtensions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MGC_RemoveActorAbilities);
+
+	UMGCAbilitySystemComponent* AbilitySystemComponent = ActorExtensions.AbilitySystemComponent.Get();
+	if (!AbilitySystemComponent)
 	{
 		// TODO: In 4.27 and as client, getting random invalid interface address with GetAbilitySystemComponentFromActor
 		// UMGCAbilitySystemComponent* AbilitySystemComponent = Cast<UMGCAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor));
-		UMGCAbilitySystemComponent* AbilitySystemComponent = Actor->FindComponentByClass<UMGCAbilitySystemComponent>();
-		if (AbilitySystemComponent)
+		AbilitySystemComponent = Actor->FindComponentByClass<UMGCAbilitySystemComponent>();
+	}
+
+	if (AbilitySystemComponent)
+	{
+		for (UAttributeSet* AttribSetInstance : ActorExtensions.Attributes)
+		{
+			AbilitySystemComponent->GetSpawnedAttributes_Mutable().Remove(AttribSetInstance);
+			RecycleAttributeSet(Actor, AttribSetInstance);
+		}
+
+		UMGCAbilityInputBindingComponent* InputComponent = ActorExtensions.InputComponent.Get();
+		const bool bAuthority = AbilitySystemComponent->IsOwnerActorAuthoritative();
+		for (const FGameplayAbilitySpecHandle AbilityHandle : ActorExtensions.Abilities)
 		{
-			for (UAttributeSet* AttribSetInstance : ActorExtensions->Attributes)
+			if (InputComponent)
 			{
-				AbilitySystemComponent->GetSpawnedAttributes_Mutable().Remove(AttribSetInstance);
+				InputComponent->ClearInputBinding(AbilityHandle);
 			}
 
-			UMGCAbilityInputBindingComponent* InputComponent = Actor->FindComponentByClass<UMGCAbilityInputBindingComponent>();
-			for (const FGameplayAbilitySpecHandle AbilityHandle : ActorExtensions->Abilities)
+			// Only Clear abilities on authority
+			if (bAuthority)
 			{
-				if (InputComponent)
-				{
-					InputComponent->ClearInputBinding(AbilityHandle);
-				}
-
-				// Only Clear abilities on authority
-				if (AbilitySystemComponent->IsOwnerActorAuthoritative())
-				{
-					AbilitySystemComponent->SetRemoveAbilityOnEnd(AbilityHandle);
-				}
+				AbilitySystemComponent->SetRemoveAbilityOnEnd(AbilityHandle);
 			}
 		}
-		else
+	}
+	else
+	{
+		MGC_LOG(Error, TEXT("RemoveActorAbilities: Not able to find MGCAbilitySystemComponent"))
+	}
+
+	// Clear any delegate handled bound previously for this actor
+	for (FDelegateHandle InputBindingDelegateHandle : ActorExtensions.InputBindingDelegateHandles)
+	{
+		if (AbilitySystemComponent)
 		{
-			MGC_LOG(Error, TEXT("RemoveActorAbilities: Not able to find MGCAbilitySystemComponent"))
+			AbilitySystemComponent->OnGiveAbilityDelegate.Remove(InputBindingDelegateHandle);
 		}
+		InputBindingDelegateHandle.Reset();
+	}
+}
+
+UAttributeSet* UMGCGameFeatureAction_AddAbilities::CreateAttributeSet(AActor* Actor, const TSubclassOf<UAttributeSet> AttributeSetType, const UDataTable* InitData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MGC_InitAttributeSet);
+
+	// Sets recycled earlier are left alone while recycling is disabled (eg. overridden from the console)
+	int32 RecycledIndex = INDEX_NONE;
+	if (ShouldRecycleAttributeSets())
+	{
+		RecycledIndex = RecycledAttributeSets.IndexOfByPredicate([&AttributeSetType](const UAttributeSet* RecycledSet)
+		{
+			return IsValid(RecycledSet) && RecycledSet->GetClass() == AttributeSetType;
+		});
+	}
 
-		// Clear any delegate handled bound previously for this actor
-		for (FDelegateHandle InputBindingDelegateHandle : ActorExtensions->InputBindingDelegateHandles)
+	if (RecycledIndex == INDEX_NONE)
+	{
+		INC_DWORD_STAT(STAT_MGC_AttributeSetsCreated);
+
+		UAttributeSet* AttributeSet = NewObject<UAttributeSet>(Actor, AttributeSetType);
+		if (InitData)
 		{
-			if (AbilitySystemComponent)
-			{
-				AbilitySystemComponent->OnGiveAbilityDelegate.Remove(InputBindingDelegateHandle);
-			}
-			InputBindingDelegateHandle.Reset();
+			InitAttributeSet(AttributeSet, InitData);
 		}
 
-		ActiveExtensions.Remove(Actor);
+		return AttributeSet;
+	}
+
+	INC_DWORD_STAT(STAT_MGC_AttributeSetsReused);
+	DEC_DWORD_STAT(STAT_MGC_RecycledAttributeSets);
+
+	UAttributeSet* AttributeSet = RecycledAttributeSets[RecycledIndex];
+	RecycledAttributeSets.RemoveAtSwap(RecycledIndex);
+	AttributeSet->Rename(*MakeUniqueObjectName(Actor, AttributeSetType).ToString(), Actor, REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_DoNotDirty | REN_NonTransactional);
+
+	// Back to class defaults (values left by the previous owner), then DataTable defaults
+	const UObject* DefaultObject = AttributeSetType->GetDefaultObject();
+	for (TFieldIterator<FProperty> It(AttributeSetType, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		It->CopyCompleteValue_InContainer(AttributeSet, DefaultObject);
+	}
+
+	if (InitData)
+	{
+		InitAttributeSet(AttributeSet, InitData);
+	}
+
+	return AttributeSet;
+}
+
+void UMGCGameFeatureAction_AddAbilities::InitAttributeSet(UAttributeSet* AttributeSet, const UDataTable* InitData)
+{
+	check(AttributeSet);
+	check(InitData);
+
+	if (!GMGCCacheAttributeDefaults)
+	{
+		AttributeSet->InitFromMetaDataTable(InitData);
+		return;
+	}
+
+	const FAttributeSetDefaults& Defaults = GetAttributeSetDefaults(AttributeSet->GetClass(), InitData);
+
+	for (const TPair<FNumericProperty*, float>& Pair : Defaults.NumericValues)
+	{
+		Pair.Key->SetFloatingPointPropertyValue(Pair.Key->ContainerPtrToValuePtr<void>(AttributeSet), Pair.Value);
 	}
+
+	for (const TPair<FStructProperty*, float>& Pair : Defaults.AttributeDataValues)
+	{
+		FGameplayAttributeData* DataPtr = Pair.Key->ContainerPtrToValuePtr<FGameplayAttributeData>(AttributeSet);
+		DataPtr->SetBaseValue(Pair.Value);
+		DataPtr->SetCurrentValue(Pair.Value);
+	}
+}
+
+const UMGCGameFeatureAction_AddAbilities::FAttributeSetDefaults& UMGCGameFeatureAction_AddAbilities::GetAttributeSetDefaults(UClass* AttributeSetClass, const UDataTable* InitData)
+{
+	const TPair<TObjectKey<UClass>, TObjectKey<UDataTable>> Key(AttributeSetClass, InitData);
+	if (const FAttributeSetDefaults* CachedDefaults = AttributeDefaultsCache.Find(Key))
+	{
+		return *CachedDefaults;
+	}
+
+	// Same rows lookup as UAttributeSet::InitFromMetaDataTable
+	static const FString Context = FString(TEXT("UMGCGameFeatureAction_AddAbilities::GetAttributeSetDefaults"));
+
+	FAttributeSetDefaults& Defaults = AttributeDefaultsCache.Add(Key);
+	for (TFieldIterator<FProperty> It(AttributeSetClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		FProperty* Property = *It;
+		FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		if (!NumericProperty && !FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+
+		const FString RowNameStr = FString::Printf(TEXT("%s.%s"), *Property->GetOwnerVariant().GetName(), *Property->GetName());
+		const FAttributeMetaData* MetaData = InitData->FindRow<FAttributeMetaData>(FName(*RowNameStr), Context, false);
+		if (!MetaData)
+		{
+			continue;
+		}
+
+		if (NumericProperty)
+		{
+			Defaults.NumericValues.Emplace(NumericProperty, MetaData->BaseValue);
+		}
+		else
+		{
+			FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			check(StructProperty);
+			Defaults.AttributeDataValues.Emplace(StructProperty, MetaData->BaseValue);
+		}
+	}
+
+	return Defaults;
+}
+
+void UMGCGameFeatureAction_AddAbilities::RecycleAttributeSet(const AActor* Actor, UAttributeSet* AttributeSet)
+{
+	if (!ShouldRecycleAttributeSets() || !IsValid(AttributeSet) || RecycledAttributeSets.Num() >= MaxRecycledAttributeSets)
+	{
+		return;
+	}
+
+	// A replicated set would keep the network identity it had with its previous owner
+	if (Actor->GetIsReplicated() && Actor->GetNetMode() != NM_Standalone)
+	{
+		return;
+	}
+
+	AttributeSet->Rename(*MakeUniqueObjectName(GetTransientPackage(), AttributeSet->GetClass()).ToString(), GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_DoNotDirty | REN_NonTransactional);
+	RecycledAttributeSets.Add(AttributeSet);
+	INC_DWORD_STAT(STAT_MGC_RecycledAttributeSets);
+}
+
+bool UMGCGameFeatureAction_AddAbilities::ShouldRecycleAttributeSets() const
+{
+	return GMGCRecycleAttributeSetsOverride >= 0 ? GMGCRecycleAttributeSetsOverride > 0 : bRecycleAttributeSets;
 }
 
 UActorComponent* UMGCGameFeatureAction_AddAbilities::FindOrAddComponentForActor(UClass* ComponentType, const AActor* Actor, const FMGCGameFeatureAbilitiesEntry& AbilitiesEntry)
@@ -417,7 +823,7 @@ void UMGCGameFeatureAction_AddAbilities::AddToWorld(const FWorldContext& WorldCo
 					);
 					TSharedPtr<FComponentRequestHandle> ExtensionRequestHandle = ComponentMan->AddExtensionHandler(Entry.ActorClass, AddAbilitiesDelegate);
 
-					ComponentRequests.Add(ExtensionRequestHandle);
+					ExtensionHandlerRequests.Add(ExtensionRequestHandle);
 					EntryIndex++;
 				}
 			}
@@ -9,6 +9,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Player/GSCPlayerController.h"
 #include "Player/GSCPlayerState.h"
+#include "Subsystems/GSCSignificanceSubsystem.h"
 
 
 AGSCALSModCharacter::AGSCALSModCharacter(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -26,7 +27,7 @@ AGSCALSModCharacter::AGSCALSModCharacter(const FObjectInitializer& ObjectInitial
 	MeshComponent->bEnableUpdateRateOptimizations = true;
 	MeshComponent->bPropagateCurvesToSlaves = true;
 
-	// Always tick Pose and refresh Bones!
+	// Always tick Pose and refresh Bones! Scaled down at runtime by UGSCSignificanceSubsystem when significance is enabled
 	MeshComponent->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 
 	// Setup ALS defaults
@@ -80,6 +81,11 @@ void AGSCALSModCharacter::BeginPlay()
 	Super::BeginPlay();
 	UMGCGameFrameworkExtensionManager::SendGameFrameworkComponentExtensionEvent(this, UMGCGameFrameworkExtensionManager::MGC_NAME_GameActorReady);
 #endif
+
+	if (UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
 }
 
 void AGSCALSModCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -90,6 +96,11 @@ void AGSCALSModCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	UMGCGameFrameworkExtensionManager::RemoveGameFrameworkComponentReceiver(this);
 #endif
 
+	if (UGSCSignificanceSubsystem* SignificanceSubsystem = UGSCSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
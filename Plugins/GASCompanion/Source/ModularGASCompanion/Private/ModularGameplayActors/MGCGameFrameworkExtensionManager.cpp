@@ -4,6 +4,20 @@
 #include "ModularGameplayActors/MGCGameFrameworkExtensionManager.h"
 
 #include "EngineUtils.h"
+#include "ModularGASCompanionLog.h"
+#include "ModularGASCompanionStats.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Send Extension Event"), STAT_MGC_SendExtensionEvent, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Extension Handlers Resolves"), STAT_MGC_ExtensionHandlersResolves, STATGROUP_ModularGASCompanion);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Extension Receivers"), STAT_MGC_ExtensionReceivers, STATGROUP_ModularGASCompanion);
+
+static bool GMGCCacheExtensionHandlers = true;
+static FAutoConsoleVariableRef CVarMGCCacheExtensionHandlers(
+	TEXT("MGC.CacheExtensionHandlers"),
+	GMGCCacheExtensionHandlers,
+	TEXT("If true, extension handlers to run for a receiver class are resolved once per class instead of walking the class hierarchy on every extension event")
+);
 
 FName UMGCGameFrameworkExtensionManager::MGC_NAME_ReceiverAdded = FName("ReceiverAdded");
 FName UMGCGameFrameworkExtensionManager::MGC_NAME_ReceiverRemoved = FName("ReceiverRemoved");
@@ -91,23 +105,13 @@ TSharedPtr<FMGCComponentRequestHandle> UMGCGameFrameworkExtensionManager::AddExt
 	// This is a fake multicast delegate using a map
 	FDelegateHandle DelegateHandle(FDelegateHandle::EGenerateNewHandleType::GenerateNewHandle);
 	HandlerEvent.Add(DelegateHandle, ExtensionHandler);
+	ResolvedHandlersCache.Reset();
 
 	if (UClass* ReceiverClassPtr = ReceiverClass.Get())
 	{
-		UGameInstance* LocalGameInstance = GetGameInstance();
-		if (ensure(LocalGameInstance))
+		for (AActor* Receiver : GetReceiversOfClass(ReceiverClassPtr))
 		{
-			UWorld* LocalWorld = LocalGameInstance->GetWorld();
-			if (ensure(LocalWorld))
-			{
-				for (TActorIterator<AActor> ActorIt(LocalWorld, ReceiverClassPtr); ActorIt; ++ActorIt)
-				{
-					if (ActorIt->IsActorInitialized())
-					{
-						ExtensionHandler.Execute(*ActorIt, MGC_NAME_ExtensionAdded);
-					}
-				}
-			}
+			ExtensionHandler.Execute(Receiver, MGC_NAME_ExtensionAdded);
 		}
 	}
 	else
@@ -162,38 +166,148 @@ void UMGCGameFrameworkExtensionManager::SendExtensionEvent(AActor* Receiver, con
 
 void UMGCGameFrameworkExtensionManager::SendExtensionEventInternal(AActor* Receiver, const FName& EventName)
 {
-	for (UClass* Class = Receiver->GetClass(); Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
+	SCOPE_CYCLE_COUNTER(STAT_MGC_SendExtensionEvent);
+
+	// Keep a reference on the list, handlers might add or remove other handlers (and empty the cache) while executing
+	const TSharedRef<const FResolvedExtensionHandlers, ESPMode::Fast> Handlers = GetResolvedHandlers(Receiver->GetClass());
+	for (const FExtensionHandlerDelegate& Handler : *Handlers)
+	{
+		Handler.Execute(Receiver, EventName);
+	}
+}
+
+TSharedRef<const UMGCGameFrameworkExtensionManager::FResolvedExtensionHandlers, ESPMode::Fast> UMGCGameFrameworkExtensionManager::GetResolvedHandlers(UClass* ReceiverClass)
+{
+	if (GMGCCacheExtensionHandlers)
+	{
+		if (const TSharedRef<const FResolvedExtensionHandlers, ESPMode::Fast>* CachedHandlers = ResolvedHandlersCache.Find(ReceiverClass))
+		{
+			return *CachedHandlers;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_MGC_ExtensionHandlersResolves);
+
+	TSharedRef<FResolvedExtensionHandlers, ESPMode::Fast> Handlers = MakeShared<FResolvedExtensionHandlers, ESPMode::Fast>();
+	for (UClass* Class = ReceiverClass; Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
 	{
 		FMGCComponentRequestReceiverClassPath ReceiverClassPath(Class);
 		if (FExtensionHandlerEvent* HandlerEvent = ReceiverClassToEventMap.Find(ReceiverClassPath))
 		{
 			for (const TPair<FDelegateHandle, FExtensionHandlerDelegate>& Pair : *HandlerEvent)
 			{
-				Pair.Value.Execute(Receiver, EventName);
+				Handlers->Add(Pair.Value);
 			}
 		}
 	}
+
+	if (GMGCCacheExtensionHandlers)
+	{
+		ResolvedHandlersCache.Add(ReceiverClass, Handlers);
+	}
+
+	return Handlers;
 }
 
 void UMGCGameFrameworkExtensionManager::AddReceiverInternal(AActor* Receiver)
 {
-	for (UClass* Class = Receiver->GetClass(); Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
+	bool bAlreadyRegistered = false;
+	ReceiversByClass.FindOrAdd(Receiver->GetClass()).Add(Receiver, &bAlreadyRegistered);
+	if (!bAlreadyRegistered)
 	{
-		FMGCComponentRequestReceiverClassPath ReceiverClassPath(Class);
+		INC_DWORD_STAT(STAT_MGC_ExtensionReceivers);
+	}
 
-		if (FExtensionHandlerEvent* HandlerEvent = ReceiverClassToEventMap.Find(ReceiverClassPath))
+	SendExtensionEventInternal(Receiver, MGC_NAME_ReceiverAdded);
+}
+
+void UMGCGameFrameworkExtensionManager::RemoveReceiverInternal(AActor* Receiver)
+{
+	if (TSet<TWeakObjectPtr<AActor>>* Receivers = ReceiversByClass.Find(Receiver->GetClass()))
+	{
+		if (Receivers->Remove(Receiver) > 0)
 		{
-			for (const TPair<FDelegateHandle, FExtensionHandlerDelegate>& Pair : *HandlerEvent)
+			DEC_DWORD_STAT(STAT_MGC_ExtensionReceivers);
+		}
+
+		if (Receivers->Num() == 0)
+		{
+			ReceiversByClass.Remove(Receiver->GetClass());
+		}
+	}
+
+	SendExtensionEventInternal(Receiver, MGC_NAME_ReceiverRemoved);
+}
+
+TArray<AActor*> UMGCGameFrameworkExtensionManager::GetReceiversOfClass(UClass* ReceiverClass)
+{
+	// Gathered upfront, handlers might add or remove receivers while executing
+	TArray<AActor*> Result;
+	for (auto ClassIt = ReceiversByClass.CreateIterator(); ClassIt; ++ClassIt)
+	{
+		const UClass* Class = ClassIt.Key().ResolveObjectPtr();
+		if (!Class)
+		{
+			// Class was unloaded along with its actors
+			ClassIt.RemoveCurrent();
+			continue;
+		}
+
+		if (!Class->IsChildOf(ReceiverClass))
+		{
+			continue;
+		}
+
+		for (const TWeakObjectPtr<AActor>& Receiver : ClassIt.Value())
+		{
+			if (Receiver.IsValid() && Receiver->IsActorInitialized())
 			{
-				Pair.Value.Execute(Receiver, MGC_NAME_ReceiverAdded);
+				Result.Add(Receiver.Get());
 			}
 		}
 	}
+
+	return Result;
 }
 
-void UMGCGameFrameworkExtensionManager::RemoveReceiverInternal(AActor* Receiver)
+int32 UMGCGameFrameworkExtensionManager::ValidateReceivers() const
 {
-	SendExtensionEventInternal(Receiver, MGC_NAME_ReceiverRemoved);
+	const UGameInstance* LocalGameInstance = GetGameInstance();
+	UWorld* LocalWorld = LocalGameInstance ? LocalGameInstance->GetWorld() : nullptr;
+	if (!LocalWorld)
+	{
+		return 0;
+	}
+
+	int32 NumErrors = 0;
+	for (const TPair<TObjectKey<UClass>, TSet<TWeakObjectPtr<AActor>>>& Pair : ReceiversByClass)
+	{
+		UClass* Class = Pair.Key.ResolveObjectPtr();
+		if (!Class)
+		{
+			continue;
+		}
+
+		for (const TWeakObjectPtr<AActor>& Receiver : Pair.Value)
+		{
+			if (!Receiver.IsValid() || Receiver->GetWorld() != LocalWorld || !Receiver->GetLevel() || !LocalWorld->ContainsLevel(Receiver->GetLevel()))
+			{
+				MGC_LOG(Error, TEXT("UMGCGameFrameworkExtensionManager::ValidateReceivers() Registered %s receiver is no longer in the world"), *Class->GetName())
+				NumErrors++;
+			}
+		}
+
+		for (TActorIterator<AActor> ActorIt(LocalWorld, Class); ActorIt; ++ActorIt)
+		{
+			if (ActorIt->GetClass() == Class && ActorIt->IsActorInitialized() && !Pair.Value.Contains(*ActorIt))
+			{
+				MGC_LOG(Error, TEXT("UMGCGameFrameworkExtensionManager::ValidateReceivers() %s is in the world but not registered as a receiver"), *ActorIt->GetName())
+				NumErrors++;
+			}
+		}
+	}
+
+	return NumErrors;
 }
 
 void UMGCGameFrameworkExtensionManager::RemoveExtensionHandler(const TSoftClassPtr<AActor>& ReceiverClass, FDelegateHandle DelegateHandle)
@@ -208,20 +322,9 @@ void UMGCGameFrameworkExtensionManager::RemoveExtensionHandler(const TSoftClassP
 			// Call it once on unregister
 			if (UClass* ReceiverClassPtr = ReceiverClass.Get())
 			{
-				UGameInstance* LocalGameInstance = GetGameInstance();
-				if (ensure(LocalGameInstance))
+				for (AActor* Receiver : GetReceiversOfClass(ReceiverClassPtr))
 				{
-					UWorld* LocalWorld = LocalGameInstance->GetWorld();
-					if (ensure(LocalWorld))
-					{
-						for (TActorIterator<AActor> ActorIt(LocalWorld, ReceiverClassPtr); ActorIt; ++ActorIt)
-						{
-							if (ActorIt->IsActorInitialized())
-							{
-								HandlerDelegate->Execute(*ActorIt, MGC_NAME_ExtensionRemoved);
-							}
-						}
-					}
+					HandlerDelegate->Execute(Receiver, MGC_NAME_ExtensionRemoved);
 				}
 			}
 			else
@@ -230,6 +333,7 @@ void UMGCGameFrameworkExtensionManager::RemoveExtensionHandler(const TSoftClassP
 			}
 
 			HandlerEvent->Remove(DelegateHandle);
+			ResolvedHandlersCache.Reset();
 
 			if (HandlerEvent->Num() == 0)
 			{
@@ -4,9 +4,14 @@
 
 #include "AbilitySystemComponent.h"
 #include "DisplayDebugHelpers.h"
+#include "GameFeaturesSubsystem.h"
 #include "ModularGASCompanionLog.h"
 #include "Components/GSCAbilityQueueComponent.h"
 #include "Components/GSCComboManagerComponent.h"
+#include "Engine/LevelStreaming.h"
+#include "Kismet/GameplayStatics.h"
+#include "ModularGameplayActors/MGCGameFrameworkExtensionManager.h"
+#include "ModularGameplayActors/ModularCharacter.h"
 #include "Player/GSCHUD.h"
 
 void UMGCConsoleManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -27,6 +32,30 @@ void UMGCConsoleManagerSubsystem::Initialize(FSubsystemCollectionBase& Collectio
 		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::ToggleAbilityQueueWidget)
 	);
 
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("GASCompanion.Debug.MeasureFeatureActivation"),
+		TEXT("Activates a Game Feature plugin and logs the longest game thread stall (frame time) until it is active and its actions settled. Usage: GASCompanion.Debug.MeasureFeatureActivation <PluginName> [SettleFrames=30]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::MeasureFeatureActivation)
+	);
+
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("GASCompanion.Debug.BenchmarkExtensionEvents"),
+		TEXT("Spawns modular characters with extension handlers registered for their class hierarchy and logs the time spent sending extension events, with and without MGC.CacheExtensionHandlers. Usage: GASCompanion.Debug.BenchmarkExtensionEvents [NumActors=5000] [NumHandlers=10]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::BenchmarkExtensionEvents)
+	);
+
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("GASCompanion.Debug.TestExtensionReceivers"),
+		TEXT("Checks extension receivers registered with the extension manager against actors in the world. If a streaming level is given, checks again after loading and after unloading it. Usage: GASCompanion.Debug.TestExtensionReceivers [StreamingLevelName]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::TestExtensionReceivers)
+	);
+
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("GASCompanion.Debug.BenchmarkAttributeSetChurn"),
+		TEXT("Spawns and destroys actors receiving Game Feature granted attribute sets for a number of cycles, with attribute set recycling off and on (through MGC.RecycleAttributeSetsOverride) and with and without MGC.CacheAttributeDefaults, and logs spawn / despawn time, UObject growth and garbage collection time. Usage: GASCompanion.Debug.BenchmarkAttributeSetChurn [NumActors=200] [Cycles=10] [ActorClass=/Script/ModularGASCompanion.ModularCharacter]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::BenchmarkAttributeSetChurn)
+	);
+
 	// IConsoleManager::Get().RegisterConsoleCommand(
 	// 	TEXT("GASCompanion.ShowDebug.Attributes"),
 	// 	TEXT("Executes `showdebug abilitysystem` and navigate to Attributes category"),
@@ -55,9 +84,366 @@ void UMGCConsoleManagerSubsystem::Initialize(FSubsystemCollectionBase& Collectio
 void UMGCConsoleManagerSubsystem::Deinitialize()
 {
 	MGC_LOG(Log, TEXT("Shutting down GAS Companion console manager subsystem"));
+
+	if (FeatureActivationTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(FeatureActivationTickerHandle);
+		FeatureActivationTickerHandle.Reset();
+	}
+
 	Super::Deinitialize();
 }
 
+void UMGCConsoleManagerSubsystem::MeasureFeatureActivation(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	if (Args.Num() < 1)
+	{
+		MGC_LOG(Warning, TEXT("UMGCConsoleManagerSubsystem:MeasureFeatureActivation() Usage: GASCompanion.Debug.MeasureFeatureActivation <PluginName> [SettleFrames=30]"))
+		return;
+	}
+
+	if (FeatureActivationMeasure.IsSet())
+	{
+		MGC_LOG(Warning, TEXT("UMGCConsoleManagerSubsystem:MeasureFeatureActivation() Already measuring activation of %s"), *FeatureActivationMeasure->PluginName)
+		return;
+	}
+
+	UGameFeaturesSubsystem& GameFeaturesSubsystem = UGameFeaturesSubsystem::Get();
+	FString PluginURL;
+	if (!GameFeaturesSubsystem.GetPluginURLForBuiltInPluginByName(Args[0], PluginURL))
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:MeasureFeatureActivation() %s is not a built in Game Feature plugin"), *Args[0])
+		return;
+	}
+
+	FFeatureActivationMeasure& Measure = FeatureActivationMeasure.Emplace();
+	Measure.PluginName = Args[0];
+	Measure.SettleFramesLeft = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 30;
+	Measure.StartTime = FPlatformTime::Seconds();
+	Measure.LastFrameTime = Measure.StartTime;
+
+	FeatureActivationTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMGCConsoleManagerSubsystem::TickFeatureActivationMeasure));
+
+	// Whatever activation does synchronously from here ends up in the frame time of the current frame
+	GameFeaturesSubsystem.LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateWeakLambda(this, [this](const UE::GameFeatures::FResult& Result)
+	{
+		if (FeatureActivationMeasure.IsSet())
+		{
+			FeatureActivationMeasure->bActivated = true;
+			FeatureActivationMeasure->ActivationMs = (FPlatformTime::Seconds() - FeatureActivationMeasure->StartTime) * 1000.;
+		}
+
+		if (Result.HasError())
+		{
+			MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:MeasureFeatureActivation() Failed to activate: %s"), *Result.GetError())
+		}
+	}));
+}
+
+bool UMGCConsoleManagerSubsystem::TickFeatureActivationMeasure(float DeltaTime)
+{
+	if (!FeatureActivationMeasure.IsSet())
+	{
+		FeatureActivationTickerHandle.Reset();
+		return false;
+	}
+
+	FFeatureActivationMeasure& Measure = FeatureActivationMeasure.GetValue();
+	const double Now = FPlatformTime::Seconds();
+	Measure.MaxStallMs = FMath::Max(Measure.MaxStallMs, (Now - Measure.LastFrameTime) * 1000.);
+	Measure.LastFrameTime = Now;
+	Measure.NumFrames++;
+
+	// Keep going for a few frames once active, for async loads completing and queued actors being granted abilities
+	if (!Measure.bActivated || --Measure.SettleFramesLeft > 0)
+	{
+		return true;
+	}
+
+	MGC_LOG(
+		Display,
+		TEXT("UMGCConsoleManagerSubsystem:MeasureFeatureActivation() %s - Activated in %.2f ms, max game thread stall: %.2f ms over %d frames"),
+		*Measure.PluginName,
+		Measure.ActivationMs,
+		Measure.MaxStallMs,
+		Measure.NumFrames
+	)
+
+	FeatureActivationMeasure.Reset();
+	FeatureActivationTickerHandle.Reset();
+	return false;
+}
+
+void UMGCConsoleManagerSubsystem::BenchmarkExtensionEvents(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	UGameInstance* GameInstance = InWorld ? InWorld->GetGameInstance() : nullptr;
+	UMGCGameFrameworkExtensionManager* ExtensionManager = GameInstance ? GameInstance->GetSubsystem<UMGCGameFrameworkExtensionManager>() : nullptr;
+	if (!ExtensionManager)
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:BenchmarkExtensionEvents() Cannot get extension manager, must be run in a game world"))
+		return;
+	}
+
+	IConsoleVariable* CacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("MGC.CacheExtensionHandlers"));
+	if (!CacheCVar)
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:BenchmarkExtensionEvents() Cannot find MGC.CacheExtensionHandlers console variable"))
+		return;
+	}
+
+	const int32 NumActors = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000;
+	const int32 NumHandlers = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10;
+
+	// Register handlers for each class of the modular character hierarchy, as game features usually target base classes
+	TArray<UClass*> TargetClasses;
+	for (UClass* Class = AModularCharacter::StaticClass(); Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
+	{
+		TargetClasses.Add(Class);
+	}
+
+	int64 NumHandlerCalls = 0;
+	TArray<TSharedPtr<FMGCComponentRequestHandle>> Handles;
+	for (int32 HandlerIndex = 0; HandlerIndex < NumHandlers; ++HandlerIndex)
+	{
+		const TSoftClassPtr<AActor> ReceiverClass(TargetClasses[HandlerIndex % TargetClasses.Num()]);
+		Handles.Add(ExtensionManager->AddExtensionHandler(ReceiverClass, UMGCGameFrameworkExtensionManager::FExtensionHandlerDelegate::CreateWeakLambda(this, [&NumHandlerCalls](AActor* Actor, FName EventName)
+		{
+			NumHandlerCalls++;
+		})));
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(NumActors);
+
+	// Spawning goes through AddReceiver, with handlers resolved once for the class
+	NumHandlerCalls = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		if (AActor* Actor = InWorld->SpawnActor<AModularCharacter>(AModularCharacter::StaticClass(), FTransform::Identity, SpawnParameters))
+		{
+			Actors.Add(Actor);
+		}
+	}
+	const double SpawnMs = (FPlatformTime::Seconds() - StartTime) * 1000.;
+	const int64 SpawnHandlerCalls = NumHandlerCalls;
+
+	const bool bPreviousCacheValue = CacheCVar->GetBool();
+	double SendMs[2] = {};
+	int64 SendHandlerCalls[2] = {};
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		// First pass walks the class hierarchy for every event, second one uses the per class cache
+		CacheCVar->Set(Pass == 1, ECVF_SetByConsole);
+
+		NumHandlerCalls = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (AActor* Actor : Actors)
+		{
+			ExtensionManager->SendExtensionEvent(Actor, UMGCGameFrameworkExtensionManager::MGC_NAME_GameActorReady);
+		}
+		SendMs[Pass] = (FPlatformTime::Seconds() - StartTime) * 1000.;
+		SendHandlerCalls[Pass] = NumHandlerCalls;
+	}
+
+	CacheCVar->Set(bPreviousCacheValue, ECVF_SetByConsole);
+
+	for (AActor* Actor : Actors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+
+	// Releasing handles removes the handlers (and sends ExtensionRemoved to remaining actors)
+	Handles.Reset();
+
+	MGC_LOG(
+		Display,
+		TEXT("UMGCConsoleManagerSubsystem:BenchmarkExtensionEvents() %d actors, %d handlers - Spawn: %.2f ms (%lld handler calls), Send uncached: %.2f ms (%lld handler calls), Send cached: %.2f ms (%lld handler calls)"),
+		Actors.Num(),
+		NumHandlers,
+		SpawnMs,
+		SpawnHandlerCalls,
+		SendMs[0],
+		SendHandlerCalls[0],
+		SendMs[1],
+		SendHandlerCalls[1]
+	)
+}
+
+void UMGCConsoleManagerSubsystem::TestExtensionReceivers(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	UGameInstance* GameInstance = InWorld ? InWorld->GetGameInstance() : nullptr;
+	UMGCGameFrameworkExtensionManager* ExtensionManager = GameInstance ? GameInstance->GetSubsystem<UMGCGameFrameworkExtensionManager>() : nullptr;
+	if (!ExtensionManager)
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:TestExtensionReceivers() Cannot get extension manager, must be run in a game world"))
+		return;
+	}
+
+	int32 NumErrors = ExtensionManager->ValidateReceivers();
+
+	if (Args.Num() > 0)
+	{
+		ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(InWorld, FName(*Args[0]));
+		if (!StreamingLevel)
+		{
+			MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:TestExtensionReceivers() %s is not a streaming level of the current world"), *Args[0])
+			return;
+		}
+
+		const bool bWasLoaded = StreamingLevel->ShouldBeLoaded();
+		const bool bWasVisible = StreamingLevel->ShouldBeVisible();
+
+		// Load and show the level, so its modular actors register as receivers
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+		InWorld->FlushLevelStreaming();
+		NumErrors += ExtensionManager->ValidateReceivers();
+
+		// Then unload it, its modular actors should all have been removed on EndPlay
+		StreamingLevel->SetShouldBeVisible(false);
+		StreamingLevel->SetShouldBeLoaded(false);
+		InWorld->FlushLevelStreaming();
+		NumErrors += ExtensionManager->ValidateReceivers();
+
+		StreamingLevel->SetShouldBeLoaded(bWasLoaded);
+		StreamingLevel->SetShouldBeVisible(bWasVisible);
+	}
+
+	if (NumErrors > 0)
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:TestExtensionReceivers() Failed with %d errors"), NumErrors)
+	}
+	else
+	{
+		MGC_LOG(Display, TEXT("UMGCConsoleManagerSubsystem:TestExtensionReceivers() Passed"))
+	}
+}
+
+void UMGCConsoleManagerSubsystem::BenchmarkAttributeSetChurn(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	if (!InWorld || !InWorld->IsGameWorld())
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:BenchmarkAttributeSetChurn() Must be run in a game world"))
+		return;
+	}
+
+	IConsoleVariable* CacheCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("MGC.CacheAttributeDefaults"));
+	IConsoleVariable* RecycleCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("MGC.RecycleAttributeSetsOverride"));
+	if (!CacheCVar || !RecycleCVar)
+	{
+		MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:BenchmarkAttributeSetChurn() Cannot find MGC.CacheAttributeDefaults or MGC.RecycleAttributeSetsOverride console variables"))
+		return;
+	}
+
+	const int32 NumActors = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 200;
+	const int32 NumCycles = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10;
+
+	UClass* ActorClass = AModularCharacter::StaticClass();
+	if (Args.Num() > 2)
+	{
+		ActorClass = LoadClass<AActor>(nullptr, *Args[2]);
+		if (!ActorClass)
+		{
+			MGC_LOG(Error, TEXT("UMGCConsoleManagerSubsystem:BenchmarkAttributeSetChurn() Cannot load actor class %s"), *Args[2])
+			return;
+		}
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	struct FPassResult
+	{
+		double ChurnMs = 0.;
+		int32 GarbageObjects = 0;
+		double GCMs = 0.;
+		int32 RemainingObjects = 0;
+	};
+
+	// Indexed by [recycling][cached defaults]
+	FPassResult Results[2][2];
+
+	const bool bPreviousCacheValue = CacheCVar->GetBool();
+	const int32 PreviousRecycleValue = RecycleCVar->GetInt();
+	for (int32 Recycle = 0; Recycle < 2; ++Recycle)
+	{
+		// Recycling is forced on every Add Abilities action, whatever their Recycle Attribute Sets setting
+		RecycleCVar->Set(Recycle, ECVF_SetByConsole);
+
+		for (int32 Cache = 0; Cache < 2; ++Cache)
+		{
+			// Reads DataTable rows for every attribute set, then uses cached defaults
+			CacheCVar->Set(Cache == 1, ECVF_SetByConsole);
+
+			// Start every pass from a clean heap
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			const int32 StartObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+			TArray<AActor*> Actors;
+			Actors.Reserve(NumActors);
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+			{
+				for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+				{
+					if (AActor* Actor = InWorld->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParameters))
+					{
+						Actors.Add(Actor);
+					}
+				}
+
+				for (AActor* Actor : Actors)
+				{
+					Actor->Destroy();
+				}
+				Actors.Reset();
+			}
+
+			FPassResult& Result = Results[Recycle][Cache];
+			Result.ChurnMs = (FPlatformTime::Seconds() - StartTime) * 1000.;
+			Result.GarbageObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjects;
+
+			const double GCStartTime = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			Result.GCMs = (FPlatformTime::Seconds() - GCStartTime) * 1000.;
+			Result.RemainingObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjects;
+		}
+	}
+
+	CacheCVar->Set(bPreviousCacheValue, ECVF_SetByConsole);
+	RecycleCVar->Set(PreviousRecycleValue, ECVF_SetByConsole);
+
+	MGC_LOG(Display, TEXT("UMGCConsoleManagerSubsystem:BenchmarkAttributeSetChurn() %d cycles of %d %s, recycling off / on:"), NumCycles, NumActors, *ActorClass->GetName())
+	for (int32 Cache = 0; Cache < 2; ++Cache)
+	{
+		const FPassResult& Off = Results[0][Cache];
+		const FPassResult& On = Results[1][Cache];
+		MGC_LOG(
+			Display,
+			TEXT("\t%s - Spawn / Despawn: %.2f / %.2f ms, UObjects before GC: %+d / %+d, GC: %.2f / %.2f ms, UObjects after GC: %+d / %+d"),
+			Cache == 1 ? TEXT("Cached defaults") : TEXT("Uncached defaults"),
+			Off.ChurnMs,
+			On.ChurnMs,
+			Off.GarbageObjects,
+			On.GarbageObjects,
+			Off.GCMs,
+			On.GCMs,
+			Off.RemainingObjects,
+			On.RemainingObjects
+		)
+	}
+
+	MGC_LOG(Display, TEXT("UMGCConsoleManagerSubsystem:BenchmarkAttributeSetChurn() \"stat ModularGASCompanion\" shows created and reused attribute sets"))
+}
+
 void UMGCConsoleManagerSubsystem::ShowDebugAbilitySystem(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar, const int32 CategoryIndex)
 {
 	MGC_LOG(Log, TEXT("UMGCConsoleManagerSubsystem::ShowDebugAbilitySystem Category: %d"), CategoryIndex);
@@ -73,14 +73,39 @@ private:
 	UPROPERTY(transient)
 	TMap<UInputAction*, FMGCAbilityInputBinding> MappedAbilities;
 
+	/** Whether specs InputIDs may be out of sync with mapped abilities, and need to be updated before dispatching input */
+	bool bAbilitySystemBindingsDirty = true;
+
+	/**
+	 * Whether AbilityComponent notifies us when its specs change (MGCAbilitySystemComponent).
+	 *
+	 * If it doesn't, we can't know when InputIDs are lost and bindings are updated on every press / release.
+	 */
+	bool bListeningToAbilitySpecChanges = false;
+
+	/** Handle for the AbilityComponent OnAbilitySpecsChanged delegate */
+	FDelegateHandle AbilitySpecsChangedHandle;
+
 	void ResetBindings();
 	void RunAbilitySystemSetup();
 
+	/** Updates inputs ID for specs based on mapped abilities, and clears the dirty flag. */
+	void UpdateAbilitySystemBindings(UAbilitySystemComponent* AbilitySystemComponent);
+
 	/**
-	 * Runs on press / release, and updates inputs ID for specs based on mapped abilities.
+	 * Runs on press / release, and updates inputs ID for specs based on mapped abilities only if something changed since last update
+	 * (binding set or cleared, ability given or removed, specs replicated).
 	 *
-	 * Needs to run everytime to handle the issue with lost inputID when playing as client after first PIE session if BP containing ASC is compiled in Editor. */
-	void UpdateAbilitySystemBindings(UAbilitySystemComponent* AbilitySystemComponent);
+	 * Replication is what handles the issue with lost inputID when playing as client after first PIE session if BP containing ASC is compiled in Editor.
+	 */
+	void UpdateAbilitySystemBindingsIfDirty(UAbilitySystemComponent* AbilitySystemComponent);
+
+	/** Flags specs InputIDs as needing to be updated before next input dispatch */
+	void MarkAbilitySystemBindingsDirty();
+
+	/** Starts / stops listening to AbilityComponent spec changes */
+	void BindAbilitySpecsChangedDelegate();
+	void UnbindAbilitySpecsChangedDelegate();
 
 	void OnAbilityInputPressed(UInputAction* InputAction);
 	void OnAbilityInputReleased(UInputAction* InputAction);
@@ -0,0 +1,100 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpec.h"
+#include "GameplayTagContainer.h"
+
+/**
+ * Lookup index of the ability specs granted to an Ability System Component, keyed by ability class (including parent
+ * classes), ability tag (including parent tags) and InputID.
+ *
+ * Specs are referenced by handle since the ASC list of activatable abilities can be reallocated or reordered
+ * (RemoveAtSwap, fast array replication). Each handle also caches the position of its spec in that list, validated on
+ * every access and refreshed with a single pass over the list only when it became stale.
+ *
+ * Kept up to date incrementally by UMGCAbilitySystemComponent from OnGiveAbility / OnRemoveAbility and replication.
+ */
+struct MODULARGASCOMPANION_API FMGCAbilitySpecIndex
+{
+	typedef TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>> FHandleList;
+
+	/** Adds a newly granted spec to the index. Specs is the owning list, used to cache the spec position */
+	void AddSpec(const FGameplayAbilitySpec& Spec, const TArray<FGameplayAbilitySpec>& Specs);
+
+	/** Removes a spec that is about to be cleared from the index */
+	void RemoveSpec(const FGameplayAbilitySpec& Spec);
+
+	/** Re-indexes the spec under its current InputID, if it changed since it was last indexed */
+	void UpdateInputID(const FGameplayAbilitySpec& Spec);
+
+	/** Re-indexes InputIDs for every spec and refreshes cached positions (used after replication updates) */
+	void SyncWith(const TArray<FGameplayAbilitySpec>& Specs);
+
+	/** Clears and fully rebuilds the index from the given list */
+	void Rebuild(const TArray<FGameplayAbilitySpec>& Specs);
+
+	/** Empties the index */
+	void Reset();
+
+	/** Returns the spec matching the handle from the owning list, or nullptr if it is not indexed / not in the list */
+	FGameplayAbilitySpec* Resolve(TArray<FGameplayAbilitySpec>& Specs, FGameplayAbilitySpecHandle Handle);
+
+	/** Returns the handles of all specs whose ability is of the given class or a child of it */
+	const FHandleList* FindByClass(const UClass* AbilityClass) const { return ByClass.Find(AbilityClass); }
+
+	/** Returns the handles of all specs whose ability tags (or their parents) contain the given tag */
+	const FHandleList* FindByTag(const FGameplayTag& Tag) const { return ByTag.Find(Tag); }
+
+	/** Returns the handles of all specs bound to the given InputID */
+	const FHandleList* FindByInputID(const int32 InputID) const { return ByInputID.Find(InputID); }
+
+	/** Number of specs currently indexed */
+	int32 Num() const { return InputIDByHandle.Num(); }
+
+private:
+	TMap<const UClass*, FHandleList> ByClass;
+	TMap<FGameplayTag, FHandleList> ByTag;
+	TMap<int32, FHandleList> ByInputID;
+
+	/** InputID each spec was indexed with, used to detect InputID changes and to remove specs from ByInputID */
+	TMap<FGameplayAbilitySpecHandle, int32> InputIDByHandle;
+
+	/** Cached position of each spec in the owning list. Might be stale, always validated before use */
+	TMap<FGameplayAbilitySpecHandle, int32> PositionByHandle;
+
+	void RefreshPositions(const TArray<FGameplayAbilitySpec>& Specs);
+
+	template<typename KeyType>
+	static void AddHandle(TMap<KeyType, FHandleList>& Map, const KeyType& Key, FGameplayAbilitySpecHandle Handle)
+	{
+		Map.FindOrAdd(Key).AddUnique(Handle);
+	}
+
+	template<typename KeyType>
+	static void RemoveHandle(TMap<KeyType, FHandleList>& Map, const KeyType& Key, FGameplayAbilitySpecHandle Handle)
+	{
+		if (FHandleList* Handles = Map.Find(Key))
+		{
+			Handles->Remove(Handle);
+			if (Handles->Num() == 0)
+			{
+				Map.Remove(Key);
+			}
+		}
+	}
+
+	template<typename KeyType>
+	static void RemoveHandleFromAllKeys(TMap<KeyType, FHandleList>& Map, FGameplayAbilitySpecHandle Handle)
+	{
+		for (auto It = Map.CreateIterator(); It; ++It)
+		{
+			It.Value().Remove(Handle);
+			if (It.Value().Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
 #include "ModularGASCompanionTypes.h"
+#include "Abilities/MGCAbilitySpecIndex.h"
+#include "Core/Interfaces/GSCAbilitySpecIndexInterface.h"
 #include "MGCAbilitySystemComponent.generated.h"
 
 class UMGCAbilityInputBindingComponent;
@@ -78,6 +80,7 @@ struct FMGCMappedAbility
 };
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnGiveAbility, FGameplayAbilitySpec&);
+DECLARE_MULTICAST_DELEGATE(FOnAbilitySpecsChanged);
 
 /**
  * Revamped Ability System Component for 3.0.0
@@ -86,9 +89,12 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FOnGiveAbility, FGameplayAbilitySpec&);
  * although 4.27 still requires ASC and IAbilitySystemInterface to be implemented in cpp
  *
  * Does not have support for PlayerState for now.
+ *
+ * Maintains an index of granted ability specs (by class, ability tag and InputID), so that input dispatch and
+ * companion components lookups don't have to scan every activatable ability.
  */
 UCLASS(ClassGroup="ModularGASCompanion", meta=(BlueprintSpawnableComponent))
-class MODULARGASCOMPANION_API UMGCAbilitySystemComponent : public UAbilitySystemComponent
+class MODULARGASCOMPANION_API UMGCAbilitySystemComponent : public UAbilitySystemComponent, public IGSCAbilitySpecIndexInterface
 {
 	GENERATED_BODY()
 
@@ -108,6 +114,9 @@ public:
 	/** Delegate invoked OnGiveAbility (when an ability is granted and available) */
 	FOnGiveAbility OnGiveAbilityDelegate;
 
+	/** Delegate invoked whenever granted specs change: an ability is given or removed, or specs are updated from replication */
+	FOnAbilitySpecsChanged OnAbilitySpecsChangedDelegate;
+
 	//~ Begin UActorComponent interface
 	virtual void BeginPlay() override;
 	//~ End UActorComponent interface
@@ -126,6 +135,23 @@ public:
 	virtual void AbilityLocalInputPressed(int32 InputID) override;
 	//~ End UAbilitySystemComponent interface
 
+	//~ Begin IGSCAbilitySpecIndexInterface
+	virtual FGameplayAbilitySpec* FindIndexedAbilitySpecFromHandle(FGameplayAbilitySpecHandle Handle) override;
+	virtual FGameplayAbilitySpec* FindIndexedAbilitySpecFromClass(TSubclassOf<UGameplayAbility> AbilityClass) override;
+	virtual void ForEachIndexedAbilitySpecByClass(TSubclassOf<UGameplayAbility> AbilityClass, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) override;
+	virtual void ForEachIndexedAbilitySpecByTags(const FGameplayTagContainer& GameplayTagContainer, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) override;
+	virtual void ForEachIndexedAbilitySpecByInputID(int32 InputID, TFunctionRef<bool(FGameplayAbilitySpec&)> Visitor) override;
+	//~ End IGSCAbilitySpecIndexInterface
+
+	/** Indexed version of GetActivatableGameplayAbilitySpecsByAllMatchingTags, only visiting the specs granted with matching tags */
+	void GetIndexedAbilitySpecsByAllMatchingTags(const FGameplayTagContainer& GameplayTagContainer, TArray<FGameplayAbilitySpec*>& MatchingGameplayAbilities, bool bOnlyAbilitiesThatSatisfyTagRequirements = true);
+
+	/**
+	 * Must be called whenever the InputID of a granted spec is changed outside of replication, to keep the InputID
+	 * index up to date (MGCAbilityInputBindingComponent takes care of it for the bindings it manages)
+	 */
+	void NotifyAbilitySpecInputIDChanged(const FGameplayAbilitySpec& AbilitySpec);
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Modular GAS Companion|Abilities")
 	FGameplayAbilitySpecHandle GrantAbility(TSubclassOf<UGameplayAbility> Ability, bool bRemoveAfterActivation);
 
@@ -157,8 +183,13 @@ protected:
 	UPROPERTY()
 	UGSCComboManagerComponent* ComboComponent;
 
+	// Lookup index of granted specs, kept up to date on give / remove and replication
+	FMGCAbilitySpecIndex AbilitySpecIndex;
+
 	//~ Begin UAbilitySystemComponent interface
 	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
 	//~ End UAbilitySystemComponent interface
 
 	/** Called when Ability System Component is initialized */
@@ -0,0 +1,156 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "Abilities/GameplayAbility.h"
+#include "Commandlets/Commandlet.h"
+#include "MGCStressTestCommandlet.generated.h"
+
+class AModularCharacter;
+class AGSCProjectileBase;
+class UAttributeSet;
+class UGSCGameplayAbility;
+
+/** Cooldown effect of UMGCStressTestCooldownAbility, its duration and cooldown tag are set on the spec for each ability level */
+UCLASS(NotBlueprintable)
+class UMGCStressTestCooldownEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UMGCStressTestCooldownEffect();
+};
+
+/**
+ * Ability of the stress test Cooldown scenario, granted once per rotation slot with the slot as ability level (1 to NumSlots).
+ *
+ * Goes through the regular CanActivateAbility / CommitAbility cooldown path, with a cooldown effect of Level seconds
+ * granting the cooldown tag of its slot.
+ */
+UCLASS(NotBlueprintable)
+class UMGCStressTestCooldownAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumSlots = 3;
+
+	UMGCStressTestCooldownAbility();
+
+	/** Returns the cooldown tag of the given ability level, only registered when running the stress test commandlet */
+	static FGameplayTag GetCooldownTag(int32 Level);
+
+	//~ Begin UGameplayAbility interface
+	virtual bool CheckCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void ApplyCooldown(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const override;
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	//~ End UGameplayAbility interface
+};
+
+/**
+ * Headless GAS stress test, meant to be run in CI to catch regressions in ability activation, effect application and
+ * attribute replication under load:
+ *
+ *   UE4Editor-Cmd <Project> -run=MGCStressTest -nullrhi -unattended [options]
+ *
+ * Spawns N modular characters in an empty game world with the given ability and attribute set loadouts, then runs each
+ * scripted combat scenario for a fixed number of ticks, at a fixed tick rate:
+ *
+ * - Melee: three hit combos against the next agent, driven through each agent combo manager component (combo input,
+ *   combo window and trigger combo notifies are scripted, as montages would)
+ * - Projectile: volleys of projectiles (through the projectile pool for pooled classes), hitting the next agent on release
+ * - DoT: periodic damage effects kept active on the next agent
+ * - Cooldown: rotations of three abilities cast as soon as CanActivateAbility passes, each committing a cooldown effect
+ *   granting its cooldown tag
+ *
+ * Per system frame times (average, p50, p90, p99, max), used physical memory and live UObject count deltas over the
+ * scenario and estimated replicated bytes are written as CSV, one row per scenario and system. Memory and UObject deltas
+ * are net growth, not allocation counts: memory freed or objects destroyed during the scenario don't show up in them.
+ *
+ * Options:
+ *   -Agents=64                  Number of agents
+ *   -Ticks=600                  Number of ticks per scenario
+ *   -TickRate=30                Fixed tick rate, in Hz
+ *   -Scenarios=Melee+Projectile+DoT+Cooldown   Scenarios to run
+ *   -Character=<class path>     Agent class, must be an AModularCharacter (default AModularCharacter)
+ *   -Abilities=<path>+<path>    Ability classes granted to every agent
+ *   -ComboAbility=<class path>  Melee combo ability for the Melee scenario (default UGSCGameplayAbility_MeleeBase)
+ *   -AttributeSets=<path>+...   Attribute set classes granted to every agent (default UGSCAttributeSet)
+ *   -Projectile=<class path>    Projectile class for the Projectile scenario (default AGSCProjectileBase)
+ *   -Csv=<file>                 Output file (default <Project>/Saved/Profiling/MGCStressTest.csv)
+ *   -MaxP99Ms=<ms>              If set, returns a non zero exit code when a scenario frame p99 goes above it
+ */
+UCLASS()
+class MODULARGASCOMPANION_API UMGCStressTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMGCStressTestCommandlet();
+
+	//~ Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet interface
+
+	/** Systems timed separately on every tick */
+	enum class ESystem : uint8
+	{
+		Abilities,
+		Effects,
+		Projectiles,
+		World,
+		Replication,
+		Frame,
+		MAX
+	};
+
+	/** Scripted combat scenarios */
+	enum class EScenario : uint8
+	{
+		Melee,
+		Projectile,
+		DoT,
+		Cooldown,
+		MAX
+	};
+
+private:
+	/** Frame time samples of a scenario, per system, in milliseconds */
+	struct FScenarioResult
+	{
+		TArray<double> SamplesMs[(int32)ESystem::MAX];
+		/** Attribute and combo state bytes a replication of every change would send, not measured from a net driver */
+		int64 ReplicatedBytesEstimate = 0;
+		/** Process used physical memory growth over the scenario */
+		double UsedPhysicalDeltaMB = 0.;
+		/** Live UObject count growth over the scenario */
+		int32 UObjectCountDelta = 0;
+	};
+
+	int32 NumAgents = 64;
+	int32 NumTicks = 600;
+	float TickRate = 30.f;
+
+	TSubclassOf<AModularCharacter> CharacterClass;
+	TSubclassOf<AGSCProjectileBase> ProjectileClass;
+	TArray<TSubclassOf<UGameplayAbility>> AbilityClasses;
+	TSubclassOf<UGSCGameplayAbility> ComboAbilityClass;
+	TArray<TSubclassOf<UAttributeSet>> AttributeSetClasses;
+
+	/** Parses command line options, returns false if one of the classes could not be loaded */
+	bool ParseOptions(const FString& Params, TArray<EScenario>& OutScenarios, FString& OutCsvFile, float& OutMaxP99Ms);
+
+	/** Spawns agents, runs a scenario in a new world and tears it down */
+	FScenarioResult RunScenario(EScenario Scenario);
+
+	/** Writes results as CSV, one row per scenario and system */
+	static bool WriteCsv(const FString& CsvFile, const TArray<TPair<EScenario, FScenarioResult>>& Results, int32 InNumAgents, int32 InNumTicks);
+
+	/** Returns the given percentile (0-1) of already sorted samples */
+	static double GetPercentile(const TArray<double>& SortedSamples, float Percentile);
+
+	static const TCHAR* GetScenarioName(EScenario Scenario);
+	static const TCHAR* GetSystemName(ESystem System);
+};
@@ -6,10 +6,13 @@
 #include "GameFeatureAction.h"
 #include "ModularGASCompanionTypes.h"
 #include "Abilities/GameplayAbility.h"
+#include "UObject/ObjectKey.h"
 #include "MGCGameFeatureAction_AddAbilities.generated.h"
 
 struct FMGCComponentRequestHandle;
+struct FStreamableHandle;
 class UMGCAbilityInputBindingComponent;
+class UMGCAbilitySystemComponent;
 struct FComponentRequestHandle;
 class UInputAction;
 class UDataTable;
@@ -90,6 +93,22 @@ public:
 	UPROPERTY(EditAnywhere, Category="Abilities", meta=(TitleProperty="ActorClass", ShowOnlyInnerProperties))
 	TArray<FMGCGameFeatureAbilitiesEntry> AbilitiesList;
 
+	/**
+	 * If true, attribute sets removed from actors are kept and reused for the next actors granted the same attribute set,
+	 * instead of being left to garbage collection. Useful for wave based spawning.
+	 *
+	 * Sets are only recycled for actors that are not replicated (or in standalone), since a recycled set would otherwise keep
+	 * the network identity of its previous owner.
+	 *
+	 * Can be overridden for every Add Abilities action with MGC.RecycleAttributeSetsOverride.
+	 */
+	UPROPERTY(EditAnywhere, Category="Attributes")
+	bool bRecycleAttributeSets = false;
+
+	/** Maximum number of removed attribute sets kept for reuse */
+	UPROPERTY(EditAnywhere, Category="Attributes", meta=(EditCondition="bRecycleAttributeSets", ClampMin=0))
+	int32 MaxRecycledAttributeSets = 64;
+
 	void Reset();
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex);
 	void AddActorAbilities(AActor* Actor, const FMGCGameFeatureAbilitiesEntry& AbilitiesEntry);
@@ -107,6 +126,20 @@ private:
 		TArray<FGameplayAbilitySpecHandle> Abilities;
 		TArray<UAttributeSet*> Attributes;
 		TArray<FDelegateHandle> InputBindingDelegateHandles;
+
+		/** Components found (or added) when granting, so that removal doesn't have to look them up again */
+		TWeakObjectPtr<UMGCAbilitySystemComponent> AbilitySystemComponent;
+		TWeakObjectPtr<UMGCAbilityInputBindingComponent> InputComponent;
+	};
+
+	/** Default attribute values read from an initialization DataTable, for an attribute set class */
+	struct FAttributeSetDefaults
+	{
+		/** Numeric properties (float, int) and their default value */
+		TArray<TPair<FNumericProperty*, float>> NumericValues;
+
+		/** FGameplayAttributeData properties and their default base value */
+		TArray<TPair<FStructProperty*, float>> AttributeDataValues;
 	};
 
 	FDelegateHandle GameInstanceStartHandle;
@@ -117,12 +150,87 @@ private:
 	TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
 	TArray<TSharedPtr<FMGCComponentRequestHandle>> ExtensionsRequests;
 
+	/** Extension handlers added to the UE5 component manager, kept apart from component requests to be released first on deactivation */
+	TArray<TSharedPtr<FComponentRequestHandle>> ExtensionHandlerRequests;
+
+	/** Batched async load of every soft reference in AbilitiesList, requested on activation */
+	TSharedPtr<FStreamableHandle> AssetsLoadHandle;
+
+	/** Whether assets of AbilitiesList are available, abilities are granted right away when true */
+	bool bAssetsLoaded = false;
+
+	/** Actors (with their AbilitiesList entry index) that received the extension while assets were still loading */
+	TArray<TPair<TWeakObjectPtr<AActor>, int32>> PendingActors;
+
+	/** Extensions of actors still to be removed after deactivation, a few per frame (see MGC.AbilitiesRemovalBudgetMs) */
+	TArray<TPair<TWeakObjectPtr<AActor>, FActorExtensions>> PendingRemovals;
+
+	/** Completes the paused deactivation, once every pending removal is done and everything else released */
+	FSimpleDelegate DeactivationCompleteDelegate;
+
+	FDelegateHandle PendingRemovalsTickerHandle;
+
+	/** Deactivation cost, logged once every pending removal is done */
+	double PendingRemovalsTotalMs = 0.;
+	double PendingRemovalsMaxFrameMs = 0.;
+	int32 PendingRemovalsNumActors = 0;
+	int32 PendingRemovalsNumFrames = 0;
+
+	/** Removes pending extensions until the per frame budget is spent, completes deactivation when there are none left */
+	bool TickPendingRemovals(float DeltaTime);
+
+	/** Removes every pending extension that was left (on Reset) */
+	void FlushPendingRemovals();
+
+	/** Releases extension handlers, actors are no longer granted anything */
+	void ReleaseExtensionHandlers();
+
+	/** Completes deactivation if it was paused, once everything was released */
+	void CompleteDeactivation();
+
+	/** Removes pending extensions, stopping once TimeLimit (in seconds, 0 for no limit) is reached. Returns elapsed time in ms */
+	double RemovePendingExtensions(double TimeLimit);
+
+	/** Removes abilities, attribute sets and input bindings granted to the actor */
+	void RemoveActorExtensions(const AActor* Actor, FActorExtensions& ActorExtensions);
+
+	/** Default attribute values per attribute set class and initialization DataTable, so that DataTable rows are read once */
+	TMap<TPair<TObjectKey<UClass>, TObjectKey<UDataTable>>, FAttributeSetDefaults> AttributeDefaultsCache;
+
+	/** Attribute sets removed from actors, kept for reuse when bRecycleAttributeSets is true */
+	UPROPERTY(Transient)
+	TArray<UAttributeSet*> RecycledAttributeSets;
+
 	virtual void AddToWorld(const FWorldContext& WorldContext);
 	void HandleGameInstanceStart(UGameInstance* GameInstance);
 
+	/** Grants abilities for the entry right away if assets are loaded, or queues the actor until they are */
+	void AddOrQueueActorAbilities(AActor* Actor, int32 EntryIndex);
+
+	/** Called once the batched load of AbilitiesList assets completes, grants abilities to queued actors */
+	void HandleAssetsLoaded();
+
+	/** Soft references of AbilitiesList (abilities, input actions, attribute sets and init data tables) */
+	void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const;
+
 	/** Handler for AbilitySystem OnGiveAbility delegate. Sets up input binding for clients (not authority) when GameFeatures are activated during Play. */
 	void HandleOnGiveAbility(FGameplayAbilitySpec& AbilitySpec, UMGCAbilityInputBindingComponent* InputComponent, UInputAction* InputAction, EMGCAbilityTriggerEvent TriggerEvent, FGameplayAbilitySpec NewAbilitySpec);
 
+	/** Creates (or reuses a recycled) attribute set for the actor and initializes it from InitData, if any */
+	UAttributeSet* CreateAttributeSet(AActor* Actor, TSubclassOf<UAttributeSet> AttributeSetType, const UDataTable* InitData);
+
+	/** Same as UAttributeSet::InitFromMetaDataTable, with values read from the DataTable once per attribute set class */
+	void InitAttributeSet(UAttributeSet* AttributeSet, const UDataTable* InitData);
+
+	/** Returns default values for the attribute set class in InitData, reading and caching them on first use */
+	const FAttributeSetDefaults& GetAttributeSetDefaults(UClass* AttributeSetClass, const UDataTable* InitData);
+
+	/** Keeps a removed attribute set for reuse, if recycling is enabled and there is room left */
+	void RecycleAttributeSet(const AActor* Actor, UAttributeSet* AttributeSet);
+
+	/** Returns bRecycleAttributeSets, unless overridden with MGC.RecycleAttributeSetsOverride */
+	bool ShouldRecycleAttributeSets() const;
+
 	/** Does the passed in ability system component have this attribute set? */
 	static bool HasAttributeSet(UAbilitySystemComponent* AbilitySystemComponent, const TSubclassOf<UAttributeSet> Set);
 };
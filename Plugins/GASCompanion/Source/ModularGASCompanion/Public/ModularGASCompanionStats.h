@@ -0,0 +1,9 @@
+// Copyright 2021 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Stats for Modular GAS Companion runtime, use "stat ModularGASCompanion" to display them
+DECLARE_STATS_GROUP(TEXT("ModularGASCompanion"), STATGROUP_ModularGASCompanion, STATCAT_Advanced);
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "MGCGameFrameworkExtensionManager.generated.h"
 
 /**
@@ -111,6 +112,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Modular GAS Companion|Gameplay", meta = (DefaultToSelf = "Receiver", AdvancedDisplay = 1))
 	MODULARGASCOMPANION_API void SendExtensionEvent(AActor* Receiver, FName EventName, bool bOnlyInGameWorlds = true);
 
+	/**
+	 * Checks the receivers registry against actors currently in the world, for the receiver classes it knows about: logs and
+	 * returns the number of registered receivers no longer in the world, and initialized actors in the world that are not registered.
+	 */
+	MODULARGASCOMPANION_API int32 ValidateReceivers() const;
+
 private:
 
 	/** A list of FNames to represent an object path. Used for fast hashing and comparison of paths */
@@ -176,6 +183,30 @@ private:
 	/** A map of actor classes to delegate handlers that should be executed for actors of that class. */
 	TMap<FMGCComponentRequestReceiverClassPath, FExtensionHandlerEvent> ReceiverClassToEventMap;
 
+	/** Handlers to execute for actors of a concrete class: the ones registered for the class and each of its parents, most derived first */
+	using FResolvedExtensionHandlers = TArray<FExtensionHandlerDelegate>;
+
+	/**
+	 * Resolved handlers per concrete receiver class, so that sending an event for an already seen class is a single lookup.
+	 *
+	 * Emptied whenever an extension handler is added or removed. Lists are shared so that a handler adding or removing
+	 * handlers while an event is being sent doesn't free the list being iterated.
+	 */
+	TMap<TObjectKey<UClass>, TSharedRef<const FResolvedExtensionHandlers, ESPMode::Fast>> ResolvedHandlersCache;
+
+	/** Returns the handlers to execute for actors of the given class, resolving and caching them on first use */
+	TSharedRef<const FResolvedExtensionHandlers, ESPMode::Fast> GetResolvedHandlers(UClass* ReceiverClass);
+
+	/**
+	 * Actors that called AddReceiver and didn't call RemoveReceiver yet, per concrete class.
+	 *
+	 * Used when adding or removing extension handlers to only go through matching receivers, instead of every actor in the world.
+	 */
+	TMap<TObjectKey<UClass>, TSet<TWeakObjectPtr<AActor>>> ReceiversByClass;
+
+	/** Returns initialized receivers that are of the given class or one of its children */
+	TArray<AActor*> GetReceiversOfClass(UClass* ReceiverClass);
+
 	/** Called by FMGCComponentRequestHandle's destructor to remove a handler from the system. */
 	void RemoveExtensionHandler(const TSoftClassPtr<AActor>& ReceiverClass, FDelegateHandle DelegateHandle);
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "MGCConsoleManagerSubsystem.generated.h"
 
@@ -25,6 +26,29 @@ private:
 	void ToggleComboWidget(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
 	void ToggleAbilityQueueWidget(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
 	void ShowDebugAbilitySystem(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar, int32 CategoryIndex);
+	void MeasureFeatureActivation(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
+	void BenchmarkExtensionEvents(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
+	void TestExtensionReceivers(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
+	void BenchmarkAttributeSetChurn(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar);
+
+	/** State of a running GASCompanion.Debug.MeasureFeatureActivation */
+	struct FFeatureActivationMeasure
+	{
+		FString PluginName;
+		double StartTime = 0.;
+		double LastFrameTime = 0.;
+		double MaxStallMs = 0.;
+		double ActivationMs = 0.;
+		int32 NumFrames = 0;
+		int32 SettleFramesLeft = 0;
+		bool bActivated = false;
+	};
+
+	TOptional<FFeatureActivationMeasure> FeatureActivationMeasure;
+	FDelegateHandle FeatureActivationTickerHandle;
+
+	/** Records the duration of every frame until the feature is active and its actions had a few frames to settle */
+	bool TickFeatureActivationMeasure(float DeltaTime);
 
 	// Called by gameplay debugger
 	static void OnShowDebugInfo(AHUD* HUD, UCanvas* Canvas, const FDebugDisplayInfo& DisplayInfo, float& YL, float& YPos);